@@ -34,6 +34,7 @@
 #include "nm-client-utils.h"
 
 #include "utils.h"
+#include "settings.h"
 
 /*****************************************************************************/
 
@@ -1380,3 +1381,677 @@ nmc_error_get_simple_message (GError *error)
 	else
 		return error->message;
 }
+
+/*****************************************************************************/
+
+/* Streaming of property changes for the monitor commands in --ndjson mode.
+ *
+ * Every watched object keeps the JSON encoded values of its properties as
+ * they were last printed. A notification only marks a property dirty when
+ * it differs from that value, and the dirty properties are printed in
+ * batches. Thus, a property that changes several times within one flush
+ * interval is printed once, and one that changes back to its previous
+ * value is not printed at all. */
+
+typedef struct {
+	char *path;
+	GObject *object;
+	guint watch_count;
+	GHashTable *values;     /* property name -> last printed JSON value */
+	GHashTable *dirty;      /* property name -> current JSON value */
+	GHashTable *children;   /* property name -> watched child object */
+	bool queued:1;
+	bool added:1;
+	bool removed:1;
+} MonitorObject;
+
+static struct {
+	NmCli *nmc;
+	GHashTable *objects;    /* object path -> MonitorObject */
+	GPtrArray *queue;       /* MonitorObjects with pending output */
+	guint flush_interval;
+	guint flush_id;
+} _monitor;
+
+static const char *
+_monitor_object_get_path (GObject *object)
+{
+	if (NM_IS_CLIENT (object))
+		return NM_DBUS_PATH;
+	if (NM_IS_OBJECT (object))
+		return nm_object_get_path (NM_OBJECT (object));
+	return NULL;
+}
+
+static void
+_monitor_object_free (MonitorObject *mobj)
+{
+	g_hash_table_unref (mobj->values);
+	g_hash_table_unref (mobj->dirty);
+	g_hash_table_unref (mobj->children);
+	g_object_unref (mobj->object);
+	g_free (mobj->path);
+	g_slice_free (MonitorObject, mobj);
+}
+
+static gboolean
+_monitor_flush_cb (gpointer user_data)
+{
+	_monitor.flush_id = 0;
+	nmc_monitor_diff_flush ();
+	return G_SOURCE_REMOVE;
+}
+
+static void
+_monitor_schedule (MonitorObject *mobj)
+{
+	if (!mobj->queued) {
+		mobj->queued = TRUE;
+		g_ptr_array_add (_monitor.queue, mobj);
+	}
+
+	if (!_monitor.flush_id) {
+		if (_monitor.flush_interval)
+			_monitor.flush_id = g_timeout_add (_monitor.flush_interval, _monitor_flush_cb, NULL);
+		else
+			_monitor.flush_id = g_idle_add (_monitor_flush_cb, NULL);
+	}
+}
+
+static void
+_monitor_append_strv (GString *str, const char *const*strv)
+{
+	gsize i;
+
+	g_string_append_c (str, '[');
+	for (i = 0; strv && strv[i]; i++) {
+		if (i > 0)
+			g_string_append_c (str, ',');
+		nmc_json_append_string (str, strv[i]);
+	}
+	g_string_append_c (str, ']');
+}
+
+static void
+_monitor_append_ptr_array (GString *str, GParamSpec *pspec, GPtrArray *arr)
+{
+	guint i;
+
+	g_string_append_c (str, '[');
+	for (i = 0; arr && i < arr->len; i++) {
+		gpointer item = arr->pdata[i];
+
+		if (i > 0)
+			g_string_append_c (str, ',');
+
+		if (   g_type_is_a (pspec->owner_type, NM_TYPE_IP_CONFIG)
+		    && nm_streq (pspec->name, NM_IP_CONFIG_ADDRESSES)) {
+			NMIPAddress *addr = item;
+			char buf[100];
+
+			nm_sprintf_buf (buf, "%s/%u",
+			                nm_ip_address_get_address (addr),
+			                nm_ip_address_get_prefix (addr));
+			nmc_json_append_string (str, buf);
+		} else if (   g_type_is_a (pspec->owner_type, NM_TYPE_IP_CONFIG)
+		           && nm_streq (pspec->name, NM_IP_CONFIG_ROUTES)) {
+			NMIPRoute *route = item;
+
+			g_string_append (str, "{\"dest\":");
+			nmc_json_append_string (str, nm_ip_route_get_dest (route));
+			g_string_append_printf (str, ",\"prefix\":%u,\"next-hop\":",
+			                        nm_ip_route_get_prefix (route));
+			if (nm_ip_route_get_next_hop (route))
+				nmc_json_append_string (str, nm_ip_route_get_next_hop (route));
+			else
+				g_string_append (str, "null");
+			g_string_append_printf (str, ",\"metric\":%lld}",
+			                        (long long) nm_ip_route_get_metric (route));
+		} else if (   g_type_is_a (pspec->owner_type, NM_TYPE_DEVICE)
+		           && nm_streq (pspec->name, NM_DEVICE_LLDP_NEIGHBORS)) {
+			NMLldpNeighbor *neighbor = item;
+			gs_strfreev char **names = NULL;
+			gsize j;
+
+			names = nm_lldp_neighbor_get_attr_names (neighbor);
+			g_string_append_c (str, '{');
+			for (j = 0; names && names[j]; j++) {
+				GVariant *variant;
+
+				variant = nm_lldp_neighbor_get_attr_value (neighbor, names[j]);
+				if (j > 0)
+					g_string_append_c (str, ',');
+				nmc_json_append_string (str, names[j]);
+				g_string_append_c (str, ':');
+				if (g_variant_is_of_type (variant, G_VARIANT_TYPE_STRING))
+					nmc_json_append_string (str, g_variant_get_string (variant, NULL));
+				else {
+					gs_free char *s = g_variant_print (variant, FALSE);
+
+					nmc_json_append_string (str, s);
+				}
+			}
+			g_string_append_c (str, '}');
+		} else if (   g_type_is_a (pspec->owner_type, NM_TYPE_CLIENT)
+		           && nm_streq (pspec->name, NM_CLIENT_DNS_CONFIGURATION)) {
+			NMDnsEntry *entry = item;
+
+			g_string_append (str, "{\"interface\":");
+			if (nm_dns_entry_get_interface (entry))
+				nmc_json_append_string (str, nm_dns_entry_get_interface (entry));
+			else
+				g_string_append (str, "null");
+			g_string_append (str, ",\"nameservers\":");
+			_monitor_append_strv (str, nm_dns_entry_get_nameservers (entry));
+			g_string_append (str, ",\"domains\":");
+			_monitor_append_strv (str, nm_dns_entry_get_domains (entry));
+			g_string_append_printf (str, ",\"priority\":%d,\"vpn\":%s}",
+			                        nm_dns_entry_get_priority (entry),
+			                        nm_dns_entry_get_vpn (entry) ? "true" : "false");
+		} else if (NM_IS_OBJECT (item))
+			nmc_json_append_string (str, nm_object_get_path (item));
+		else
+			g_string_append (str, "null");
+	}
+	g_string_append_c (str, ']');
+}
+
+static char *
+_monitor_get_value (GObject *object, GParamSpec *pspec, GObject **out_child)
+{
+	nm_auto_unset_gvalue GValue value = G_VALUE_INIT;
+	GString *str;
+
+	NM_SET_OUT (out_child, NULL);
+
+	g_value_init (&value, pspec->value_type);
+	g_object_get_property (object, pspec->name, &value);
+
+	str = g_string_sized_new (32);
+
+	switch (G_TYPE_FUNDAMENTAL (pspec->value_type)) {
+	case G_TYPE_STRING:
+		if (g_value_get_string (&value))
+			nmc_json_append_string (str, g_value_get_string (&value));
+		else
+			g_string_append (str, "null");
+		break;
+	case G_TYPE_BOOLEAN:
+		g_string_append (str, g_value_get_boolean (&value) ? "true" : "false");
+		break;
+	case G_TYPE_INT:
+		g_string_append_printf (str, "%d", g_value_get_int (&value));
+		break;
+	case G_TYPE_UINT:
+		g_string_append_printf (str, "%u", g_value_get_uint (&value));
+		break;
+	case G_TYPE_INT64:
+		g_string_append_printf (str, "%" G_GINT64_FORMAT, g_value_get_int64 (&value));
+		break;
+	case G_TYPE_UINT64:
+		g_string_append_printf (str, "%" G_GUINT64_FORMAT, g_value_get_uint64 (&value));
+		break;
+	case G_TYPE_ENUM:
+		g_string_append_printf (str, "%d", g_value_get_enum (&value));
+		break;
+	case G_TYPE_FLAGS:
+		g_string_append_printf (str, "%u", g_value_get_flags (&value));
+		break;
+	case G_TYPE_OBJECT: {
+		GObject *child = g_value_get_object (&value);
+
+		if (NM_IS_OBJECT (child)) {
+			nmc_json_append_string (str, nm_object_get_path (NM_OBJECT (child)));
+			if (NM_IS_IP_CONFIG (child) || NM_IS_DHCP_CONFIG (child))
+				NM_SET_OUT (out_child, child);
+		} else
+			g_string_append (str, "null");
+		break;
+	}
+	case G_TYPE_BOXED:
+		if (pspec->value_type == G_TYPE_STRV)
+			_monitor_append_strv (str, g_value_get_boxed (&value));
+		else if (pspec->value_type == G_TYPE_PTR_ARRAY)
+			_monitor_append_ptr_array (str, pspec, g_value_get_boxed (&value));
+		else if (pspec->value_type == G_TYPE_BYTES) {
+			GBytes *bytes = g_value_get_boxed (&value);
+
+			if (bytes) {
+				gs_free char *s = NULL;
+
+				s = nm_utils_bin2hexstr (g_bytes_get_data (bytes, NULL),
+				                         g_bytes_get_size (bytes), -1);
+				nmc_json_append_string (str, s);
+			} else
+				g_string_append (str, "null");
+		} else if (pspec->value_type == G_TYPE_HASH_TABLE) {
+			/* the only hash tables are the string dictionaries of
+			 * NMDhcpConfig:options. */
+			GHashTable *hash = g_value_get_boxed (&value);
+			gs_free const char **keys = NULL;
+			guint i, len = 0;
+
+			if (hash)
+				keys = (const char **) g_hash_table_get_keys_as_array (hash, &len);
+			if (len > 1)
+				g_qsort_with_data (keys, len, sizeof (const char *), nm_strcmp_p_with_data, NULL);
+			g_string_append_c (str, '{');
+			for (i = 0; i < len; i++) {
+				if (i > 0)
+					g_string_append_c (str, ',');
+				nmc_json_append_string (str, keys[i]);
+				g_string_append_c (str, ':');
+				nmc_json_append_string (str, g_hash_table_lookup (hash, keys[i]));
+			}
+			g_string_append_c (str, '}');
+		} else
+			g_string_append (str, "null");
+		break;
+	default: {
+		gs_free char *s = g_strdup_value_contents (&value);
+
+		nmc_json_append_string (str, s);
+		break;
+	}
+	}
+
+	return g_string_free (str, FALSE);
+}
+
+static void
+_monitor_set_dirty (MonitorObject *mobj, const char *name, char *value_take)
+{
+	const char *old;
+
+	old = g_hash_table_lookup (mobj->values, name);
+	if (nm_streq0 (old, value_take)) {
+		/* back to the value we printed last. */
+		g_hash_table_remove (mobj->dirty, name);
+		g_free (value_take);
+		return;
+	}
+
+	g_hash_table_insert (mobj->dirty, g_strdup (name), value_take);
+	_monitor_schedule (mobj);
+}
+
+static void
+_monitor_update_property (MonitorObject *mobj, GParamSpec *pspec)
+{
+	GObject *child;
+	GObject *old_child;
+	char *value;
+
+	value = _monitor_get_value (mobj->object, pspec, &child);
+
+	old_child = g_hash_table_lookup (mobj->children, pspec->name);
+	if (child != old_child) {
+		/* IP and DHCP configurations are exposed as separate objects.
+		 * Follow them, so that their changes are visible too. Note that
+		 * a device and its active connection share the same config. */
+		if (child) {
+			nmc_monitor_diff_watch (child);
+			g_hash_table_insert (mobj->children, g_strdup (pspec->name), g_object_ref (child));
+		} else
+			g_hash_table_remove (mobj->children, pspec->name);
+		if (old_child)
+			nmc_monitor_diff_unwatch (old_child);
+	}
+
+	_monitor_set_dirty (mobj, pspec->name, value);
+}
+
+static void
+_monitor_update_settings (MonitorObject *mobj)
+{
+	NMConnection *connection = NM_CONNECTION (mobj->object);
+	gs_unref_hashtable GHashTable *seen = NULL;
+	gs_free NMSetting **settings = NULL;
+	GHashTableIter iter;
+	const char *name;
+	guint i, j, n_settings;
+
+	/* the settings of a profile are not exposed as GObject properties.
+	 * Flatten them as "setting.property" in the parsable format of
+	 * "nmcli connection show". */
+	seen = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+	settings = nm_connection_get_settings (connection, &n_settings);
+	for (i = 0; i < n_settings; i++) {
+		NMSetting *setting = settings[i];
+		gs_free GParamSpec **pspecs = NULL;
+		guint n_pspecs;
+
+		pspecs = g_object_class_list_properties (G_OBJECT_GET_CLASS (setting), &n_pspecs);
+		for (j = 0; j < n_pspecs; j++) {
+			gs_free char *value = NULL;
+			GString *str;
+			char *key;
+
+			if (nm_streq (pspecs[j]->name, NM_SETTING_NAME))
+				continue;
+			/* don't use nm_setting_get_secret_flags(), NMSettingVpn
+			 * claims to have flags for any name. */
+			if (   !_monitor.nmc->nmc_config.show_secrets
+			    && NM_FLAGS_HAS (pspecs[j]->flags, NM_SETTING_PARAM_SECRET))
+				continue;
+
+			value = nmc_setting_get_property_parsable (setting, pspecs[j]->name, NULL);
+			if (!value)
+				continue;
+
+			key = g_strdup_printf ("%s.%s", nm_setting_get_name (setting), pspecs[j]->name);
+			g_hash_table_add (seen, key);
+
+			str = g_string_sized_new (strlen (value) + 2);
+			nmc_json_append_string (str, value);
+			_monitor_set_dirty (mobj, key, g_string_free (str, FALSE));
+		}
+	}
+
+	/* properties of removed settings become null. Drop them entirely if
+	 * they were never printed. */
+	g_hash_table_iter_init (&iter, mobj->dirty);
+	while (g_hash_table_iter_next (&iter, (gpointer *) &name, NULL)) {
+		if (   strchr (name, '.')
+		    && !g_hash_table_contains (seen, name)
+		    && !g_hash_table_contains (mobj->values, name))
+			g_hash_table_iter_remove (&iter);
+	}
+	g_hash_table_iter_init (&iter, mobj->values);
+	while (g_hash_table_iter_next (&iter, (gpointer *) &name, NULL)) {
+		if (   strchr (name, '.')
+		    && !g_hash_table_contains (seen, name))
+			_monitor_set_dirty (mobj, name, g_strdup ("null"));
+	}
+}
+
+static void
+_monitor_notify_cb (GObject *object, GParamSpec *pspec, MonitorObject *mobj)
+{
+	if (!(pspec->flags & G_PARAM_READABLE))
+		return;
+	_monitor_update_property (mobj, pspec);
+}
+
+static void
+_monitor_connection_changed_cb (NMConnection *connection, MonitorObject *mobj)
+{
+	_monitor_update_settings (mobj);
+}
+
+/**
+ * nmc_monitor_diff_watch:
+ * @object: a #NMClient or a #NMObject
+ *
+ * Starts following the property changes of @object. All the current
+ * values are printed with the next flush. Watching an object multiple
+ * times only takes a reference on the existing watch.
+ */
+void
+nmc_monitor_diff_watch (gpointer object)
+{
+	MonitorObject *mobj;
+	gs_free GParamSpec **pspecs = NULL;
+	const char *path;
+	guint i, n_pspecs;
+
+	g_return_if_fail (_monitor.objects);
+
+	path = _monitor_object_get_path (object);
+	if (!path)
+		return;
+
+	mobj = g_hash_table_lookup (_monitor.objects, path);
+	if (mobj) {
+		mobj->watch_count++;
+		return;
+	}
+
+	mobj = g_slice_new0 (MonitorObject);
+	mobj->path = g_strdup (path);
+	mobj->object = g_object_ref (object);
+	mobj->watch_count = 1;
+	mobj->values = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+	mobj->dirty = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+	mobj->children = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_object_unref);
+	mobj->added = TRUE;
+	g_hash_table_insert (_monitor.objects, mobj->path, mobj);
+	_monitor_schedule (mobj);
+
+	g_signal_connect (object, "notify", G_CALLBACK (_monitor_notify_cb), mobj);
+	pspecs = g_object_class_list_properties (G_OBJECT_GET_CLASS (object), &n_pspecs);
+	for (i = 0; i < n_pspecs; i++) {
+		if (pspecs[i]->flags & G_PARAM_READABLE)
+			_monitor_update_property (mobj, pspecs[i]);
+	}
+
+	if (NM_IS_REMOTE_CONNECTION (object)) {
+		g_signal_connect (object, NM_CONNECTION_CHANGED,
+		                  G_CALLBACK (_monitor_connection_changed_cb), mobj);
+		_monitor_update_settings (mobj);
+	}
+}
+
+/**
+ * nmc_monitor_diff_unwatch:
+ * @object: a #NMClient or a #NMObject
+ *
+ * Drops a watch taken with nmc_monitor_diff_watch(). When the last one
+ * is gone, the removal of the object is printed with the next flush.
+ *
+ * Returns: %TRUE if @object was watched.
+ */
+gboolean
+nmc_monitor_diff_unwatch (gpointer object)
+{
+	MonitorObject *mobj;
+	GHashTableIter iter;
+	GObject *child;
+	const char *path;
+
+	g_return_val_if_fail (_monitor.objects, FALSE);
+
+	path = _monitor_object_get_path (object);
+	if (!path)
+		return FALSE;
+
+	mobj = g_hash_table_lookup (_monitor.objects, path);
+	if (!mobj || mobj->object != object)
+		return FALSE;
+
+	if (--mobj->watch_count > 0)
+		return TRUE;
+
+	g_signal_handlers_disconnect_by_data (object, mobj);
+	g_hash_table_steal (_monitor.objects, path);
+
+	g_hash_table_iter_init (&iter, mobj->children);
+	while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &child))
+		nmc_monitor_diff_unwatch (child);
+	g_hash_table_remove_all (mobj->children);
+
+	/* the queue owns removed objects until they are printed. */
+	mobj->removed = TRUE;
+	_monitor_schedule (mobj);
+	return TRUE;
+}
+
+/**
+ * nmc_monitor_diff_flush:
+ *
+ * Prints the pending changes, one JSON object per line:
+ * {"path":..., "event":"added", "type":...} when an object appears,
+ * {"path":..., "property":..., "value":...} for each changed property and
+ * {"path":..., "event":"removed"} when it disappears.
+ */
+void
+nmc_monitor_diff_flush (void)
+{
+	nm_auto_free_gstring GString *str = NULL;
+	gs_unref_ptrarray GPtrArray *queue = NULL;
+	guint i, j;
+
+	nm_clear_g_source (&_monitor.flush_id);
+
+	if (!_monitor.queue || !_monitor.queue->len)
+		return;
+
+	queue = g_steal_pointer (&_monitor.queue);
+	_monitor.queue = g_ptr_array_new ();
+
+	str = g_string_sized_new (1024);
+	for (i = 0; i < queue->len; i++) {
+		MonitorObject *mobj = queue->pdata[i];
+
+		mobj->queued = FALSE;
+
+		if (mobj->added) {
+			mobj->added = FALSE;
+			g_string_append (str, "{\"path\":");
+			nmc_json_append_string (str, mobj->path);
+			g_string_append (str, ",\"event\":\"added\",\"type\":");
+			nmc_json_append_string (str, G_OBJECT_TYPE_NAME (mobj->object));
+			g_string_append (str, "}\n");
+		}
+
+		if (mobj->removed) {
+			g_string_append (str, "{\"path\":");
+			nmc_json_append_string (str, mobj->path);
+			g_string_append (str, ",\"event\":\"removed\"}\n");
+			_monitor_object_free (mobj);
+			continue;
+		}
+
+		if (g_hash_table_size (mobj->dirty)) {
+			gs_free const char **names = NULL;
+			guint n_names;
+
+			names = (const char **) g_hash_table_get_keys_as_array (mobj->dirty, &n_names);
+			g_qsort_with_data (names, n_names, sizeof (const char *), nm_strcmp_p_with_data, NULL);
+			for (j = 0; j < n_names; j++) {
+				char *name;
+				char *value;
+
+				g_hash_table_lookup_extended (mobj->dirty, names[j],
+				                              (gpointer *) &name, (gpointer *) &value);
+				g_hash_table_steal (mobj->dirty, name);
+				g_string_append (str, "{\"path\":");
+				nmc_json_append_string (str, mobj->path);
+				g_string_append (str, ",\"property\":");
+				nmc_json_append_string (str, name);
+				g_string_append (str, ",\"value\":");
+				g_string_append (str, value);
+				g_string_append (str, "}\n");
+				g_hash_table_insert (mobj->values, name, value);
+			}
+		}
+	}
+
+	g_print ("%s", str->str);
+	fflush (stdout);
+}
+
+/**
+ * nmc_monitor_diff_object_added:
+ * @client: the #NMClient
+ * @object: the new #NMObject
+ * @user_data: unused
+ *
+ * Signal handler for the "*-added" signals of #NMClient.
+ */
+void
+nmc_monitor_diff_object_added (NMClient *client, gpointer object, gpointer user_data)
+{
+	nmc_monitor_diff_watch (object);
+}
+
+/**
+ * nmc_monitor_diff_object_removed:
+ * @client: the #NMClient
+ * @object: the removed #NMObject
+ * @user_data: unused
+ *
+ * Signal handler for the "*-removed" signals of #NMClient.
+ */
+void
+nmc_monitor_diff_object_removed (NMClient *client, gpointer object, gpointer user_data)
+{
+	nmc_monitor_diff_unwatch (object);
+}
+
+/**
+ * nmc_monitor_diff_start:
+ * @nmc: the #NmCli
+ * @flush_interval: milliseconds to collect changes before printing them
+ *
+ * Sets up the streaming of property changes of the monitor commands.
+ */
+void
+nmc_monitor_diff_start (NmCli *nmc, guint flush_interval)
+{
+	g_return_if_fail (!_monitor.objects);
+
+	_monitor.nmc = nmc;
+	_monitor.objects = g_hash_table_new (g_str_hash, g_str_equal);
+	_monitor.queue = g_ptr_array_new ();
+	_monitor.flush_interval = flush_interval;
+}
+
+/**
+ * nmc_monitor_parse_args:
+ * @nmc: the #NmCli
+ * @argc: pointer to the argument count
+ * @argv: pointer to the arguments
+ * @out_flush_interval: (out): the requested flush interval
+ *
+ * Consumes the leading options of the monitor commands, that is
+ * "--flush-interval <ms>".
+ *
+ * Returns: %FALSE on invalid input, with the error in nmc->return_text.
+ */
+gboolean
+nmc_monitor_parse_args (NmCli *nmc, int *argc, char ***argv, guint *out_flush_interval)
+{
+	gboolean has_flush_interval = FALSE;
+	unsigned long val;
+
+	*out_flush_interval = NMC_MONITOR_FLUSH_INTERVAL_DEFAULT;
+
+	while (*argc > 0) {
+		if (nmc->complete && *argc == 1) {
+			if ((**argv)[0] == '-')
+				nmc_complete_strings (**argv, "--flush-interval", NULL);
+			break;
+		}
+
+		if (!nmc_arg_is_option (**argv, "flush-interval"))
+			break;
+
+		next_arg (nmc, argc, argv, NULL);
+		if (*argc == 0) {
+			g_string_printf (nmc->return_text, _("Error: %s argument is missing."), "--flush-interval");
+			nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+			return FALSE;
+		}
+		if (!nmc->complete) {
+			if (!nmc_string_to_uint (**argv, TRUE, 0, 60000, &val)) {
+				g_string_printf (nmc->return_text, _("Error: '%s' is not a valid flush interval; use <0-60000> milliseconds."),
+				                 **argv);
+				nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+				return FALSE;
+			}
+			*out_flush_interval = val;
+		}
+		has_flush_interval = TRUE;
+		next_arg (nmc, argc, argv, NULL);
+	}
+
+	if (   has_flush_interval
+	    && nmc->nmc_config.print_output != NMC_PRINT_NDJSON) {
+		g_string_printf (nmc->return_text, _("Error: '--flush-interval' requires '--ndjson'."));
+		nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+		return FALSE;
+	}
+
+	return TRUE;
+}
@@ -89,6 +89,16 @@ void nmc_complete_bool (const char *prefix);
 
 const char *nmc_error_get_simple_message (GError *error);
 
+#define NMC_MONITOR_FLUSH_INTERVAL_DEFAULT 100
+
+gboolean nmc_monitor_parse_args (NmCli *nmc, int *argc, char ***argv, guint *out_flush_interval);
+void nmc_monitor_diff_start (NmCli *nmc, guint flush_interval);
+void nmc_monitor_diff_watch (gpointer object);
+gboolean nmc_monitor_diff_unwatch (gpointer object);
+void nmc_monitor_diff_flush (void);
+void nmc_monitor_diff_object_added (NMClient *client, gpointer object, gpointer user_data);
+void nmc_monitor_diff_object_removed (NMClient *client, gpointer object, gpointer user_data);
+
 extern const NmcMetaGenericInfo *const metagen_ip4_config[];
 extern const NmcMetaGenericInfo *const metagen_ip6_config[];
 extern const NmcMetaGenericInfo *const metagen_dhcp_config[];
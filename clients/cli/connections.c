@@ -1072,11 +1072,13 @@ usage_connection_monitor (void)
 {
 	g_printerr (_("Usage: nmcli connection monitor { ARGUMENTS | help }\n"
 	              "\n"
-	              "ARGUMENTS := [id | uuid | path] <ID> ...\n"
+	              "ARGUMENTS := [--flush-interval <ms>] [id | uuid | path] <ID> ...\n"
 	              "\n"
 	              "Monitor connection profile activity.\n"
 	              "This command prints a line whenever the specified connection changes.\n"
-	              "Monitors all connection profiles in case none is specified.\n\n"));
+	              "Monitors all connection profiles in case none is specified.\n"
+	              "With --ndjson, the changed profile properties are printed as JSON,\n"
+	              "collected for --flush-interval milliseconds (default 100).\n\n"));
 }
 
 static void
@@ -1149,35 +1151,56 @@ get_ac_for_connection_cmp (gconstpointer pa, gconstpointer pb, gpointer user_dat
 	return active_connection_cmp (ac_a, ac_b);
 }
 
-static NMActiveConnection *
-get_ac_for_connection (const GPtrArray *active_cons, NMConnection *connection, GPtrArray **out_result)
+/* Group the active connections by the NMRemoteConnection they reference.
+ * The values are arrays of active connections, sorted by active_connection_cmp(). */
+static GHashTable *
+get_ac_index (const GPtrArray *active_cons)
 {
+	GHashTable *index;
+	GHashTableIter iter;
+	GPtrArray *acs;
 	guint i;
-	NMActiveConnection *best_candidate = NULL;
-	GPtrArray *result = out_result ? *out_result : NULL;
+
+	index = g_hash_table_new_full (nm_direct_hash, NULL, NULL, (GDestroyNotify) g_ptr_array_unref);
 
 	for (i = 0; i < active_cons->len; i++) {
-		NMActiveConnection *candidate = g_ptr_array_index (active_cons, i);
+		NMActiveConnection *ac = g_ptr_array_index (active_cons, i);
 		NMRemoteConnection *con;
 
-		con = nm_active_connection_get_connection (candidate);
-		if (NM_CONNECTION (con) != connection)
+		con = nm_active_connection_get_connection (ac);
+		if (!con)
 			continue;
 
-		if (!out_result)
-			return candidate;
-		if (!result)
-			result = g_ptr_array_new_with_free_func (g_object_unref);
-		g_ptr_array_add (result, g_object_ref (candidate));
+		acs = g_hash_table_lookup (index, con);
+		if (!acs) {
+			acs = g_ptr_array_new_with_free_func (g_object_unref);
+			g_hash_table_insert (index, con, acs);
+		}
+		g_ptr_array_add (acs, g_object_ref (ac));
 	}
 
-	if (result) {
-		g_ptr_array_sort_with_data (result, get_ac_for_connection_cmp, NULL);
-		best_candidate = result->pdata[0];
+	g_hash_table_iter_init (&iter, index);
+	while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &acs)) {
+		if (acs->len > 1)
+			g_ptr_array_sort_with_data (acs, get_ac_for_connection_cmp, NULL);
+	}
+
+	return index;
+}
+
+static NMActiveConnection *
+get_ac_for_connection (GHashTable *ac_index, NMConnection *connection, GPtrArray **out_result)
+{
+	GPtrArray *result;
+
+	result = g_hash_table_lookup (ac_index, connection);
+	if (!result) {
+		NM_SET_OUT (out_result, NULL);
+		return NULL;
 	}
 
-	NM_SET_OUT (out_result, result);
-	return best_candidate;
+	NM_SET_OUT (out_result, g_ptr_array_ref (result));
+	return result->pdata[0];
 }
 
 typedef struct {
@@ -2004,6 +2027,7 @@ do_connections_show (NmCli *nmc, int argc, char **argv)
 		gboolean new_line = FALSE;
 		gboolean without_fields = (nmc->required_fields == NULL);
 		const GPtrArray *active_cons = nm_client_get_active_connections (nmc->client);
+		gs_unref_hashtable GHashTable *ac_index = NULL;
 
 		/* multiline mode is default for 'connection show <ID>' */
 		if (!nmc->mode_specified)
@@ -2107,7 +2131,9 @@ do_connections_show (NmCli *nmc, int argc, char **argv)
 					if (i_found_cons >= found_cons->len)
 						break;
 					con = found_cons->pdata[i_found_cons++];
-					get_ac_for_connection (active_cons, con, &found_acons);
+					if (!ac_index)
+						ac_index = get_ac_index (active_cons);
+					get_ac_for_connection (ac_index, con, &found_acons);
 				}
 
 				if (active_only && !explicit_acon && !found_acons) {
@@ -2117,7 +2143,8 @@ do_connections_show (NmCli *nmc, int argc, char **argv)
 
 				nm_assert (explicit_acon || con);
 
-				if (new_line)
+				if (   new_line
+				    && !nmc_print_output_is_json (nmc->nmc_config.print_output))
 					g_print ("\n");
 				new_line = TRUE;
 
@@ -2139,7 +2166,8 @@ do_connections_show (NmCli *nmc, int argc, char **argv)
 					for (i = 0; i < l; i++) {
 						NMActiveConnection *acon;
 
-						if (i > 0) {
+						if (   i > 0
+						    && !nmc_print_output_is_json (nmc->nmc_config.print_output)) {
 							/* if there are multiple active connections, separate them with newline.
 							 * that is a bit odd, because we already separate connections with newlines,
 							 * and commonly don't separate the connection from the first active connection. */
@@ -8525,18 +8553,28 @@ static void
 connection_watch (NmCli *nmc, NMConnection *connection)
 {
 	nmc->should_wait++;
+	if (nmc->nmc_config.print_output == NMC_PRINT_NDJSON) {
+		nmc_monitor_diff_watch (connection);
+		return;
+	}
 	g_signal_connect (connection, NM_CONNECTION_CHANGED, G_CALLBACK (connection_changed), nmc);
 }
 
 static void
 connection_unwatch (NmCli *nmc, NMConnection *connection)
 {
-	if (g_signal_handlers_disconnect_by_func (connection, G_CALLBACK (connection_changed), nmc))
+	if (nmc->nmc_config.print_output == NMC_PRINT_NDJSON) {
+		if (nmc_monitor_diff_unwatch (connection))
+			nmc->should_wait--;
+	} else if (g_signal_handlers_disconnect_by_func (connection, G_CALLBACK (connection_changed), nmc))
 		nmc->should_wait--;
 
 	/* Terminate if all the watched connections disappeared. */
-	if (!nmc->should_wait)
+	if (!nmc->should_wait) {
+		if (nmc->nmc_config.print_output == NMC_PRINT_NDJSON)
+			nmc_monitor_diff_flush ();
 		quit ();
+	}
 }
 
 static void
@@ -8544,7 +8582,8 @@ connection_added (NMClient *client, NMRemoteConnection *con, NmCli *nmc)
 {
 	NMConnection *connection = NM_CONNECTION (con);
 
-	g_print (_("%s: connection profile created\n"), nm_connection_get_id (connection));
+	if (nmc->nmc_config.print_output != NMC_PRINT_NDJSON)
+		g_print (_("%s: connection profile created\n"), nm_connection_get_id (connection));
 	connection_watch (nmc, connection);
 }
 
@@ -8553,7 +8592,8 @@ connection_removed (NMClient *client, NMRemoteConnection *con, NmCli *nmc)
 {
 	NMConnection *connection = NM_CONNECTION (con);
 
-	g_print (_("%s: connection profile removed\n"), nm_connection_get_id (connection));
+	if (nmc->nmc_config.print_output != NMC_PRINT_NDJSON)
+		g_print (_("%s: connection profile removed\n"), nm_connection_get_id (connection));
 	connection_unwatch (nmc, connection);
 }
 
@@ -8564,8 +8604,12 @@ do_connection_monitor (NmCli *nmc, int argc, char **argv)
 	guint i;
 	gs_unref_ptrarray GPtrArray *found_cons = NULL;
 	const GPtrArray *connections = NULL;
+	guint flush_interval;
 
 	next_arg (nmc, &argc, &argv, NULL);
+	if (!nmc_monitor_parse_args (nmc, &argc, &argv, &flush_interval))
+		return nmc->return_value;
+
 	if (argc == 0) {
 		/* No connections specified. Monitor all. */
 
@@ -8589,6 +8633,9 @@ do_connection_monitor (NmCli *nmc, int argc, char **argv)
 		}
 	}
 
+	if (nmc->nmc_config.print_output == NMC_PRINT_NDJSON)
+		nmc_monitor_diff_start (nmc, flush_interval);
+
 	for (i = 0; i < connections->len; i++)
 		connection_watch (nmc, connections->pdata[i]);
 
@@ -801,11 +801,13 @@ usage_device_monitor (void)
 {
 	g_printerr (_("Usage: nmcli device monitor { ARGUMENTS | help }\n"
 	              "\n"
-	              "ARGUMENTS := [<ifname>] ...\n"
+	              "ARGUMENTS := [--flush-interval <ms>] [<ifname>] ...\n"
 	              "\n"
 	              "Monitor device activity.\n"
 	              "This command prints a line whenever the specified devices change state.\n"
-	              "Monitors all devices in case no interface is specified.\n\n"));
+	              "Monitors all devices in case no interface is specified.\n"
+	              "With --ndjson, the changed device properties are printed as JSON,\n"
+	              "collected for --flush-interval milliseconds (default 100).\n\n"));
 }
 
 static void
@@ -1779,7 +1781,8 @@ do_device_show (NmCli *nmc, int argc, char **argv)
 		for (i = 0; devices[i]; i++) {
 			if (!show_device_info (devices[i], nmc))
 				break;
-			if (devices[i + 1])
+			if (   devices[i + 1]
+			    && !nmc_print_output_is_json (nmc->nmc_config.print_output))
 				g_print ("\n"); /* Empty line */
 		}
 
@@ -2614,6 +2617,10 @@ static void
 device_watch (NmCli *nmc, NMDevice *device)
 {
 	nmc->should_wait++;
+	if (nmc->nmc_config.print_output == NMC_PRINT_NDJSON) {
+		nmc_monitor_diff_watch (device);
+		return;
+	}
 	g_signal_connect (device, "notify::" NM_DEVICE_STATE, G_CALLBACK (device_state), nmc);
 	g_signal_connect (device, "notify::" NM_DEVICE_ACTIVE_CONNECTION, G_CALLBACK (device_ac), nmc);
 }
@@ -2621,36 +2628,54 @@ device_watch (NmCli *nmc, NMDevice *device)
 static void
 device_unwatch (NmCli *nmc, NMDevice *device)
 {
-	g_signal_handlers_disconnect_by_func (device, device_state, nmc);
-	if (g_signal_handlers_disconnect_by_func (device, device_ac, nmc))
-		nmc->should_wait--;
+	if (nmc->nmc_config.print_output == NMC_PRINT_NDJSON) {
+		if (nmc_monitor_diff_unwatch (device))
+			nmc->should_wait--;
+	} else {
+		g_signal_handlers_disconnect_by_func (device, device_state, nmc);
+		if (g_signal_handlers_disconnect_by_func (device, device_ac, nmc))
+			nmc->should_wait--;
+	}
 
 	/* Terminate if all the watched devices disappeared. */
-	if (!nmc->should_wait)
+	if (!nmc->should_wait) {
+		if (nmc->nmc_config.print_output == NMC_PRINT_NDJSON)
+			nmc_monitor_diff_flush ();
 		quit ();
+	}
 }
 
 static void
 device_added (NMClient *client, NMDevice *device, NmCli *nmc)
 {
-	g_print (_("%s: device created\n"), nm_device_get_iface (device));
+	if (nmc->nmc_config.print_output != NMC_PRINT_NDJSON)
+		g_print (_("%s: device created\n"), nm_device_get_iface (device));
 	device_watch (nmc, NM_DEVICE (device));
 }
 
 static void
 device_removed (NMClient *client, NMDevice *device, NmCli *nmc)
 {
-	g_print (_("%s: device removed\n"), nm_device_get_iface (device));
+	if (nmc->nmc_config.print_output != NMC_PRINT_NDJSON)
+		g_print (_("%s: device removed\n"), nm_device_get_iface (device));
 	device_unwatch (nmc, device);
 }
 
 static NMCResultCode
 do_devices_monitor (NmCli *nmc, int argc, char **argv)
 {
+	guint flush_interval;
+
 	if (nmc->complete)
 		return nmc->return_value;
 
 	next_arg (nmc, &argc, &argv, NULL);
+	if (!nmc_monitor_parse_args (nmc, &argc, &argv, &flush_interval))
+		return nmc->return_value;
+
+	if (nmc->nmc_config.print_output == NMC_PRINT_NDJSON)
+		nmc_monitor_diff_start (nmc, flush_interval);
+
 	if (argc == 0) {
 		/* No devices specified. Monitor all. */
 		const GPtrArray *devices = nm_client_get_devices (nmc->client);
@@ -2820,7 +2845,8 @@ wifi_print_aps (NMDeviceWifi *wifi,
 	gs_free char *header_name = NULL;
 	static gboolean empty_line = FALSE;
 
-	if (empty_line)
+	if (   empty_line
+	    && !nmc_print_output_is_json (nmc->nmc_config.print_output))
 		g_print ("\n"); /* Empty line between devices' APs */
 
 	/* Main header name */
@@ -354,7 +354,8 @@ usage_general (void)
 	              "  status\n\n"
 	              "  hostname [<hostname>]\n\n"
 	              "  permissions\n\n"
-	              "  logging [level <log level>] [domains <log domains>]\n\n"));
+	              "  logging [level <log level>] [domains <log domains>]\n\n"
+	              "  logging dump\n\n"));
 }
 
 static void
@@ -391,12 +392,14 @@ usage_general_logging (void)
 {
 	g_printerr (_("Usage: nmcli general logging { ARGUMENTS | help }\n"
 	              "\n"
-	              "ARGUMENTS := [level <log level>] [domains <log domains>]\n"
+	              "ARGUMENTS := [level <log level>] [domains <log domains>] | dump\n"
 	              "\n"
 	              "Get or change NetworkManager logging level and domains.\n"
 	              "Without any argument current logging level and domains are shown. In order to\n"
 	              "change logging state, provide level and/or domain. Please refer to the man page\n"
-	              "for the list of possible logging domains.\n\n"));
+	              "for the list of possible logging domains.\n"
+	              "With \"dump\", the recent trace messages that NetworkManager keeps in memory\n"
+	              "are printed.\n\n"));
 }
 
 static void
@@ -479,10 +482,14 @@ usage_radio_wwan (void)
 static void
 usage_monitor (void)
 {
-	g_printerr (_("Usage: nmcli monitor\n"
+	g_printerr (_("Usage: nmcli monitor { ARGUMENTS | help }\n"
+	              "\n"
+	              "ARGUMENTS := [--flush-interval <ms>]\n"
 	              "\n"
 	              "Monitor NetworkManager changes.\n"
-	              "Prints a line whenever a change occurs in NetworkManager\n\n"));
+	              "Prints a line whenever a change occurs in NetworkManager\n"
+	              "With --ndjson, the changed properties of all objects are printed\n"
+	              "as JSON, collected for --flush-interval milliseconds (default 100).\n\n"));
 }
 
 static void
@@ -686,6 +693,25 @@ nmc_complete_strings_nocase (const char *prefix, ...)
 	va_end (args);
 }
 
+static void
+dump_general_logging (NmCli *nmc)
+{
+	gs_free_error GError *error = NULL;
+	gs_strfreev char **entries = NULL;
+	char **iter;
+
+	entries = nm_client_dump_logging (nmc->client, &error);
+	if (!entries) {
+		g_string_printf (nmc->return_text, _("Error: failed to dump logging: %s"),
+		                 nmc_error_get_simple_message (error));
+		nmc->return_value = NMC_RESULT_ERROR_UNKNOWN;
+		return;
+	}
+
+	for (iter = entries; *iter; iter++)
+		g_print ("%s\n", *iter);
+}
+
 static NMCResultCode
 do_general_logging (NmCli *nmc, int argc, char **argv)
 {
@@ -697,6 +723,18 @@ do_general_logging (NmCli *nmc, int argc, char **argv)
 			return nmc->return_value;
 
 		show_general_logging (nmc);
+	} else if (   matches (*argv, "dump")
+	           && !matches (*argv, "domains")) {
+		if (argc == 1 && nmc->complete)
+			nmc_complete_strings (*argv, "dump", NULL);
+		if (next_arg (nmc, &argc, &argv, NULL) == 0) {
+			g_string_printf (nmc->return_text, _("Error: extra argument not allowed: '%s'."), *argv);
+			return NMC_RESULT_ERROR_USER_INPUT;
+		}
+		if (nmc->complete)
+			return nmc->return_value;
+
+		dump_general_logging (nmc);
 	} else {
 		/* arguments provided -> set logging level and domains */
 		const char *level = NULL;
@@ -704,7 +742,7 @@ do_general_logging (NmCli *nmc, int argc, char **argv)
 
 		do {
 			if (argc == 1 && nmc->complete)
-				nmc_complete_strings (*argv, "level", "domains", NULL);
+				nmc_complete_strings (*argv, "level", "domains", "dump", NULL);
 
 			if (matches (*argv, "level")) {
 				argc--;
@@ -1382,8 +1420,13 @@ do_overview (NmCli *nmc, int argc, char **argv)
 NMCResultCode
 do_monitor (NmCli *nmc, int argc, char **argv)
 {
+	guint flush_interval;
+
 	next_arg (nmc, &argc, &argv, NULL);
 
+	if (!nmc_monitor_parse_args (nmc, &argc, &argv, &flush_interval))
+		return nmc->return_value;
+
 	if (nmc->complete)
 		return nmc->return_value;
 
@@ -1397,6 +1440,42 @@ do_monitor (NmCli *nmc, int argc, char **argv)
 		return nmc->return_value;
 	}
 
+	if (nmc->nmc_config.print_output == NMC_PRINT_NDJSON) {
+		const GPtrArray *objects;
+		guint i;
+
+		/* a single stream of property changes of the manager, of all
+		 * devices, profiles and active connections. */
+		nmc_monitor_diff_start (nmc, flush_interval);
+		nmc_monitor_diff_watch (nmc->client);
+
+		objects = nm_client_get_devices (nmc->client);
+		for (i = 0; i < objects->len; i++)
+			nmc_monitor_diff_watch (objects->pdata[i]);
+		objects = nm_client_get_connections (nmc->client);
+		for (i = 0; i < objects->len; i++)
+			nmc_monitor_diff_watch (objects->pdata[i]);
+		objects = nm_client_get_active_connections (nmc->client);
+		for (i = 0; i < objects->len; i++)
+			nmc_monitor_diff_watch (objects->pdata[i]);
+
+		g_signal_connect (nmc->client, NM_CLIENT_DEVICE_ADDED,
+		                  G_CALLBACK (nmc_monitor_diff_object_added), NULL);
+		g_signal_connect (nmc->client, NM_CLIENT_DEVICE_REMOVED,
+		                  G_CALLBACK (nmc_monitor_diff_object_removed), NULL);
+		g_signal_connect (nmc->client, NM_CLIENT_CONNECTION_ADDED,
+		                  G_CALLBACK (nmc_monitor_diff_object_added), NULL);
+		g_signal_connect (nmc->client, NM_CLIENT_CONNECTION_REMOVED,
+		                  G_CALLBACK (nmc_monitor_diff_object_removed), NULL);
+		g_signal_connect (nmc->client, NM_CLIENT_ACTIVE_CONNECTION_ADDED,
+		                  G_CALLBACK (nmc_monitor_diff_object_added), NULL);
+		g_signal_connect (nmc->client, NM_CLIENT_ACTIVE_CONNECTION_REMOVED,
+		                  G_CALLBACK (nmc_monitor_diff_object_removed), NULL);
+
+		nmc->should_wait++;
+		return NMC_RESULT_SUCCESS;
+	}
+
 	if (!nm_client_get_nm_running (nmc->client)) {
 		char *str;
 
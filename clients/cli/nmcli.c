@@ -248,6 +248,8 @@ usage (void)
 	              "  -o[verview]                                    overview mode (hide default values)\n"
 	              "  -t[erse]                                       terse output\n"
 	              "  -p[retty]                                      pretty output\n"
+	              "  -j[son]                                        output as JSON array\n"
+	              "  --nd[json]                                     output as newline delimited JSON\n"
 	              "  -m[ode] tabular|multiline                      output mode\n"
 	              "  -c[olors] auto|yes|no                          whether to use colors in output\n"
 	              "  -f[ields] <field1,field2,...>|all|common       specify fields to output\n"
@@ -281,6 +283,18 @@ static const NMCCommand nmcli_cmds[] = {
 	{ NULL,          do_overview,     usage,  TRUE,   TRUE },
 };
 
+static gboolean
+set_print_output_structured (NmCli *nmc, NMCPrintOutput print_output, const char *option)
+{
+	if (nmc->nmc_config.print_output != NMC_PRINT_NORMAL) {
+		g_string_printf (nmc->return_text, _("Error: Option '%s' is mutually exclusive with '--terse', '--get-values', '--pretty', '--json' and '--ndjson'."), option);
+		nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+		return FALSE;
+	}
+	nmc->nmc_config_mutable.print_output = print_output;
+	return TRUE;
+}
+
 static gboolean
 matches_arg (NmCli *nmc, int *argc, char ***argv, const char *pattern, char **arg)
 {
@@ -730,7 +744,7 @@ process_command_line (NmCli *nmc, int argc, char **argv)
 			break;
 
 		if (argc == 1 && nmc->complete) {
-			nmc_complete_strings (argv[0], "--terse", "--pretty", "--mode", "--overview",
+			nmc_complete_strings (argv[0], "--terse", "--pretty", "--json", "--ndjson", "--mode", "--overview",
 			                               "--colors", "--escape",
 			                               "--fields", "--nocheck", "--get-values",
 			                               "--wait", "--version", "--help", NULL);
@@ -755,6 +769,11 @@ process_command_line (NmCli *nmc, int argc, char **argv)
 				nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
 				return FALSE;
 			}
+			else if (NM_IN_SET (nmc->nmc_config.print_output, NMC_PRINT_JSON, NMC_PRINT_NDJSON)) {
+				g_string_printf (nmc->return_text, _("Error: Option '--terse' is mutually exclusive with '--json' and '--ndjson'."));
+				nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+				return FALSE;
+			}
 			else
 				nmc->nmc_config_mutable.print_output = NMC_PRINT_TERSE;
 		} else if (matches_arg (nmc, &argc, &argv, "-pretty", NULL)) {
@@ -768,8 +787,16 @@ process_command_line (NmCli *nmc, int argc, char **argv)
 				nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
 				return FALSE;
 			}
+			else if (NM_IN_SET (nmc->nmc_config.print_output, NMC_PRINT_JSON, NMC_PRINT_NDJSON)) {
+				g_string_printf (nmc->return_text, _("Error: Option '--pretty' is mutually exclusive with '--json' and '--ndjson'."));
+				nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+				return FALSE;
+			}
 			else
 				nmc->nmc_config_mutable.print_output = NMC_PRINT_PRETTY;
+		} else if (matches_arg (nmc, &argc, &argv, "-json", NULL)) {
+			if (!set_print_output_structured (nmc, NMC_PRINT_JSON, "--json"))
+				return FALSE;
 		} else if (matches_arg (nmc, &argc, &argv, "-mode", &value)) {
 			nmc->mode_specified = TRUE;
 			if (argc == 1 && nmc->complete)
@@ -816,6 +843,11 @@ process_command_line (NmCli *nmc, int argc, char **argv)
 		} else if (matches_arg (nmc, &argc, &argv, "-get-values", &value)) {
 			if (argc == 1 && nmc->complete)
 				complete_fields (argv[0], value);
+			if (NM_IN_SET (nmc->nmc_config.print_output, NMC_PRINT_JSON, NMC_PRINT_NDJSON)) {
+				g_string_printf (nmc->return_text, _("Error: Option '--get-values' is mutually exclusive with '--json' and '--ndjson'."));
+				nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+				return FALSE;
+			}
 			nmc->required_fields = g_strdup (value);
 			nmc->nmc_config_mutable.print_output = NMC_PRINT_TERSE;
 			/* We want fixed tabular mode here, but just set the mode specified and rely on defaults:
@@ -825,6 +857,9 @@ process_command_line (NmCli *nmc, int argc, char **argv)
 			nmc->mode_specified = TRUE;
 		} else if (matches_arg (nmc, &argc, &argv, "-nocheck", NULL)) {
 			/* ignore for backward compatibility */
+		} else if (matches_arg (nmc, &argc, &argv, "-ndjson", NULL)) {
+			if (!set_print_output_structured (nmc, NMC_PRINT_NDJSON, "--ndjson"))
+				return FALSE;
 		} else if (matches_arg (nmc, &argc, &argv, "-wait", &value)) {
 			unsigned long timeout;
 
@@ -1058,6 +1093,8 @@ main (int argc, char *argv[])
 	if (process_command_line (&nm_cli, argc, argv))
 		g_main_loop_run (loop);
 
+	nmc_print_json_flush ();
+
 	if (nm_cli.complete) {
 		/* Remove error statuses from command completion runs. */
 		if (nm_cli.return_value < NMC_RESULT_COMPLETE_FILE)
@@ -69,7 +69,9 @@ typedef enum {
 typedef enum {
 	NMC_PRINT_TERSE = 0,
 	NMC_PRINT_NORMAL = 1,
-	NMC_PRINT_PRETTY = 2
+	NMC_PRINT_PRETTY = 2,
+	NMC_PRINT_JSON = 3,
+	NMC_PRINT_NDJSON = 4,
 } NMCPrintOutput;
 
 static inline NMMetaAccessorGetType
@@ -80,6 +82,12 @@ nmc_print_output_to_accessor_get_type (NMCPrintOutput print_output)
 	       : NM_META_ACCESSOR_GET_TYPE_PARSABLE;
 }
 
+static inline gboolean
+nmc_print_output_is_json (NMCPrintOutput print_output)
+{
+	return NM_IN_SET (print_output, NMC_PRINT_JSON, NMC_PRINT_NDJSON);
+}
+
 /* === Output fields === */
 
 typedef enum {
@@ -992,22 +992,13 @@ _print_data_cell_clear (gpointer cell_p)
 	_print_data_cell_clear_text (cell);
 }
 
-static void
-_print_fill (const NmcConfig *nmc_config,
-             gpointer const *targets,
-             gpointer targets_data,
-             const PrintDataCol *cols,
-             guint cols_len,
-             GArray **out_header_row,
-             GArray **out_cells)
+static GArray *
+_print_fill_header (const NmcConfig *nmc_config,
+                    const PrintDataCol *cols,
+                    guint cols_len)
 {
-	GArray *cells;
 	GArray *header_row;
-	guint i_row, i_col;
-	guint targets_len;
-	NMMetaAccessorGetType text_get_type;
-	NMMetaAccessorGetFlags text_get_flags;
-
+	guint i_col;
 
 	header_row = g_array_sized_new (FALSE, TRUE, sizeof (PrintDataHeaderCell), cols_len);
 	g_array_set_clear_func (header_row, _print_data_header_cell_clear);
@@ -1049,103 +1040,133 @@ _print_fill (const NmcConfig *nmc_config,
 		}
 	}
 
-	targets_len = NM_PTRARRAY_LEN (targets);
+	return header_row;
+}
 
-	cells = g_array_sized_new (FALSE, TRUE, sizeof (PrintDataCell), targets_len * header_row->len);
-	g_array_set_clear_func (cells, _print_data_cell_clear);
-	g_array_set_size (cells, targets_len * header_row->len);
+static void
+_print_fill_row (const NmcConfig *nmc_config,
+                 GArray *header_row,
+                 guint i_row,
+                 gpointer target,
+                 gpointer targets_data,
+                 PrintDataCell *cells_line)
+{
+	NMMetaAccessorGetType text_get_type;
+	NMMetaAccessorGetFlags text_get_flags;
+	guint i_col;
 
 	text_get_type = nmc_print_output_to_accessor_get_type (nmc_config->print_output);
 	text_get_flags = NM_META_ACCESSOR_GET_FLAGS_ACCEPT_STRV;
 	if (nmc_config->show_secrets)
 		text_get_flags |= NM_META_ACCESSOR_GET_FLAGS_SHOW_SECRETS;
 
-	for (i_row = 0; i_row < targets_len; i_row++) {
-		gpointer target = targets[i_row];
-		PrintDataCell *cells_line = &g_array_index (cells, PrintDataCell, i_row * header_row->len);
-
-		for (i_col = 0; i_col < header_row->len; i_col++) {
-			char *to_free = NULL;
-			PrintDataCell *cell = &cells_line[i_col];
-			PrintDataHeaderCell *header_cell;
-			const NMMetaAbstractInfo *info;
-			NMMetaAccessorGetOutFlags text_out_flags, color_out_flags;
-			gconstpointer value;
-			gboolean is_default;
-
-			header_cell = &g_array_index (header_row, PrintDataHeaderCell, i_col);
-			info = header_cell->col->selection_item->info;
+	for (i_col = 0; i_col < header_row->len; i_col++) {
+		char *to_free = NULL;
+		PrintDataCell *cell = &cells_line[i_col];
+		PrintDataHeaderCell *header_cell;
+		const NMMetaAbstractInfo *info;
+		NMMetaAccessorGetOutFlags text_out_flags, color_out_flags;
+		gconstpointer value;
+		gboolean is_default;
+
+		header_cell = &g_array_index (header_row, PrintDataHeaderCell, i_col);
+		info = header_cell->col->selection_item->info;
+
+		cell->row_idx = i_row;
+		cell->header_cell = header_cell;
+
+		value = nm_meta_abstract_info_get (info,
+		                                   nmc_meta_environment,
+		                                   nmc_meta_environment_arg,
+		                                   target,
+		                                   targets_data,
+		                                   text_get_type,
+		                                   text_get_flags,
+		                                   &text_out_flags,
+		                                   &is_default,
+		                                   (gpointer *) &to_free);
+
+		nm_assert (!to_free || value == to_free);
+
+		if (   is_default
+		    && (   nmc_config->overview
+		        || NM_FLAGS_HAS (text_out_flags, NM_META_ACCESSOR_GET_OUT_FLAGS_HIDE))) {
+			/* don't mark the entry for display. This is to shorten the output in case
+			 * the property is the default value. But we only do that, if the user
+			 * opts in to this behavior (-overview), or of the property marks itself
+			 * eligible to be hidden.
+			 *
+			 * In general, only new API shall mark itself eligible to be hidden.
+			 * Long established properties cannot, because it would be a change
+			 * in behavior. */
+		} else
+			header_cell->to_print = TRUE;
+
+		if (NM_FLAGS_HAS (text_out_flags, NM_META_ACCESSOR_GET_OUT_FLAGS_STRV)) {
+			if (nmc_config->multiline_output) {
+				cell->text_format = PRINT_DATA_CELL_FORMAT_TYPE_STRV;
+				cell->text.strv = value;
+				cell->text_to_free = !!to_free;
+			} else {
+				if (value && ((const char *const*) value)[0]) {
+					cell->text.plain = g_strjoinv (" | ", (char **) value);
+					cell->text_to_free = TRUE;
+				}
+				if (to_free)
+					g_strfreev ((char **) to_free);
+			}
+		} else {
+			cell->text.plain = value;
+			cell->text_to_free = !!to_free;
+		}
 
-			cell->row_idx = i_row;
-			cell->header_cell = header_cell;
+		cell->color = GPOINTER_TO_INT (nm_meta_abstract_info_get (info,
+		                                                          nmc_meta_environment,
+		                                                          nmc_meta_environment_arg,
+		                                                          target,
+		                                                          targets_data,
+		                                                          NM_META_ACCESSOR_GET_TYPE_COLOR,
+		                                                          NM_META_ACCESSOR_GET_FLAGS_NONE,
+		                                                          &color_out_flags,
+		                                                          NULL,
+		                                                          NULL));
+
+		if (cell->text_format == PRINT_DATA_CELL_FORMAT_TYPE_PLAIN) {
+			if (   NM_IN_SET (nmc_config->print_output, NMC_PRINT_NORMAL, NMC_PRINT_PRETTY)
+			    && (   !cell->text.plain
+			        || !cell->text.plain[0])) {
+				_print_data_cell_clear_text (cell);
+				cell->text.plain = "--";
+			} else if (!cell->text.plain)
+				cell->text.plain = "";
+			nm_assert (cell->text_format == PRINT_DATA_CELL_FORMAT_TYPE_PLAIN);
+		}
+	}
+}
 
-			value = nm_meta_abstract_info_get (info,
-			                                   nmc_meta_environment,
-			                                   nmc_meta_environment_arg,
-			                                   target,
-			                                   targets_data,
-			                                   text_get_type,
-			                                   text_get_flags,
-			                                   &text_out_flags,
-			                                   &is_default,
-			                                   (gpointer *) &to_free);
+static GArray *
+_print_fill (const NmcConfig *nmc_config,
+             gpointer const *targets,
+             gpointer targets_data,
+             GArray *header_row)
+{
+	GArray *cells;
+	guint i_row, i_col;
+	guint targets_len;
 
-			nm_assert (!to_free || value == to_free);
+	targets_len = NM_PTRARRAY_LEN (targets);
 
-			if (   is_default
-			    && (   nmc_config->overview
-			        || NM_FLAGS_HAS (text_out_flags, NM_META_ACCESSOR_GET_OUT_FLAGS_HIDE))) {
-				/* don't mark the entry for display. This is to shorten the output in case
-				 * the property is the default value. But we only do that, if the user
-				 * opts in to this behavior (-overview), or of the property marks itself
-				 * eligible to be hidden.
-				 *
-				 * In general, only new API shall mark itself eligible to be hidden.
-				 * Long established properties cannot, because it would be a change
-				 * in behavior. */
-			} else
-				header_cell->to_print = TRUE;
-
-			if (NM_FLAGS_HAS (text_out_flags, NM_META_ACCESSOR_GET_OUT_FLAGS_STRV)) {
-				if (nmc_config->multiline_output) {
-					cell->text_format = PRINT_DATA_CELL_FORMAT_TYPE_STRV;
-					cell->text.strv = value;
-					cell->text_to_free = !!to_free;
-				} else {
-					if (value && ((const char *const*) value)[0]) {
-						cell->text.plain = g_strjoinv (" | ", (char **) value);
-						cell->text_to_free = TRUE;
-					}
-					if (to_free)
-						g_strfreev ((char **) to_free);
-				}
-			} else {
-				cell->text.plain = value;
-				cell->text_to_free = !!to_free;
-			}
+	cells = g_array_sized_new (FALSE, TRUE, sizeof (PrintDataCell), targets_len * header_row->len);
+	g_array_set_clear_func (cells, _print_data_cell_clear);
+	g_array_set_size (cells, targets_len * header_row->len);
 
-			cell->color = GPOINTER_TO_INT (nm_meta_abstract_info_get (info,
-			                                                          nmc_meta_environment,
-			                                                          nmc_meta_environment_arg,
-			                                                          target,
-			                                                          targets_data,
-			                                                          NM_META_ACCESSOR_GET_TYPE_COLOR,
-			                                                          NM_META_ACCESSOR_GET_FLAGS_NONE,
-			                                                          &color_out_flags,
-			                                                          NULL,
-			                                                          NULL));
-
-			if (cell->text_format == PRINT_DATA_CELL_FORMAT_TYPE_PLAIN) {
-				if (   NM_IN_SET (nmc_config->print_output, NMC_PRINT_NORMAL, NMC_PRINT_PRETTY)
-				    && (   !cell->text.plain
-				        || !cell->text.plain[0])) {
-					_print_data_cell_clear_text (cell);
-					cell->text.plain = "--";
-				} else if (!cell->text.plain)
-					cell->text.plain = "";
-				nm_assert (cell->text_format == PRINT_DATA_CELL_FORMAT_TYPE_PLAIN);
-			}
-		}
+	for (i_row = 0; i_row < targets_len; i_row++) {
+		_print_fill_row (nmc_config,
+		                 header_row,
+		                 i_row,
+		                 targets[i_row],
+		                 targets_data,
+		                 &g_array_index (cells, PrintDataCell, i_row * header_row->len));
 	}
 
 	for (i_col = 0; i_col < header_row->len; i_col++) {
@@ -1154,7 +1175,7 @@ _print_fill (const NmcConfig *nmc_config,
 		header_cell->width = nmc_string_screen_width (header_cell->title, NULL);
 
 		for (i_row = 0; i_row < targets_len; i_row++) {
-			const PrintDataCell *cell = &g_array_index (cells, PrintDataCell, i_row * cols_len + i_col);
+			const PrintDataCell *cell = &g_array_index (cells, PrintDataCell, i_row * header_row->len + i_col);
 			const char *const*i_strv;
 
 			switch (cell->text_format) {
@@ -1177,8 +1198,7 @@ _print_fill (const NmcConfig *nmc_config,
 		header_cell->width += 1;
 	}
 
-	*out_header_row = header_row;
-	*out_cells = cells;
+	return cells;
 }
 
 static gboolean
@@ -1218,17 +1238,15 @@ _print_skip_column (const NmcConfig *nmc_config,
 }
 
 static void
-_print_do (const NmcConfig *nmc_config,
-           const char *header_name_no_l10n,
-           guint col_len,
-           guint row_len,
-           const PrintDataHeaderCell *header_row,
-           const PrintDataCell *cells)
+_print_do_header (const NmcConfig *nmc_config,
+                  const char *header_name_no_l10n,
+                  guint col_len,
+                  const PrintDataHeaderCell *header_row,
+                  GString *str)
 {
 	int width1, width2;
 	int table_width = 0;
-	guint i_row, i_col;
-	nm_auto_free_gstring GString *str = NULL;
+	guint i_col;
 
 	g_assert (col_len);
 
@@ -1256,10 +1274,6 @@ _print_do (const NmcConfig *nmc_config,
 		g_print ("%s\n", line);
 	}
 
-	str = !nmc_config->multiline_output
-	      ? g_string_sized_new (100)
-	      : NULL;
-
 	/* print the header for the tabular form */
 	if (   NM_IN_SET (nmc_config->print_output, NMC_PRINT_NORMAL, NMC_PRINT_PRETTY)
 	    && !nmc_config->multiline_output) {
@@ -1291,93 +1305,388 @@ _print_do (const NmcConfig *nmc_config,
 			g_print ("%s\n", (line = g_strnfill (table_width, '-')));
 		}
 	}
+}
 
-	for (i_row = 0; i_row < row_len; i_row++) {
-		const PrintDataCell *current_line = &cells[i_row * col_len];
+static void
+_print_do_row (const NmcConfig *nmc_config,
+               guint col_len,
+               const PrintDataHeaderCell *header_row,
+               const PrintDataCell *current_line,
+               GString *str)
+{
+	int width1, width2;
+	guint i_col;
 
-		for (i_col = 0; i_col < col_len; i_col++) {
-			const PrintDataCell *cell = &current_line[i_col];
-			const char *const*lines = NULL;
-			guint i_lines, lines_len;
+	for (i_col = 0; i_col < col_len; i_col++) {
+		const PrintDataCell *cell = &current_line[i_col];
+		const char *const*lines = NULL;
+		guint i_lines, lines_len;
 
-			if (_print_skip_column (nmc_config, cell->header_cell))
-				continue;
+		if (_print_skip_column (nmc_config, cell->header_cell))
+			continue;
 
-			lines_len = 0;
-			switch (cell->text_format) {
-			case PRINT_DATA_CELL_FORMAT_TYPE_PLAIN:
-				lines = &cell->text.plain;
-				lines_len = 1;
-				break;
-			case PRINT_DATA_CELL_FORMAT_TYPE_STRV:
-				nm_assert (nmc_config->multiline_output);
-				lines = cell->text.strv;
-				lines_len = NM_PTRARRAY_LEN (lines);
-				break;
-			}
+		lines_len = 0;
+		switch (cell->text_format) {
+		case PRINT_DATA_CELL_FORMAT_TYPE_PLAIN:
+			lines = &cell->text.plain;
+			lines_len = 1;
+			break;
+		case PRINT_DATA_CELL_FORMAT_TYPE_STRV:
+			nm_assert (nmc_config->multiline_output);
+			lines = cell->text.strv;
+			lines_len = NM_PTRARRAY_LEN (lines);
+			break;
+		}
 
-			for (i_lines = 0; i_lines < lines_len; i_lines++) {
-				gs_free char *text_to_free = NULL;
-				const char *text;
+		for (i_lines = 0; i_lines < lines_len; i_lines++) {
+			gs_free char *text_to_free = NULL;
+			const char *text;
 
-				text = colorize_string (nmc_config, cell->color, lines[i_lines], &text_to_free);
-				if (nmc_config->multiline_output) {
-					gs_free char *prefix = NULL;
+			text = colorize_string (nmc_config, cell->color, lines[i_lines], &text_to_free);
+			if (nmc_config->multiline_output) {
+				gs_free char *prefix = NULL;
 
-					if (cell->text_format == PRINT_DATA_CELL_FORMAT_TYPE_STRV)
-						prefix = g_strdup_printf ("%s[%u]:", cell->header_cell->title, i_lines + 1);
-					else
-						prefix = g_strdup_printf ("%s:", cell->header_cell->title);
-					width1 = strlen (prefix);
-					width2 = nmc_string_screen_width (prefix, NULL);
-					g_print ("%-*s%s\n",
-					         (int) (  nmc_config->print_output == NMC_PRINT_TERSE
-					               ? 0
-					               : ML_VALUE_INDENT+width1-width2),
-					         prefix,
-					         text);
-				} else {
-					nm_assert (str);
-					if (nmc_config->print_output == NMC_PRINT_TERSE) {
-						if (nmc_config->escape_values) {
-							const char *p = text;
-							while (*p) {
-								if (*p == ':' || *p == '\\')
-									g_string_append_c (str, '\\');  /* Escaping by '\' */
-								g_string_append_c (str, *p);
-								p++;
-							}
+				if (cell->text_format == PRINT_DATA_CELL_FORMAT_TYPE_STRV)
+					prefix = g_strdup_printf ("%s[%u]:", cell->header_cell->title, i_lines + 1);
+				else
+					prefix = g_strdup_printf ("%s:", cell->header_cell->title);
+				width1 = strlen (prefix);
+				width2 = nmc_string_screen_width (prefix, NULL);
+				g_print ("%-*s%s\n",
+				         (int) (  nmc_config->print_output == NMC_PRINT_TERSE
+				               ? 0
+				               : ML_VALUE_INDENT+width1-width2),
+				         prefix,
+				         text);
+			} else {
+				nm_assert (str);
+				if (nmc_config->print_output == NMC_PRINT_TERSE) {
+					if (nmc_config->escape_values) {
+						const char *p = text;
+						while (*p) {
+							if (*p == ':' || *p == '\\')
+								g_string_append_c (str, '\\');  /* Escaping by '\' */
+							g_string_append_c (str, *p);
+							p++;
 						}
-						else
-							g_string_append_printf (str, "%s", text);
-						g_string_append_c (str, ':');  /* Column separator */
-					} else {
-						const PrintDataHeaderCell *header_cell = &header_row[i_col];
-
-						width1 = strlen (text);
-						width2 = nmc_string_screen_width (text, NULL);  /* Width of the string (in screen columns) */
-						g_string_append_printf (str, "%-*s", (int) (header_cell->width + width1 - width2), text);
-						g_string_append_c (str, ' ');  /* Column separator */
-						table_width += header_cell->width + width1 - width2 + 1;
 					}
+					else
+						g_string_append_printf (str, "%s", text);
+					g_string_append_c (str, ':');  /* Column separator */
+				} else {
+					const PrintDataHeaderCell *header_cell = &header_row[i_col];
+
+					width1 = strlen (text);
+					width2 = nmc_string_screen_width (text, NULL);  /* Width of the string (in screen columns) */
+					g_string_append_printf (str, "%-*s", (int) (header_cell->width + width1 - width2), text);
+					g_string_append_c (str, ' ');  /* Column separator */
 				}
 			}
 		}
+	}
+
+	if (!nmc_config->multiline_output) {
+		if (str->len)
+			g_string_truncate (str, str->len-1);  /* Chop off last column separator */
+		g_print ("%s\n", str->str);
+
+		g_string_truncate (str, 0);
+	}
+
+	if (   nmc_config->print_output == NMC_PRINT_PRETTY
+	    && nmc_config->multiline_output) {
+		gs_free char *line = NULL;
+
+		g_print ("%s\n", (line = g_strnfill (ML_HEADER_WIDTH, '-')));
+	}
+}
+
+static void
+_print_do (const NmcConfig *nmc_config,
+           const char *header_name_no_l10n,
+           guint col_len,
+           guint row_len,
+           const PrintDataHeaderCell *header_row,
+           const PrintDataCell *cells)
+{
+	nm_auto_free_gstring GString *str = NULL;
+	guint i_row;
+
+	str = !nmc_config->multiline_output
+	      ? g_string_sized_new (100)
+	      : NULL;
+
+	_print_do_header (nmc_config, header_name_no_l10n, col_len, header_row, str);
+
+	for (i_row = 0; i_row < row_len; i_row++)
+		_print_do_row (nmc_config, col_len, header_row, &cells[i_row * col_len], str);
+}
+
+static gboolean
+_print_can_stream (const NmcConfig *nmc_config,
+                   const GArray *header_row)
+{
+	guint i_col;
+
+	/* the tabular output for humans aligns the columns, which requires
+	 * that we know all values upfront. */
+	if (   nmc_config->print_output != NMC_PRINT_TERSE
+	    && !nmc_config->multiline_output)
+		return FALSE;
+
+	/* whether a column is printed depends on whether any row has a non-default
+	 * value for it. That can only be the case with --overview, or for setting
+	 * properties that mark themselves as hidden. */
+	if (nmc_config->overview)
+		return FALSE;
+	for (i_col = 0; i_col < header_row->len; i_col++) {
+		const PrintDataHeaderCell *header_cell = &g_array_index (header_row, PrintDataHeaderCell, i_col);
+
+		if (header_cell->col->selection_item->info->meta_type == &nm_meta_type_property_info)
+			return FALSE;
+	}
+	return TRUE;
+}
+
+static void
+_print_stream (const NmcConfig *nmc_config,
+               gpointer const *targets,
+               gpointer targets_data,
+               const char *header_name_no_l10n,
+               GArray *header_row)
+{
+	nm_auto_free_gstring GString *str = NULL;
+	gs_unref_array GArray *cells = NULL;
+	guint i_row, i_col;
+
+	/* print each row as soon as it is filled, without keeping the
+	 * cells of all rows around. */
+	for (i_col = 0; i_col < header_row->len; i_col++)
+		g_array_index (header_row, PrintDataHeaderCell, i_col).to_print = TRUE;
+
+	str = !nmc_config->multiline_output
+	      ? g_string_sized_new (100)
+	      : NULL;
+
+	cells = g_array_sized_new (FALSE, TRUE, sizeof (PrintDataCell), header_row->len);
+	g_array_set_clear_func (cells, _print_data_cell_clear);
 
-		if (!nmc_config->multiline_output) {
-			if (str->len)
-				g_string_truncate (str, str->len-1);  /* Chop off last column separator */
-			g_print ("%s\n", str->str);
+	_print_do_header (nmc_config,
+	                  header_name_no_l10n,
+	                  header_row->len,
+	                  &g_array_index (header_row, PrintDataHeaderCell, 0),
+	                  str);
+
+	for (i_row = 0; targets && targets[i_row]; i_row++) {
+		g_array_set_size (cells, header_row->len);
+		_print_fill_row (nmc_config,
+		                 header_row,
+		                 i_row,
+		                 targets[i_row],
+		                 targets_data,
+		                 &g_array_index (cells, PrintDataCell, 0));
+		_print_do_row (nmc_config,
+		               header_row->len,
+		               &g_array_index (header_row, PrintDataHeaderCell, 0),
+		               &g_array_index (cells, PrintDataCell, 0),
+		               str);
+		g_array_set_size (cells, 0);
+	}
+}
 
-			g_string_truncate (str, 0);
+void
+nmc_json_append_string (GString *str, const char *s)
+{
+	g_string_append_c (str, '"');
+	for (; *s; s++) {
+		switch (*s) {
+		case '"':
+			g_string_append (str, "\\\"");
+			break;
+		case '\\':
+			g_string_append (str, "\\\\");
+			break;
+		case '\n':
+			g_string_append (str, "\\n");
+			break;
+		case '\t':
+			g_string_append (str, "\\t");
+			break;
+		default:
+			if ((guchar) *s < 0x20)
+				g_string_append_printf (str, "\\u%04x", (guint) ((guchar) *s));
+			else
+				g_string_append_c (str, *s);
+			break;
 		}
+	}
+	g_string_append_c (str, '"');
+}
 
-		if (   nmc_config->print_output == NMC_PRINT_PRETTY
-		    && nmc_config->multiline_output) {
-			gs_free char *line = NULL;
+/* With --json, the whole output of nmcli is a single JSON array. The
+ * rows of all tables are collected here and printed by
+ * nmc_print_json_flush() before nmcli exits. */
+static GString *_json_document;
 
-			g_print ("%s\n", (line = g_strnfill (ML_HEADER_WIDTH, '-')));
+static void
+_json_output_row (const NmcConfig *nmc_config, GString *row)
+{
+	if (nmc_config->print_output == NMC_PRINT_NDJSON) {
+		g_print ("%s\n", row->str);
+		return;
+	}
+
+	nm_assert (nmc_config->print_output == NMC_PRINT_JSON);
+	if (!_json_document)
+		_json_document = g_string_new ("[");
+	else if (_json_document->len > 1)
+		g_string_append_c (_json_document, ',');
+	g_string_append_len (_json_document, row->str, row->len);
+}
+
+/**
+ * nmc_print_json_flush:
+ *
+ * Print the JSON document collected with --json, if any table was printed.
+ */
+void
+nmc_print_json_flush (void)
+{
+	if (!_json_document)
+		return;
+
+	g_string_append (_json_document, "]\n");
+	g_print ("%s", _json_document->str);
+	g_string_free (_json_document, TRUE);
+	_json_document = NULL;
+}
+
+static gboolean
+_print_json_skip_column (const PrintDataCol *col)
+{
+	const NMMetaAbstractInfo *info = col->selection_item->info;
+
+	/* like the multiline output, skip the "name" entries of settings and
+	 * of nested generic infos. Their children carry the values. */
+	if (info->meta_type == &nm_meta_type_setting_info_editor)
+		return TRUE;
+	if (   info->meta_type == &nmc_meta_type_generic_info
+	    && ((const NmcMetaGenericInfo *) info)->nested)
+		return TRUE;
+	return FALSE;
+}
+
+static void
+_print_json (const NmcConfig *nmc_config,
+             gpointer const *targets,
+             gpointer targets_data,
+             const PrintDataCol *cols,
+             guint cols_len)
+{
+	nm_auto_free_gstring GString *str = NULL;
+	gs_unref_ptrarray GPtrArray *keys = NULL;
+	gs_free const PrintDataCol **leaf_cols = NULL;
+	NMMetaAccessorGetFlags get_flags;
+	guint n_leaf_cols = 0;
+	guint i_row, i_col;
+
+	/* values are fetched in their parsable form and written out directly.
+	 * There is no localization, no padding and no coloring. */
+	get_flags = NM_META_ACCESSOR_GET_FLAGS_ACCEPT_STRV;
+	if (nmc_config->show_secrets)
+		get_flags |= NM_META_ACCESSOR_GET_FLAGS_SHOW_SECRETS;
+
+	keys = g_ptr_array_new_with_free_func (g_free);
+	leaf_cols = g_new (const PrintDataCol *, cols_len + 1);
+	for (i_col = 0; i_col < cols_len; i_col++) {
+		const PrintDataCol *col = &cols[i_col];
+		const char *name;
+
+		if (   !col->is_leaf
+		    || _print_json_skip_column (col))
+			continue;
+
+		name = nm_meta_abstract_info_get_name (col->selection_item->info, FALSE);
+		if (col->parent_col) {
+			name = g_strdup_printf ("%s.%s",
+			                        nm_meta_abstract_info_get_name (col->parent_col->selection_item->info, FALSE),
+			                        name);
+		} else
+			name = g_strdup (name);
+		g_ptr_array_add (keys, (char *) name);
+		leaf_cols[n_leaf_cols++] = col;
+	}
+
+	/* a table without rows still results in an (empty) document. */
+	if (   nmc_config->print_output == NMC_PRINT_JSON
+	    && !_json_document)
+		_json_document = g_string_new ("[");
+
+	str = g_string_sized_new (200);
+
+	for (i_row = 0; targets && targets[i_row]; i_row++) {
+		gboolean first = TRUE;
+
+		g_string_truncate (str, 0);
+		g_string_append_c (str, '{');
+
+		for (i_col = 0; i_col < n_leaf_cols; i_col++) {
+			const NMMetaAbstractInfo *info = leaf_cols[i_col]->selection_item->info;
+			gs_free gpointer to_free = NULL;
+			NMMetaAccessorGetOutFlags out_flags;
+			gconstpointer value;
+			gboolean is_default;
+
+			value = nm_meta_abstract_info_get (info,
+			                                   nmc_meta_environment,
+			                                   nmc_meta_environment_arg,
+			                                   targets[i_row],
+			                                   targets_data,
+			                                   NM_META_ACCESSOR_GET_TYPE_PARSABLE,
+			                                   get_flags,
+			                                   &out_flags,
+			                                   &is_default,
+			                                   &to_free);
+
+			if (   is_default
+			    && (   nmc_config->overview
+			        || NM_FLAGS_HAS (out_flags, NM_META_ACCESSOR_GET_OUT_FLAGS_HIDE))) {
+				if (NM_FLAGS_HAS (out_flags, NM_META_ACCESSOR_GET_OUT_FLAGS_STRV) && to_free) {
+					g_strfreev (to_free);
+					to_free = NULL;
+				}
+				continue;
+			}
+
+			if (!first)
+				g_string_append_c (str, ',');
+			first = FALSE;
+			nmc_json_append_string (str, keys->pdata[i_col]);
+			g_string_append_c (str, ':');
+
+			if (NM_FLAGS_HAS (out_flags, NM_META_ACCESSOR_GET_OUT_FLAGS_STRV)) {
+				const char *const*strv = value;
+				gsize i;
+
+				g_string_append_c (str, '[');
+				for (i = 0; strv && strv[i]; i++) {
+					if (i > 0)
+						g_string_append_c (str, ',');
+					nmc_json_append_string (str, strv[i]);
+				}
+				g_string_append_c (str, ']');
+				if (to_free) {
+					g_strfreev (to_free);
+					to_free = NULL;
+				}
+			} else if (!value)
+				g_string_append (str, "null");
+			else
+				nmc_json_append_string (str, value);
 		}
+
+		g_string_append_c (str, '}');
+		_json_output_row (nmc_config, str);
 	}
 }
 
@@ -1400,13 +1709,31 @@ nmc_print (const NmcConfig *nmc_config,
 	                              error))
 		return FALSE;
 
-	_print_fill (nmc_config,
-	             targets,
-	             targets_data,
-	             &g_array_index (cols, PrintDataCol, 0),
-	             cols->len,
-	             &header_row,
-	             &cells);
+	if (NM_IN_SET (nmc_config->print_output, NMC_PRINT_JSON, NMC_PRINT_NDJSON)) {
+		_print_json (nmc_config,
+		             targets,
+		             targets_data,
+		             &g_array_index (cols, PrintDataCol, 0),
+		             cols->len);
+		return TRUE;
+	}
+
+	header_row = _print_fill_header (nmc_config,
+	                                 &g_array_index (cols, PrintDataCol, 0),
+	                                 cols->len);
+	if (_print_can_stream (nmc_config, header_row)) {
+		_print_stream (nmc_config,
+		               targets,
+		               targets_data,
+		               header_name_no_l10n,
+		               header_row);
+		return TRUE;
+	}
+
+	cells = _print_fill (nmc_config,
+	                     targets,
+	                     targets_data,
+	                     header_row);
 
 	_print_do (nmc_config,
 	           header_name_no_l10n,
@@ -1454,7 +1781,7 @@ nmc_terminal_spawn_pager (const NmcConfig *nmc_config)
 
 	if (   nm_cli.nmc_config.in_editor
 	    || nm_cli.pager_pid > 0
-	    || nmc_config->print_output == NMC_PRINT_TERSE
+	    || NM_IN_SET (nmc_config->print_output, NMC_PRINT_TERSE, NMC_PRINT_JSON, NMC_PRINT_NDJSON)
 	    || !nmc_config->use_colors
 	    || g_strcmp0 (pager, "") == 0
 	    || getauxval (AT_SECURE))
@@ -1569,6 +1896,63 @@ get_value_to_print (const NmcConfig *nmc_config,
  * Various flags influencing the output of fields are set up in the first item
  * of 'field_values' array.
  */
+static void
+_print_required_fields_json (const NmcConfig *nmc_config,
+                             gboolean section_prefix,
+                             const GArray *indices,
+                             const NmcOutputField *field_values)
+{
+	nm_auto_free_gstring GString *str = NULL;
+	const char *prefix = NULL;
+	gboolean first = TRUE;
+	guint i;
+
+	/* the legacy printing code prints one row at a time. Each row
+	 * becomes one object of the output, like the rows of nmc_print(). */
+	if (section_prefix)
+		prefix = field_values[0].value;
+
+	str = g_string_sized_new (200);
+	g_string_append_c (str, '{');
+	for (i = 0; i < indices->len; i++) {
+		int idx = g_array_index (indices, int, i);
+		const char *name;
+
+		if (section_prefix && idx == 0)
+			continue;
+
+		if (!first)
+			g_string_append_c (str, ',');
+		first = FALSE;
+
+		name = nm_meta_abstract_info_get_name (field_values[idx].info, FALSE);
+		if (prefix) {
+			gs_free char *key = g_strdup_printf ("%s.%s", prefix, name);
+
+			nmc_json_append_string (str, key);
+		} else
+			nmc_json_append_string (str, name);
+		g_string_append_c (str, ':');
+
+		if (field_values[idx].value_is_array) {
+			const char *const*p;
+
+			g_string_append_c (str, '[');
+			for (p = field_values[idx].value; p && *p; p++) {
+				if (p != field_values[idx].value)
+					g_string_append_c (str, ',');
+				nmc_json_append_string (str, *p);
+			}
+			g_string_append_c (str, ']');
+		} else if (!field_values[idx].value)
+			g_string_append (str, "null");
+		else
+			nmc_json_append_string (str, field_values[idx].value);
+	}
+	g_string_append_c (str, '}');
+	_json_output_row (nmc_config, str);
+}
+
 void
 print_required_fields (const NmcConfig *nmc_config,
                        NmcOfFlags of_flags,
@@ -1617,6 +2001,12 @@ print_required_fields (const NmcConfig *nmc_config,
 	if (main_header_only)
 		return;
 
+	if (NM_IN_SET (nmc_config->print_output, NMC_PRINT_JSON, NMC_PRINT_NDJSON)) {
+		if (!field_names)
+			_print_required_fields_json (nmc_config, section_prefix, indices, field_values);
+		return;
+	}
+
 	/* No field headers are printed in terse mode nor for multiline output */
 	if (   (   nmc_config->print_output == NMC_PRINT_TERSE
 	        || nmc_config->multiline_output)
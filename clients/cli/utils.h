@@ -344,6 +344,9 @@ gboolean nmc_print (const NmcConfig *nmc_config,
                     const char *fields_str,
                     GError **error);
 
+void nmc_json_append_string (GString *str, const char *s);
+void nmc_print_json_flush (void);
+
 /*****************************************************************************/
 
 #endif /* NMC_UTILS_H */
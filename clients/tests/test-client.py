@@ -1075,6 +1075,76 @@ class TestNmcli(NmTestBase):
             self.call_nmcli_l(mode + ['-f', 'GENERAL,CAPABILITIES,WIFI-PROPERTIES,AP,WIRED-PROPERTIES,WIMAX-PROPERTIES,NSP,IP4,DHCP4,IP6,DHCP6,BOND,TEAM,BRIDGE,VLAN,BLUETOOTH,CONNECTIONS', 'device', 'show', 'wlan0' ],
                               replace_stdout = replace_stdout)
 
+    @nm_test
+    def test_005(self):
+        self.init_001()
+
+        self.call_nmcli(['--json', '-f', 'DEVICE,TYPE,DBUS-PATH', 'dev'])
+        self.call_nmcli(['--ndjson', '-f', 'DEVICE,TYPE,DBUS-PATH', 'dev'])
+
+        # several tables still result in a single JSON document.
+        self.call_nmcli(['--json', '-f', 'GENERAL.DEVICE', 'dev', 'show'])
+        self.call_nmcli(['--ndjson', '-f', 'GENERAL.DEVICE', 'dev', 'show'])
+
+        # the structured output modes are exclusive with the other modes,
+        # regardless of the order of the options.
+        self.call_nmcli(['--json', '-g', 'DEVICE', 'dev'])
+        self.call_nmcli(['-g', 'DEVICE', '--json', 'dev'])
+        self.call_nmcli(['--ndjson', '--terse', 'dev'])
+        self.call_nmcli(['--terse', '--ndjson', 'dev'])
+
+    @nm_test
+    def test_006(self):
+        self.init_001()
+
+        replace_stdout = [(Util.memoize_nullary(lambda: self.srv.findConnectionUuid('con-vpn-1')), 'UUID-con-vpn-1-REPLACED-REPLACED-REP')]
+
+        self.call_nmcli(['connection', 'add', 'type', 'vpn', 'con-name', 'con-vpn-1', 'ifname', '*', 'vpn-type', 'openvpn', 'vpn.data', 'key1 = val1', 'vpn.secrets', 'password = s3cret'],
+                        replace_stdout = replace_stdout)
+
+        # NMSettingVpn has secret flags for any property name. Only the
+        # secrets themselves must be hidden from the monitor.
+        props = set([l['property'] for l in self.call_nmcli_monitor(['--ndjson', 'connection', 'monitor', 'con-vpn-1'])
+                     if 'property' in l])
+        self.assertIn('vpn.service-type', props)
+        self.assertIn('vpn.data', props)
+        self.assertIn('vpn.persistent', props)
+        self.assertNotIn('vpn.secrets', props)
+
+    def call_nmcli_monitor(self, args, timeout = 1):
+        import json
+
+        # the monitor commands don't terminate on their own. Let them print
+        # the initial state of the objects, then stop them and return the
+        # NDJSON lines they printed.
+        env = {}
+        for k in ['LD_LIBRARY_PATH',
+                  'DBUS_SESSION_BUS_ADDRESS']:
+            val = os.environ.get(k, None)
+            if val is not None:
+                env[k] = val
+        env['LANG'] = 'C'
+        env['LIBNM_USE_SESSION_BUS'] = '1'
+        env['LIBNM_USE_NO_UDEV'] = '1'
+        env['G_DEBUG'] = 'fatal-warnings'
+
+        p = subprocess.Popen([conf.get(ENV_NM_TEST_CLIENT_NMCLI_PATH)] + list(args),
+                             stdout = subprocess.PIPE,
+                             stderr = subprocess.PIPE,
+                             env = env)
+        try:
+            Util.popen_wait(p, timeout)
+        except Exception:
+            pass
+        if p.returncode is None:
+            p.terminate()
+            Util.popen_wait(p, 2)
+        stdout = p.stdout.read()
+        p.stdout.close()
+        p.stderr.close()
+        self.assertNotEqual(p.returncode, -5)
+        return [json.loads(l) for l in stdout.decode('utf-8').splitlines() if l]
+
 ###############################################################################
 
 def main():
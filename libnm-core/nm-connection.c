@@ -27,6 +27,7 @@
 
 #include "nm-connection.h"
 #include "nm-connection-private.h"
+#include "nm-simple-connection.h"
 #include "nm-utils.h"
 #include "nm-setting-private.h"
 #include "nm-core-internal.h"
@@ -57,6 +58,21 @@ typedef struct {
 
 	/* D-Bus path of the connection, if any */
 	char *path;
+
+	/* sealed duplicates of the settings, indexed by the type name. They are
+	 * shared by all snapshots (see _nm_connection_get_snapshot()) and only
+	 * replaced for the settings that changed in the meantime.
+	 *
+	 * The table holds no references. The snapshots own the settings, and an
+	 * entry is dropped when the last snapshot using it goes away. */
+	GHashTable *snapshot_settings;
+
+	/* the last snapshot, as long as the connection didn't change and the
+	 * snapshot is still alive (a weak reference). */
+	NMConnection *snapshot;
+
+	/* a sealed connection is a snapshot and must not be modified. */
+	bool sealed:1;
 } NMConnectionPrivate;
 
 static NMConnectionPrivate *nm_connection_get_private (NMConnection *connection);
@@ -75,18 +91,72 @@ static guint signals[LAST_SIGNAL] = { 0 };
 
 /*****************************************************************************/
 
+static void
+_snapshot_weak_notify (gpointer user_data, GObject *where_the_object_was)
+{
+	NMConnectionPrivate *priv = user_data;
+
+	nm_assert (priv->snapshot == (NMConnection *) where_the_object_was);
+	priv->snapshot = NULL;
+}
+
+static void
+_snapshot_setting_weak_notify (gpointer user_data, GObject *where_the_object_was)
+{
+	NMConnectionPrivate *priv = user_data;
+	const char *name = G_OBJECT_TYPE_NAME (where_the_object_was);
+
+	if (g_hash_table_lookup (priv->snapshot_settings, name) == where_the_object_was)
+		g_hash_table_remove (priv->snapshot_settings, name);
+}
+
+static gboolean
+_snapshot_setting_release (gpointer key, gpointer value, gpointer user_data)
+{
+	g_object_weak_unref (value, _snapshot_setting_weak_notify, user_data);
+	return TRUE;
+}
+
+static void
+_snapshot_invalidate (NMConnectionPrivate *priv, const char *setting_name)
+{
+	NMSetting *s_sealed;
+
+	if (priv->snapshot) {
+		g_object_weak_unref (G_OBJECT (priv->snapshot), _snapshot_weak_notify, priv);
+		priv->snapshot = NULL;
+	}
+
+	if (!priv->snapshot_settings)
+		return;
+
+	if (setting_name) {
+		s_sealed = g_hash_table_lookup (priv->snapshot_settings, setting_name);
+		if (s_sealed) {
+			g_object_weak_unref (G_OBJECT (s_sealed), _snapshot_setting_weak_notify, priv);
+			g_hash_table_remove (priv->snapshot_settings, setting_name);
+		}
+	} else
+		g_hash_table_foreach_remove (priv->snapshot_settings, _snapshot_setting_release, priv);
+}
+
 static void
 setting_changed_cb (NMSetting *setting,
                     GParamSpec *pspec,
                     NMConnection *self)
 {
+	_snapshot_invalidate (NM_CONNECTION_GET_PRIVATE (self), G_OBJECT_TYPE_NAME (setting));
 	g_signal_emit (self, signals[CHANGED], 0);
 }
 
 static gboolean
 _setting_release (gpointer key, gpointer value, gpointer user_data)
 {
-	g_signal_handlers_disconnect_by_func (user_data, setting_changed_cb, value);
+	NMConnectionPrivate *priv = user_data;
+
+	_snapshot_invalidate (priv, key);
+	if (!priv->sealed)
+		g_signal_handlers_disconnect_by_func (value, setting_changed_cb, priv->self);
 	return TRUE;
 }
 
@@ -103,6 +173,15 @@ _nm_connection_add_setting (NMConnection *connection, NMSetting *setting)
 	priv = NM_CONNECTION_GET_PRIVATE (connection);
 	name = G_OBJECT_TYPE_NAME (setting);
 
+	_snapshot_invalidate (priv, name);
+
+	if (priv->sealed) {
+		/* the settings of a sealed connection are sealed too and
+		 * never change. No need to track them. */
+		g_hash_table_insert (priv->settings, (gpointer) name, setting);
+		return;
+	}
+
 	if ((s_old = g_hash_table_lookup (priv->settings, (gpointer) name)))
 		g_signal_handlers_disconnect_by_func (s_old, setting_changed_cb, connection);
 	g_hash_table_insert (priv->settings, (gpointer) name, setting);
@@ -125,6 +204,7 @@ nm_connection_add_setting (NMConnection *connection, NMSetting *setting)
 {
 	g_return_if_fail (NM_IS_CONNECTION (connection));
 	g_return_if_fail (NM_IS_SETTING (setting));
+	g_return_if_fail (!NM_CONNECTION_GET_PRIVATE (connection)->sealed);
 
 	_nm_connection_add_setting (connection, setting);
 	g_signal_emit (connection, signals[CHANGED], 0);
@@ -141,9 +221,11 @@ _nm_connection_remove_setting (NMConnection *connection, GType setting_type)
 	g_return_val_if_fail (g_type_is_a (setting_type, NM_TYPE_SETTING), FALSE);
 
 	priv = NM_CONNECTION_GET_PRIVATE (connection);
+	g_return_val_if_fail (!priv->sealed, FALSE);
 	setting_name = g_type_name (setting_type);
 	setting = g_hash_table_lookup (priv->settings, setting_name);
 	if (setting) {
+		_snapshot_invalidate (priv, setting_name);
 		g_signal_handlers_disconnect_by_func (setting, setting_changed_cb, connection);
 		g_hash_table_remove (priv->settings, setting_name);
 		g_signal_emit (connection, signals[CHANGED], 0);
@@ -388,7 +470,7 @@ _nm_connection_replace_settings (NMConnection *connection,
 	}
 
 	if (g_hash_table_size (priv->settings) > 0) {
-		g_hash_table_foreach_remove (priv->settings, _setting_release, connection);
+		g_hash_table_foreach_remove (priv->settings, _setting_release, priv);
 		changed = TRUE;
 	} else
 		changed = (settings != NULL);
@@ -473,7 +555,7 @@ nm_connection_replace_settings_from_connection (NMConnection *connection,
 	new_priv = NM_CONNECTION_GET_PRIVATE (new_connection);
 
 	if ((changed = g_hash_table_size (priv->settings) > 0))
-		g_hash_table_foreach_remove (priv->settings, _setting_release, connection);
+		g_hash_table_foreach_remove (priv->settings, _setting_release, priv);
 
 	if (g_hash_table_size (new_priv->settings)) {
 		g_hash_table_iter_init (&iter, new_priv->settings);
@@ -502,11 +584,88 @@ nm_connection_clear_settings (NMConnection *connection)
 	priv = NM_CONNECTION_GET_PRIVATE (connection);
 
 	if (g_hash_table_size (priv->settings) > 0) {
-		g_hash_table_foreach_remove (priv->settings, _setting_release, connection);
+		g_hash_table_foreach_remove (priv->settings, _setting_release, priv);
 		g_signal_emit (connection, signals[CHANGED], 0);
 	}
 }
 
+/*****************************************************************************/
+
+gboolean
+_nm_connection_is_sealed (NMConnection *connection)
+{
+	g_return_val_if_fail (NM_IS_CONNECTION (connection), FALSE);
+
+	return NM_CONNECTION_GET_PRIVATE (connection)->sealed;
+}
+
+/**
+ * _nm_connection_get_snapshot:
+ * @connection: the #NMConnection
+ *
+ * Returns an immutable copy of @connection. Contrary to
+ * nm_simple_connection_new_clone(), the settings of the snapshot are sealed
+ * and shared between all snapshots of @connection (and the snapshot itself is
+ * reused), as long as they don't change. Taking repeated snapshots of a
+ * connection that changes rarely is thus cheap. Only the settings that
+ * changed since the last snapshot get duplicated.
+ *
+ * @connection only keeps weak references to its snapshot and the sealed
+ * settings. Once all snapshots are gone, no memory is held for them.
+ *
+ * The returned connection and its settings must not be modified. Sealed
+ * settings refuse changes via g_object_set(). If @connection is itself
+ * a snapshot, it is returned as is.
+ *
+ * Returns: (transfer full): the snapshot of @connection.
+ */
+NMConnection *
+_nm_connection_get_snapshot (NMConnection *connection)
+{
+	NMConnectionPrivate *priv;
+	NMConnectionPrivate *snapshot_priv;
+	NMConnection *snapshot;
+	GHashTableIter iter;
+	const char *name;
+	NMSetting *setting;
+	NMSetting *s_sealed;
+
+	g_return_val_if_fail (NM_IS_CONNECTION (connection), NULL);
+
+	priv = NM_CONNECTION_GET_PRIVATE (connection);
+
+	if (priv->sealed)
+		return g_object_ref (connection);
+
+	if (priv->snapshot)
+		return g_object_ref (priv->snapshot);
+
+	if (!priv->snapshot_settings)
+		priv->snapshot_settings = g_hash_table_new (nm_str_hash, g_str_equal);
+
+	snapshot = nm_simple_connection_new ();
+	snapshot_priv = NM_CONNECTION_GET_PRIVATE (snapshot);
+	snapshot_priv->path = g_strdup (priv->path);
+	snapshot_priv->sealed = TRUE;
+
+	g_hash_table_iter_init (&iter, priv->settings);
+	while (g_hash_table_iter_next (&iter, (gpointer *) &name, (gpointer *) &setting)) {
+		s_sealed = g_hash_table_lookup (priv->snapshot_settings, name);
+		if (!s_sealed) {
+			s_sealed = nm_setting_duplicate (setting);
+			_nm_setting_seal (s_sealed);
+			g_object_weak_ref (G_OBJECT (s_sealed), _snapshot_setting_weak_notify, priv);
+			g_hash_table_insert (priv->snapshot_settings, (gpointer) name, s_sealed);
+			_nm_connection_add_setting (snapshot, s_sealed);
+		} else
+			_nm_connection_add_setting (snapshot, g_object_ref (s_sealed));
+	}
+
+	priv->snapshot = snapshot;
+	g_object_weak_ref (G_OBJECT (snapshot), _snapshot_weak_notify, priv);
+	return snapshot;
+}
+
 /**
  * nm_connection_compare:
  * @a: a #NMConnection
@@ -1668,6 +1827,7 @@ nm_connection_update_secrets (NMConnection *connection,
 		                                             setting_dict ?: secrets,
 		                                             error);
 		g_signal_handlers_unblock_by_func (setting, (GCallback) setting_changed_cb, connection);
+		_snapshot_invalidate (NM_CONNECTION_GET_PRIVATE (connection), G_OBJECT_TYPE_NAME (setting));
 
 		g_clear_pointer (&setting_dict, g_variant_unref);
 
@@ -1698,6 +1858,7 @@ nm_connection_update_secrets (NMConnection *connection,
 			g_signal_handlers_block_by_func (setting, (GCallback) setting_changed_cb, connection);
 			success_detail = _nm_setting_update_secrets (setting, setting_dict, error);
 			g_signal_handlers_unblock_by_func (setting, (GCallback) setting_changed_cb, connection);
+			_snapshot_invalidate (NM_CONNECTION_GET_PRIVATE (connection), G_OBJECT_TYPE_NAME (setting));
 
 			g_variant_unref (setting_dict);
 
@@ -1787,15 +1948,20 @@ nm_connection_need_secrets (NMConnection *connection,
 void
 nm_connection_clear_secrets (NMConnection *connection)
 {
+	NMConnectionPrivate *priv;
 	GHashTableIter iter;
 	NMSetting *setting;
 
 	g_return_if_fail (NM_IS_CONNECTION (connection));
 
-	g_hash_table_iter_init (&iter, NM_CONNECTION_GET_PRIVATE (connection)->settings);
+	priv = NM_CONNECTION_GET_PRIVATE (connection);
+	g_return_if_fail (!priv->sealed);
+
+	g_hash_table_iter_init (&iter, priv->settings);
 	while (g_hash_table_iter_next (&iter, NULL, (gpointer) &setting)) {
 		g_signal_handlers_block_by_func (setting, (GCallback) setting_changed_cb, connection);
-		_nm_setting_clear_secrets (setting);
+		if (_nm_setting_clear_secrets (setting))
+			_snapshot_invalidate (priv, G_OBJECT_TYPE_NAME (setting));
 		g_signal_handlers_unblock_by_func (setting, (GCallback) setting_changed_cb, connection);
 	}
 
@@ -1816,15 +1982,20 @@ nm_connection_clear_secrets_with_flags (NMConnection *connection,
                                         NMSettingClearSecretsWithFlagsFn func,
                                         gpointer user_data)
 {
+	NMConnectionPrivate *priv;
 	GHashTableIter iter;
 	NMSetting *setting;
 
 	g_return_if_fail (NM_IS_CONNECTION (connection));
 
-	g_hash_table_iter_init (&iter, NM_CONNECTION_GET_PRIVATE (connection)->settings);
+	priv = NM_CONNECTION_GET_PRIVATE (connection);
+	g_return_if_fail (!priv->sealed);
+
+	g_hash_table_iter_init (&iter, priv->settings);
 	while (g_hash_table_iter_next (&iter, NULL, (gpointer) &setting)) {
 		g_signal_handlers_block_by_func (setting, (GCallback) setting_changed_cb, connection);
-		_nm_setting_clear_secrets_with_flags (setting, func, user_data);
+		if (_nm_setting_clear_secrets_with_flags (setting, func, user_data))
+			_snapshot_invalidate (priv, G_OBJECT_TYPE_NAME (setting));
 		g_signal_handlers_unblock_by_func (setting, (GCallback) setting_changed_cb, connection);
 	}
 
@@ -2038,8 +2209,18 @@ nm_connection_set_path (NMConnection *connection, const char *path)
 
 	priv = NM_CONNECTION_GET_PRIVATE (connection);
 
+	if (nm_streq0 (priv->path, path))
+		return;
+
 	g_free (priv->path);
 	priv->path = g_strdup (path);
+
+	/* the path is part of the snapshot, but the snapshotted settings
+	 * are still good. */
+	if (priv->snapshot) {
+		g_object_weak_unref (G_OBJECT (priv->snapshot), _snapshot_weak_notify, priv);
+		priv->snapshot = NULL;
+	}
 }
 
 /**
@@ -2860,11 +3041,12 @@ _nm_connection_get_setting_bluetooth_for_nap (NMConnection *connection)
 static void
 nm_connection_private_free (NMConnectionPrivate *priv)
 {
-	NMConnection *self = priv->self;
-
-	g_hash_table_foreach_remove (priv->settings, _setting_release, self);
+	g_hash_table_foreach_remove (priv->settings, _setting_release, priv);
 	g_hash_table_destroy (priv->settings);
 	g_free (priv->path);
+	_snapshot_invalidate (priv, NULL);
+	if (priv->snapshot_settings)
+		g_hash_table_destroy (priv->snapshot_settings);
 
 	g_slice_free (NMConnectionPrivate, priv);
 }
@@ -166,6 +166,9 @@ NMSettingVerifyResult _nm_connection_verify (NMConnection *connection, GError **
 
 gboolean _nm_connection_remove_setting (NMConnection *connection, GType setting_type);
 
+gboolean _nm_connection_is_sealed (NMConnection *connection);
+NMConnection *_nm_connection_get_snapshot (NMConnection *connection);
+
 NMConnection *_nm_simple_connection_new_from_dbus (GVariant      *dict,
                                                    NMSettingParseFlags parse_flags,
                                                    GError       **error);
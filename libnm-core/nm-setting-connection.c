@@ -63,9 +63,10 @@ typedef struct {
 	char *uuid;
 	char *stable_id;
 	char *interface_name;
-	char *type;
-	char *master;
-	char *slave_type;
+	/* type, master, slave_type and zone are interned, see _nm_intern_str_ref(). */
+	const char *type;
+	const char *master;
+	const char *slave_type;
 	NMSettingConnectionAutoconnectSlaves autoconnect_slaves;
 	GSList *permissions; /* list of Permission structs */
 	gboolean autoconnect;
@@ -74,7 +75,7 @@ typedef struct {
 	int multi_connect;
 	guint64 timestamp;
 	gboolean read_only;
-	char *zone;
+	const char *zone;
 	GSList *secondaries; /* secondary connections to activate with the base connection */
 	guint gateway_ping_timeout;
 	NMMetered metered;
@@ -1318,10 +1319,10 @@ finalize (GObject *object)
 	g_free (priv->uuid);
 	g_free (priv->stable_id);
 	g_free (priv->interface_name);
-	g_free (priv->type);
-	g_free (priv->zone);
-	g_free (priv->master);
-	g_free (priv->slave_type);
+	_nm_intern_str_unref (priv->type);
+	_nm_intern_str_unref (priv->zone);
+	_nm_intern_str_unref (priv->master);
+	_nm_intern_str_unref (priv->slave_type);
 	g_slist_free_full (priv->permissions, (GDestroyNotify) permission_free);
 	g_slist_free_full (priv->secondaries, g_free);
 
@@ -1372,8 +1373,8 @@ set_property (GObject *object, guint prop_id,
 		priv->interface_name = g_value_dup_string (value);
 		break;
 	case PROP_TYPE:
-		g_free (priv->type);
-		priv->type = g_value_dup_string (value);
+		_nm_intern_str_unref (priv->type);
+		priv->type = _nm_intern_str_ref (g_value_get_string (value));
 		break;
 	case PROP_PERMISSIONS:
 		g_slist_free_full (priv->permissions, (GDestroyNotify) permission_free);
@@ -1398,16 +1399,16 @@ set_property (GObject *object, guint prop_id,
 		priv->read_only = g_value_get_boolean (value);
 		break;
 	case PROP_ZONE:
-		g_free (priv->zone);
-		priv->zone = g_value_dup_string (value);
+		_nm_intern_str_unref (priv->zone);
+		priv->zone = _nm_intern_str_ref (g_value_get_string (value));
 		break;
 	case PROP_MASTER:
-		g_free (priv->master);
-		priv->master = g_value_dup_string (value);
+		_nm_intern_str_unref (priv->master);
+		priv->master = _nm_intern_str_ref (g_value_get_string (value));
 		break;
 	case PROP_SLAVE_TYPE:
-		g_free (priv->slave_type);
-		priv->slave_type = g_value_dup_string (value);
+		_nm_intern_str_unref (priv->slave_type);
+		priv->slave_type = _nm_intern_str_ref (g_value_get_string (value));
 		break;
 	case PROP_AUTOCONNECT_SLAVES:
 		priv->autoconnect_slaves = g_value_get_enum (value);
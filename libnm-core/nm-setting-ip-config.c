@@ -1387,7 +1387,7 @@ G_DEFINE_ABSTRACT_TYPE (NMSettingIPConfig, nm_setting_ip_config, NM_TYPE_SETTING
 #define NM_SETTING_IP_CONFIG_GET_PRIVATE(o) (G_TYPE_INSTANCE_GET_PRIVATE ((o), NM_TYPE_SETTING_IP_CONFIG, NMSettingIPConfigPrivate))
 
 typedef struct {
-	char *method;
+	const char *method;
 	GPtrArray *dns;        /* array of IP address strings */
 	GPtrArray *dns_search; /* array of domain name strings */
 	GPtrArray *dns_options;/* array of DNS options */
@@ -1657,7 +1657,7 @@ nm_setting_ip_config_add_dns_search (NMSettingIPConfig *setting,
 			return FALSE;
 	}
 
-	g_ptr_array_add (priv->dns_search, g_strdup (dns_search));
+	g_ptr_array_add (priv->dns_search, (gpointer) _nm_intern_str_ref (dns_search));
 	g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_DNS_SEARCH);
 	return TRUE;
 }
@@ -2660,7 +2660,7 @@ nm_setting_ip_config_init (NMSettingIPConfig *setting)
 	NMSettingIPConfigPrivate *priv = NM_SETTING_IP_CONFIG_GET_PRIVATE (setting);
 
 	priv->dns = g_ptr_array_new_with_free_func (g_free);
-	priv->dns_search = g_ptr_array_new_with_free_func (g_free);
+	priv->dns_search = g_ptr_array_new_with_free_func ((GDestroyNotify) _nm_intern_str_unref);
 	priv->dns_options = NULL;
 	priv->addresses = g_ptr_array_new_with_free_func ((GDestroyNotify) nm_ip_address_unref);
 	priv->routes = g_ptr_array_new_with_free_func ((GDestroyNotify) nm_ip_route_unref);
@@ -2672,7 +2672,7 @@ finalize (GObject *object)
 	NMSettingIPConfig *self = NM_SETTING_IP_CONFIG (object);
 	NMSettingIPConfigPrivate *priv = NM_SETTING_IP_CONFIG_GET_PRIVATE (self);
 
-	g_free (priv->method);
+	_nm_intern_str_unref (priv->method);
 	g_free (priv->gateway);
 	g_free (priv->dhcp_hostname);
 
@@ -2698,16 +2698,18 @@ set_property (GObject *object, guint prop_id,
 
 	switch (prop_id) {
 	case PROP_METHOD:
-		g_free (priv->method);
-		priv->method = g_value_dup_string (value);
+		_nm_intern_str_unref (priv->method);
+		priv->method = _nm_intern_str_ref (g_value_get_string (value));
 		break;
 	case PROP_DNS:
 		g_ptr_array_unref (priv->dns);
 		priv->dns = _nm_utils_strv_to_ptrarray (g_value_get_boxed (value));
 		break;
 	case PROP_DNS_SEARCH:
-		g_ptr_array_unref (priv->dns_search);
-		priv->dns_search = _nm_utils_strv_to_ptrarray (g_value_get_boxed (value));
+		g_ptr_array_set_size (priv->dns_search, 0);
+		strv = g_value_get_boxed (value);
+		for (i = 0; strv && strv[i]; i++)
+			g_ptr_array_add (priv->dns_search, (gpointer) _nm_intern_str_ref (strv[i]));
 		break;
 	case PROP_DNS_OPTIONS:
 		strv = g_value_get_boxed (value);
@@ -2905,6 +2907,9 @@ nm_setting_ip_config_class_init (NMSettingIPConfigClass *klass)
 	object_class->get_property = get_property;
 	object_class->finalize     = finalize;
 
+	/* NMSettingIPConfig is abstract and doesn't call _nm_setting_class_commit(). */
+	_nm_setting_class_check_sealed (setting_class);
+
 	setting_class->verify           = verify;
 	setting_class->compare_property = compare_property;
 
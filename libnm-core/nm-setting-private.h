@@ -49,6 +49,9 @@ NMSettingUpdateSecretResult _nm_setting_update_secrets (NMSetting *setting,
                                                         GVariant *secrets,
                                                         GError **error);
 gboolean _nm_setting_clear_secrets (NMSetting *setting);
+
+void _nm_setting_seal (NMSetting *setting);
+void _nm_setting_class_check_sealed (NMSettingClass *setting_class);
 gboolean _nm_setting_clear_secrets_with_flags (NMSetting *setting,
                                                NMSettingClearSecretsWithFlagsFn func,
                                                gpointer user_data);
@@ -49,7 +49,7 @@ typedef struct {
 	guint32 speed;
 	char *duplex;
 	gboolean auto_negotiate;
-	char *device_mac_address;
+	const char *device_mac_address;
 	char *cloned_mac_address;
 	char *generate_mac_address_mask;
 	GArray *mac_address_blacklist;
@@ -829,7 +829,7 @@ finalize (GObject *object)
 
 	g_hash_table_destroy (priv->s390_options);
 
-	g_free (priv->device_mac_address);
+	_nm_intern_str_unref (priv->device_mac_address);
 	g_free (priv->cloned_mac_address);
 	g_free (priv->generate_mac_address_mask);
 	g_array_unref (priv->mac_address_blacklist);
@@ -867,9 +867,9 @@ set_property (GObject *object, guint prop_id,
 		priv->auto_negotiate = g_value_get_boolean (value);
 		break;
 	case PROP_MAC_ADDRESS:
-		g_free (priv->device_mac_address);
-		priv->device_mac_address = _nm_utils_hwaddr_canonical_or_invalid (g_value_get_string (value),
-		                                                                  ETH_ALEN);
+		_nm_intern_str_unref (priv->device_mac_address);
+		priv->device_mac_address = _nm_intern_str_take (_nm_utils_hwaddr_canonical_or_invalid (g_value_get_string (value),
+		                                                                                       ETH_ALEN));
 		break;
 	case PROP_CLONED_MAC_ADDRESS:
 		g_free (priv->cloned_mac_address);
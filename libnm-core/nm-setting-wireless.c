@@ -52,7 +52,7 @@ typedef struct {
 	char *bssid;
 	guint32 rate;
 	guint32 tx_power;
-	char *device_mac_address;
+	const char *device_mac_address;
 	char *cloned_mac_address;
 	char *generate_mac_address_mask;
 	GArray *mac_address_blacklist;
@@ -1001,10 +1001,9 @@ finalize (GObject *object)
 	g_free (priv->mode);
 	g_free (priv->band);
 
-	if (priv->ssid)
-		g_bytes_unref (priv->ssid);
+	_nm_intern_bytes_unref (priv->ssid);
 	g_free (priv->bssid);
-	g_free (priv->device_mac_address);
+	_nm_intern_str_unref (priv->device_mac_address);
 	g_free (priv->cloned_mac_address);
 	g_free (priv->generate_mac_address_mask);
 	g_array_unref (priv->mac_address_blacklist);
@@ -1025,9 +1024,8 @@ set_property (GObject *object, guint prop_id,
 
 	switch (prop_id) {
 	case PROP_SSID:
-		if (priv->ssid)
-			g_bytes_unref (priv->ssid);
-		priv->ssid = g_value_dup_boxed (value);
+		_nm_intern_bytes_unref (priv->ssid);
+		priv->ssid = _nm_intern_bytes_ref (g_value_get_boxed (value));
 		break;
 	case PROP_MODE:
 		g_free (priv->mode);
@@ -1051,9 +1049,9 @@ set_property (GObject *object, guint prop_id,
 		priv->tx_power = g_value_get_uint (value);
 		break;
 	case PROP_MAC_ADDRESS:
-		g_free (priv->device_mac_address);
-		priv->device_mac_address = _nm_utils_hwaddr_canonical_or_invalid (g_value_get_string (value),
-		                                                                  ETH_ALEN);
+		_nm_intern_str_unref (priv->device_mac_address);
+		priv->device_mac_address = _nm_intern_str_take (_nm_utils_hwaddr_canonical_or_invalid (g_value_get_string (value),
+		                                                                                       ETH_ALEN));
 		break;
 	case PROP_CLONED_MAC_ADDRESS:
 		bool_val = !!priv->cloned_mac_address;
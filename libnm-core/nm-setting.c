@@ -76,6 +76,14 @@ enum {
 
 typedef struct {
 	GenData *gendata;
+
+	/* a sealed setting is shared between snapshots of a connection
+	 * (see _nm_connection_get_snapshot()) and must not be modified. */
+	bool sealed:1;
+
+	/* a property change of the sealed setting was refused. Suppress
+	 * the following notification, as nothing changed. */
+	bool sealed_set_refused:1;
 } NMSettingPrivate;
 
 G_DEFINE_ABSTRACT_TYPE (NMSetting, nm_setting, G_TYPE_OBJECT)
@@ -369,6 +377,8 @@ _nm_setting_class_commit_full (NMSettingClass *setting_class,
 
 	nm_assert (meta_type < G_N_ELEMENTS (_sett_info_settings));
 
+	_nm_setting_class_check_sealed (setting_class);
+
 	sett_info = &_sett_info_settings[meta_type];
 
 	nm_assert (!sett_info->setting_class);
@@ -1131,6 +1141,89 @@ _nm_setting_verify_secret_string (const char *str,
 	return TRUE;
 }
 
+static gboolean
+_property_compare_fast_type (GType value_type)
+{
+	switch (G_TYPE_FUNDAMENTAL (value_type)) {
+	case G_TYPE_BOOLEAN:
+	case G_TYPE_CHAR:
+	case G_TYPE_UCHAR:
+	case G_TYPE_INT:
+	case G_TYPE_UINT:
+	case G_TYPE_INT64:
+	case G_TYPE_UINT64:
+	case G_TYPE_ENUM:
+	case G_TYPE_FLAGS:
+	case G_TYPE_STRING:
+		return TRUE;
+	default:
+		return    value_type == G_TYPE_BYTES
+		       || value_type == G_TYPE_STRV;
+	}
+}
+
+/* Compares the property values directly as GValue, without converting them
+ * to GVariant first. This is only done for properties that have no custom
+ * D-Bus conversion, so that the result is identical to comparing the D-Bus
+ * representation with nm_property_compare(). Note that for the comparison
+ * of the D-Bus representation, a default value is omitted, and a %NULL
+ * string serializes to "". */
+static gboolean
+_property_compare_fast (NMSetting *setting,
+                        NMSetting *other,
+                        const GParamSpec *prop_spec)
+{
+	GValue value1 = G_VALUE_INIT;
+	GValue value2 = G_VALUE_INIT;
+	gboolean is_default1, is_default2;
+	gboolean same;
+
+	g_value_init (&value1, prop_spec->value_type);
+	g_value_init (&value2, prop_spec->value_type);
+	g_object_get_property (G_OBJECT (setting), prop_spec->name, &value1);
+	g_object_get_property (G_OBJECT (other), prop_spec->name, &value2);
+
+	is_default1 = g_param_value_defaults ((GParamSpec *) prop_spec, &value1);
+	is_default2 = g_param_value_defaults ((GParamSpec *) prop_spec, &value2);
+
+	if (is_default1 || is_default2)
+		same = is_default1 && is_default2;
+	else if (G_TYPE_FUNDAMENTAL (prop_spec->value_type) == G_TYPE_STRING) {
+		same = nm_streq (g_value_get_string (&value1) ?: "",
+		                 g_value_get_string (&value2) ?: "");
+	} else if (prop_spec->value_type == G_TYPE_BYTES) {
+		GBytes *b1 = g_value_get_boxed (&value1);
+		GBytes *b2 = g_value_get_boxed (&value2);
+
+		/* interned values (see _nm_intern_bytes_ref()) are pointer-equal. */
+		if (b1 == b2)
+			same = TRUE;
+		else if (!b1 || !b2)
+			same = FALSE;
+		else
+			same = g_bytes_equal (b1, b2);
+	} else if (prop_spec->value_type == G_TYPE_STRV) {
+		const char *const*strv1 = g_value_get_boxed (&value1);
+		const char *const*strv2 = g_value_get_boxed (&value2);
+		gsize i;
+
+		if (!strv1 || !strv2)
+			same = (strv1 == strv2);
+		else {
+			for (i = 0; strv1[i] && strv2[i]; i++) {
+				if (!nm_streq (strv1[i], strv2[i]))
+					break;
+			}
+			same = !strv1[i] && !strv2[i];
+		}
+	} else
+		same = (g_param_values_cmp ((GParamSpec *) prop_spec, &value1, &value2) == 0);
+
+	g_value_unset (&value1);
+	g_value_unset (&value2);
+	return same;
+}
+
 static gboolean
 compare_property (NMSetting *setting,
                   NMSetting *other,
@@ -1172,6 +1265,11 @@ compare_property (NMSetting *setting,
 	property = _nm_sett_info_property_get (NM_SETTING_GET_CLASS (setting), prop_spec->name);
 	g_return_val_if_fail (property != NULL, FALSE);
 
+	if (   !property->get_func
+	    && !property->to_dbus
+	    && _property_compare_fast_type (prop_spec->value_type))
+		return _property_compare_fast (setting, other, prop_spec);
+
 	value1 = get_property_for_dbus (setting, property, TRUE);
 	value2 = get_property_for_dbus (other, property, TRUE);
 
@@ -1203,8 +1301,6 @@ nm_setting_compare (NMSetting *a,
                     NMSettingCompareFlags flags)
 {
 	const NMSettInfoSetting *sett_info;
-	GParamSpec **property_specs;
-	guint n_property_specs;
 	int same = TRUE;
 	guint i;
 
@@ -1227,10 +1323,14 @@ nm_setting_compare (NMSetting *a,
 		                                  g_variant_equal);
 	}
 
-	/* And now all properties */
-	property_specs = g_object_class_list_properties (G_OBJECT_GET_CLASS (a), &n_property_specs);
-	for (i = 0; i < n_property_specs && same; i++) {
-		GParamSpec *prop_spec = property_specs[i];
+	/* And now all properties. Iterate over the property infos of the setting class,
+	 * which are prepared once by _nm_setting_class_commit(). Entries without
+	 * a param-spec are D-Bus only properties, they are not compared. */
+	for (i = 0; i < sett_info->property_infos_len && same; i++) {
+		GParamSpec *prop_spec = sett_info->property_infos[i].param_spec;
+
+		if (!prop_spec)
+			continue;
 
 		/* Fuzzy compare ignores secrets and properties defined with the FUZZY_IGNORE flag */
 		if (   NM_FLAGS_HAS (flags, NM_SETTING_COMPARE_FLAG_FUZZY)
@@ -1251,7 +1351,6 @@ nm_setting_compare (NMSetting *a,
 
 		same = NM_SETTING_GET_CLASS (a)->compare_property (a, b, prop_spec, flags);
 	}
-	g_free (property_specs);
 
 	return same;
 }
@@ -1442,15 +1541,13 @@ nm_setting_diff (NMSetting *a,
 			}
 		}
 	} else {
-		gs_free GParamSpec **property_specs = NULL;
-		guint n_property_specs;
-
-		property_specs = g_object_class_list_properties (G_OBJECT_GET_CLASS (a), &n_property_specs);
-
-		for (i = 0; i < n_property_specs; i++) {
-			GParamSpec *prop_spec = property_specs[i];
+		for (i = 0; i < sett_info->property_infos_len; i++) {
+			GParamSpec *prop_spec = sett_info->property_infos[i].param_spec;
 			NMSettingDiffResult r = NM_SETTING_DIFF_RESULT_UNKNOWN;
 
+			if (!prop_spec)
+				continue;
+
 			/* Handle compare flags */
 			if (!should_compare_prop (a, prop_spec->name, flags, prop_spec->flags))
 				continue;
@@ -2317,6 +2414,98 @@ get_property (GObject *object, guint prop_id,
 	}
 }
 
+/**
+ * _nm_setting_seal:
+ * @setting: the #NMSetting
+ *
+ * Marks @setting as immutable. Once sealed, a setting can be shared
+ * between connections without copying it. Setting properties of a
+ * sealed setting is refused. Modifying it otherwise is a bug.
+ */
+void
+_nm_setting_seal (NMSetting *setting)
+{
+	g_return_if_fail (NM_IS_SETTING (setting));
+
+	NM_SETTING_GET_PRIVATE (setting)->sealed = TRUE;
+}
+
+static void
+_set_property_check_sealed (GObject *object,
+                            guint prop_id,
+                            const GValue *value,
+                            GParamSpec *pspec)
+{
+	NMSettingPrivate *priv = NM_SETTING_GET_PRIVATE (object);
+	GObjectSetPropertyFunc set_property;
+	GType gtype;
+
+	if (priv->sealed) {
+		priv->sealed_set_refused = TRUE;
+		g_critical ("%s: refuse to set property \"%s\" of sealed setting %s",
+		            G_STRLOC,
+		            pspec->name,
+		            G_OBJECT_TYPE_NAME (object));
+		return;
+	}
+
+	/* the class that owns the property is usually the class whose set_property
+	 * function got replaced. Otherwise, it inherited it from a parent class. */
+	for (gtype = pspec->owner_type; gtype; gtype = g_type_parent (gtype)) {
+		set_property = g_type_get_qdata (gtype, NM_CACHED_QUARK ("nm-setting-set-property"));
+		if (set_property) {
+			set_property (object, prop_id, value, pspec);
+			return;
+		}
+	}
+	g_return_if_reached ();
+}
+
+/**
+ * _nm_setting_class_check_sealed:
+ * @setting_class: the #NMSettingClass
+ *
+ * Wraps the set_property() function of @setting_class, so that properties
+ * of sealed settings cannot be changed. Must be called after set_property()
+ * is assigned in the class_init() function of every setting class that
+ * has writable properties.
+ */
+void
+_nm_setting_class_check_sealed (NMSettingClass *setting_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (setting_class);
+
+	if (   !object_class->set_property
+	    || object_class->set_property == _set_property_check_sealed)
+		return;
+
+	g_type_set_qdata (G_TYPE_FROM_CLASS (setting_class),
+	                  NM_CACHED_QUARK ("nm-setting-set-property"),
+	                  object_class->set_property);
+	object_class->set_property = _set_property_check_sealed;
+}
+
+static void
+dispatch_properties_changed (GObject *object,
+                             guint n_pspecs,
+                             GParamSpec **pspecs)
+{
+	NMSettingPrivate *priv = NM_SETTING_GET_PRIVATE (object);
+
+	if (priv->sealed) {
+		if (priv->sealed_set_refused) {
+			priv->sealed_set_refused = FALSE;
+			return;
+		}
+		g_critical ("%s: property \"%s\" of sealed setting %s was modified",
+		            G_STRLOC,
+		            pspecs[0]->name,
+		            G_OBJECT_TYPE_NAME (object));
+	}
+
+	G_OBJECT_CLASS (nm_setting_parent_class)->dispatch_properties_changed (object, n_pspecs, pspecs);
+}
+
 static void
 finalize (GObject *object)
 {
@@ -2354,8 +2543,9 @@ nm_setting_class_init (NMSettingClass *setting_class)
 
 	g_type_class_add_private (setting_class, sizeof (NMSettingPrivate));
 
-	object_class->get_property = get_property;
-	object_class->finalize     = finalize;
+	object_class->get_property                = get_property;
+	object_class->dispatch_properties_changed = dispatch_properties_changed;
+	object_class->finalize                    = finalize;
 
 	setting_class->update_one_secret = update_one_secret;
 	setting_class->get_secret_flags = get_secret_flags;
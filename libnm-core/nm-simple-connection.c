@@ -137,7 +137,10 @@ nm_simple_connection_new_clone (NMConnection *connection)
 static void
 dispose (GObject *object)
 {
-	nm_connection_clear_secrets (NM_CONNECTION (object));
+	/* snapshots share their settings and have no secrets of their own
+	 * to clear. */
+	if (!_nm_connection_is_sealed (NM_CONNECTION (object)))
+		nm_connection_clear_secrets (NM_CONNECTION (object));
 
 	G_OBJECT_CLASS (nm_simple_connection_parent_class)->dispose (object);
 }
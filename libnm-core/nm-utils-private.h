@@ -79,6 +79,13 @@ void        _nm_utils_bytes_from_dbus   (GVariant *dbus_value,
 
 char *      _nm_utils_hwaddr_canonical_or_invalid (const char *mac, gssize length);
 
+const char *_nm_intern_str_ref   (const char *str);
+const char *_nm_intern_str_take  (char *str);
+void        _nm_intern_str_unref (const char *str);
+
+GBytes *    _nm_intern_bytes_ref   (GBytes *bytes);
+void        _nm_intern_bytes_unref (GBytes *bytes);
+
 GPtrArray * _nm_utils_team_link_watchers_from_variant (GVariant *value);
 GVariant *  _nm_utils_team_link_watchers_to_variant (GPtrArray *link_watchers);
 
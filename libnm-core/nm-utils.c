@@ -6332,3 +6332,174 @@ nm_utils_version (void)
 	return NM_VERSION;
 }
 
+
+/*****************************************************************************/
+
+/* A process-wide pool of reference counted strings and GBytes. Many
+ * connection profiles repeat the same values (the connection type,
+ * the IP method, zones, DNS search domains, MAC addresses, SSIDs).
+ * Settings intern such properties, so that all profiles share one
+ * instance of each value. */
+
+typedef struct {
+	guint ref_count;
+	char str[];
+} InternStr;
+
+typedef struct {
+	GBytes *bytes;
+	guint ref_count;
+} InternBytes;
+
+G_LOCK_DEFINE_STATIC (intern_pool);
+
+static GHashTable *intern_str_pool;
+static GHashTable *intern_bytes_pool;
+
+/**
+ * _nm_intern_str_ref:
+ * @str: (allow-none): the string to intern
+ *
+ * Returns: (transfer full): a shared copy of @str, or %NULL if @str is %NULL.
+ *   Release it with _nm_intern_str_unref(), not g_free().
+ */
+const char *
+_nm_intern_str_ref (const char *str)
+{
+	InternStr *entry;
+	gsize len;
+
+	if (!str)
+		return NULL;
+
+	G_LOCK (intern_pool);
+
+	if (G_UNLIKELY (!intern_str_pool))
+		intern_str_pool = g_hash_table_new (nm_str_hash, g_str_equal);
+
+	entry = g_hash_table_lookup (intern_str_pool, str);
+	if (entry) {
+		nm_assert (entry->ref_count > 0);
+		entry->ref_count++;
+	} else {
+		len = strlen (str) + 1;
+		entry = g_malloc (G_STRUCT_OFFSET (InternStr, str) + len);
+		entry->ref_count = 1;
+		memcpy (entry->str, str, len);
+		g_hash_table_add (intern_str_pool, entry->str);
+	}
+
+	G_UNLOCK (intern_pool);
+
+	return entry->str;
+}
+
+/**
+ * _nm_intern_str_take:
+ * @str: (allow-none) (transfer full): the string to intern
+ *
+ * Like _nm_intern_str_ref(), but frees @str.
+ *
+ * Returns: (transfer full): a shared copy of @str.
+ */
+const char *
+_nm_intern_str_take (char *str)
+{
+	const char *s;
+
+	s = _nm_intern_str_ref (str);
+	g_free (str);
+	return s;
+}
+
+/**
+ * _nm_intern_str_unref:
+ * @str: (allow-none): a string returned by _nm_intern_str_ref()
+ */
+void
+_nm_intern_str_unref (const char *str)
+{
+	InternStr *entry;
+
+	if (!str)
+		return;
+
+	entry = (InternStr *) (str - G_STRUCT_OFFSET (InternStr, str));
+
+	G_LOCK (intern_pool);
+
+	nm_assert (entry->ref_count > 0);
+	nm_assert (g_hash_table_lookup (intern_str_pool, str) == str);
+
+	if (--entry->ref_count == 0) {
+		g_hash_table_remove (intern_str_pool, entry->str);
+		g_free (entry);
+	}
+
+	G_UNLOCK (intern_pool);
+}
+
+/**
+ * _nm_intern_bytes_ref:
+ * @bytes: (allow-none): the #GBytes to intern
+ *
+ * Returns: (transfer full): a #GBytes with the same content as @bytes,
+ *   shared with all other users of the pool. Release it with
+ *   _nm_intern_bytes_unref().
+ */
+GBytes *
+_nm_intern_bytes_ref (GBytes *bytes)
+{
+	InternBytes *entry;
+
+	if (!bytes)
+		return NULL;
+
+	G_LOCK (intern_pool);
+
+	if (G_UNLIKELY (!intern_bytes_pool))
+		intern_bytes_pool = g_hash_table_new (g_bytes_hash, g_bytes_equal);
+
+	entry = g_hash_table_lookup (intern_bytes_pool, bytes);
+	if (entry) {
+		nm_assert (entry->ref_count > 0);
+		entry->ref_count++;
+	} else {
+		entry = g_slice_new (InternBytes);
+		entry->bytes = g_bytes_ref (bytes);
+		entry->ref_count = 1;
+		g_hash_table_insert (intern_bytes_pool, entry->bytes, entry);
+	}
+
+	G_UNLOCK (intern_pool);
+
+	return g_bytes_ref (entry->bytes);
+}
+
+/**
+ * _nm_intern_bytes_unref:
+ * @bytes: (allow-none): a #GBytes returned by _nm_intern_bytes_ref()
+ */
+void
+_nm_intern_bytes_unref (GBytes *bytes)
+{
+	InternBytes *entry;
+
+	if (!bytes)
+		return;
+
+	G_LOCK (intern_pool);
+
+	entry = g_hash_table_lookup (intern_bytes_pool, bytes);
+	nm_assert (entry && entry->bytes == bytes && entry->ref_count > 0);
+
+	if (--entry->ref_count == 0) {
+		g_hash_table_remove (intern_bytes_pool, entry->bytes);
+		g_bytes_unref (entry->bytes);
+		g_slice_free (InternBytes, entry);
+	}
+
+	G_UNLOCK (intern_pool);
+
+	g_bytes_unref (bytes);
+}
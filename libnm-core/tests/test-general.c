@@ -3247,6 +3247,167 @@ test_setting_compare_timestamp (void)
 	g_assert (success);
 }
 
+static void
+test_setting_compare_simple_types (void)
+{
+	gs_unref_object NMSetting *s_con1 = NULL, *s_con2 = NULL;
+	gs_unref_object NMSetting *s_wifi1 = NULL, *s_wifi2 = NULL;
+	gs_unref_bytes GBytes *ssid1 = NULL, *ssid2 = NULL;
+	GHashTable *result = NULL;
+
+	s_con1 = nm_setting_connection_new ();
+	s_con2 = nm_setting_connection_new ();
+	g_assert (nm_setting_compare (s_con1, s_con2, NM_SETTING_COMPARE_FLAG_EXACT));
+
+	/* a %NULL string and "" are not the same. */
+	g_object_set (s_con2, NM_SETTING_CONNECTION_ZONE, "", NULL);
+	g_assert (!nm_setting_compare (s_con1, s_con2, NM_SETTING_COMPARE_FLAG_EXACT));
+	g_assert (!nm_setting_diff (s_con1, s_con2, NM_SETTING_COMPARE_FLAG_EXACT, FALSE, &result));
+	g_assert (g_hash_table_contains (result, NM_SETTING_CONNECTION_ZONE));
+	g_clear_pointer (&result, g_hash_table_unref);
+
+	g_object_set (s_con1, NM_SETTING_CONNECTION_ZONE, "", NULL);
+	g_assert (nm_setting_compare (s_con1, s_con2, NM_SETTING_COMPARE_FLAG_EXACT));
+
+	g_object_set (s_con2, NM_SETTING_CONNECTION_AUTOCONNECT_PRIORITY, 5, NULL);
+	g_assert (!nm_setting_compare (s_con1, s_con2, NM_SETTING_COMPARE_FLAG_EXACT));
+	g_object_set (s_con1, NM_SETTING_CONNECTION_AUTOCONNECT_PRIORITY, 5, NULL);
+	g_assert (nm_setting_compare (s_con1, s_con2, NM_SETTING_COMPARE_FLAG_EXACT));
+
+	/* GBytes are compared by content. */
+	s_wifi1 = nm_setting_wireless_new ();
+	s_wifi2 = nm_setting_wireless_new ();
+	ssid1 = g_bytes_new ("ssid", 4);
+	ssid2 = g_bytes_new ("ssid", 4);
+	g_object_set (s_wifi1, NM_SETTING_WIRELESS_SSID, ssid1, NULL);
+	g_assert (!nm_setting_compare (s_wifi1, s_wifi2, NM_SETTING_COMPARE_FLAG_EXACT));
+	g_object_set (s_wifi2, NM_SETTING_WIRELESS_SSID, ssid2, NULL);
+	g_assert (nm_setting_compare (s_wifi1, s_wifi2, NM_SETTING_COMPARE_FLAG_EXACT));
+	g_assert (nm_setting_diff (s_wifi1, s_wifi2, NM_SETTING_COMPARE_FLAG_EXACT, FALSE, &result));
+	g_assert (!result);
+}
+
+static void
+test_setting_interned_values (void)
+{
+	gs_unref_object NMConnection *con1 = NULL;
+	gs_unref_object NMConnection *con2 = NULL;
+	NMSettingConnection *s_con1, *s_con2;
+	NMSettingWireless *s_wifi1, *s_wifi2;
+	NMSettingIPConfig *s_ip4;
+	gs_unref_bytes GBytes *ssid1 = NULL;
+	gs_unref_bytes GBytes *ssid2 = NULL;
+	gs_free char *type = NULL;
+
+	con1 = nmtst_create_minimal_connection ("intern 1", NULL, NM_SETTING_WIRELESS_SETTING_NAME, &s_con1);
+	con2 = nmtst_create_minimal_connection ("intern 2", NULL, NM_SETTING_WIRELESS_SETTING_NAME, &s_con2);
+
+	g_assert_cmpstr (nm_setting_connection_get_connection_type (s_con1), ==, NM_SETTING_WIRELESS_SETTING_NAME);
+	g_assert (nm_setting_connection_get_connection_type (s_con1) == nm_setting_connection_get_connection_type (s_con2));
+
+	ssid1 = g_bytes_new ("test", 4);
+	ssid2 = g_bytes_new ("test", 4);
+	s_wifi1 = nm_connection_get_setting_wireless (con1);
+	s_wifi2 = nm_connection_get_setting_wireless (con2);
+	g_object_set (s_wifi1,
+	              NM_SETTING_WIRELESS_SSID, ssid1,
+	              NM_SETTING_WIRELESS_MAC_ADDRESS, "00:11:22:33:44:55",
+	              NULL);
+	g_object_set (s_wifi2,
+	              NM_SETTING_WIRELESS_SSID, ssid2,
+	              NM_SETTING_WIRELESS_MAC_ADDRESS, "00:11:22:33:44:55",
+	              NULL);
+	g_assert (nm_setting_wireless_get_ssid (s_wifi1) == nm_setting_wireless_get_ssid (s_wifi2));
+	g_assert (nm_setting_wireless_get_mac_address (s_wifi1) == nm_setting_wireless_get_mac_address (s_wifi2));
+
+	s_ip4 = (NMSettingIPConfig *) nm_setting_ip4_config_new ();
+	nm_connection_add_setting (con1, (NMSetting *) s_ip4);
+	g_object_set (s_ip4,
+	              NM_SETTING_IP_CONFIG_METHOD, NM_SETTING_IP4_CONFIG_METHOD_AUTO,
+	              NULL);
+	nm_setting_ip_config_add_dns_search (s_ip4, "example.com");
+	nm_setting_ip_config_add_dns_search (s_ip4, "example.org");
+	nm_setting_ip_config_remove_dns_search (s_ip4, 0);
+	g_assert_cmpint (nm_setting_ip_config_get_num_dns_searches (s_ip4), ==, 1);
+	g_assert_cmpstr (nm_setting_ip_config_get_dns_search (s_ip4, 0), ==, "example.org");
+
+	/* the remaining users keep the value alive. */
+	type = g_strdup (nm_setting_connection_get_connection_type (s_con2));
+	g_object_set (s_con1, NM_SETTING_CONNECTION_TYPE, NM_SETTING_WIRED_SETTING_NAME, NULL);
+	g_clear_object (&con1);
+	g_assert_cmpstr (nm_setting_connection_get_connection_type (s_con2), ==, type);
+	g_assert (nm_utils_gbytes_equal_mem (nm_setting_wireless_get_ssid (s_wifi2), "test", 4));
+}
+
+static void
+test_connection_snapshot (void)
+{
+	gs_unref_object NMConnection *con = NULL;
+	gs_unref_object NMConnection *snap1 = NULL;
+	gs_unref_object NMConnection *snap2 = NULL;
+	gs_unref_object NMConnection *snap3 = NULL;
+	NMSettingConnection *s_con;
+	NMSettingWired *s_wired;
+
+	con = nmtst_create_minimal_connection ("snapshot test", NULL, NM_SETTING_WIRED_SETTING_NAME, &s_con);
+	nmtst_connection_normalize (con);
+
+	snap1 = _nm_connection_get_snapshot (con);
+	g_assert (_nm_connection_is_sealed (snap1));
+	g_assert (!_nm_connection_is_sealed (con));
+	g_assert (nm_connection_compare (con, snap1, NM_SETTING_COMPARE_FLAG_EXACT));
+	g_assert (nm_connection_get_setting_connection (snap1) != s_con);
+
+	/* unchanged connection: the snapshot is reused. */
+	snap2 = _nm_connection_get_snapshot (con);
+	g_assert (snap1 == snap2);
+	g_clear_object (&snap2);
+
+	/* a snapshot of a snapshot is the snapshot itself. */
+	snap2 = _nm_connection_get_snapshot (snap1);
+	g_assert (snap1 == snap2);
+	g_clear_object (&snap2);
+
+	g_object_set (s_con, NM_SETTING_CONNECTION_ID, "snapshot test 2", NULL);
+
+	/* only the modified setting is copied again. */
+	snap3 = _nm_connection_get_snapshot (con);
+	g_assert (snap3 != snap1);
+	g_assert (nm_connection_compare (con, snap3, NM_SETTING_COMPARE_FLAG_EXACT));
+	g_assert (!nm_connection_compare (snap1, snap3, NM_SETTING_COMPARE_FLAG_EXACT));
+	g_assert_cmpstr (nm_connection_get_id (snap1), ==, "snapshot test");
+	g_assert_cmpstr (nm_connection_get_id (snap3), ==, "snapshot test 2");
+	g_assert (nm_connection_get_setting_connection (snap1) != nm_connection_get_setting_connection (snap3));
+	g_assert (nm_connection_get_setting_wired (snap1) == nm_connection_get_setting_wired (snap3));
+
+	/* sealed settings refuse modification. */
+	NMTST_EXPECT_LIBNM_CRITICAL ("*refuse to set property \"id\" of sealed setting*");
+	g_object_set (nm_connection_get_setting_connection (snap3),
+	              NM_SETTING_CONNECTION_ID, "snapshot test 3",
+	              NULL);
+	g_test_assert_expected_messages ();
+	g_assert_cmpstr (nm_connection_get_id (snap3), ==, "snapshot test 2");
+
+	/* the source connection doesn't keep the sealed settings alive. */
+	s_wired = nm_connection_get_setting_wired (snap1);
+	g_object_add_weak_pointer (G_OBJECT (s_wired), (gpointer *) &s_wired);
+	g_clear_object (&snap1);
+	g_assert (s_wired);
+	g_clear_object (&snap3);
+	g_assert (!s_wired);
+
+	/* ... and a new snapshot duplicates the settings again. */
+	snap1 = _nm_connection_get_snapshot (con);
+	g_assert (nm_connection_compare (con, snap1, NM_SETTING_COMPARE_FLAG_EXACT));
+	snap3 = _nm_connection_get_snapshot (con);
+	g_assert (snap1 == snap3);
+	g_clear_object (&snap3);
+
+	/* the snapshots survive the source connection. */
+	g_clear_object (&con);
+	g_assert_cmpstr (nm_connection_get_id (snap1), ==, "snapshot test 2");
+}
+
 typedef struct {
 	NMSettingSecretFlags secret_flags;
 	NMSettingCompareFlags comp_flags;
@@ -7266,6 +7427,9 @@ int main (int argc, char **argv)
 	g_test_add_func ("/core/general/test_setting_compare_wired_cloned_mac_address", test_setting_compare_wired_cloned_mac_address);
 	g_test_add_func ("/core/general/test_setting_compare_wirless_cloned_mac_address", test_setting_compare_wireless_cloned_mac_address);
 	g_test_add_func ("/core/general/test_setting_compare_timestamp", test_setting_compare_timestamp);
+	g_test_add_func ("/core/general/test_setting_compare_simple_types", test_setting_compare_simple_types);
+	g_test_add_func ("/core/general/test_setting_interned_values", test_setting_interned_values);
+	g_test_add_func ("/core/general/test_connection_snapshot", test_connection_snapshot);
 #define ADD_FUNC(name, func, secret_flags, comp_flags, remove_secret) \
 	g_test_add_data_func_full ("/core/general/" G_STRINGIFY (func) "_" name, \
 	                           test_data_compare_secrets_new (secret_flags, comp_flags, remove_secret), \
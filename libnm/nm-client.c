@@ -602,6 +602,34 @@ nm_client_set_logging (NMClient *client, const char *level, const char *domains,
 	                               level, domains, error);
 }
 
+/**
+ * nm_client_dump_logging:
+ * @client: a #NMClient
+ * @error: (allow-none): return location for a #GError, or %NULL
+ *
+ * Gets the content of NetworkManager's in-memory trace buffer. If enabled
+ * in NetworkManager.conf, NetworkManager records the most recent TRACE
+ * messages of some logging domains there, regardless of the configured
+ * logging level.
+ *
+ * Returns: (transfer full): a %NULL terminated array of log messages,
+ *   oldest first, or %NULL on failure.
+ *
+ * Since: 1.16
+ **/
+char **
+nm_client_dump_logging (NMClient *client, GError **error)
+{
+	g_return_val_if_fail (NM_IS_CLIENT (client), NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	if (!_nm_client_check_nm_running (client, error))
+		return NULL;
+
+	return nm_manager_dump_logging (NM_CLIENT_GET_PRIVATE (client)->manager,
+	                                error);
+}
+
 /**
  * nm_client_get_permission_result:
  * @client: a #NMClient
@@ -1578,6 +1606,103 @@ nm_client_add_connection_finish (NMClient *client,
 		return g_object_ref (g_simple_async_result_get_op_res_gpointer (simple));
 }
 
+static void
+add_connections_cb (GObject *object,
+                    GAsyncResult *result,
+                    gpointer user_data)
+{
+	GSimpleAsyncResult *simple = user_data;
+	GPtrArray *connections;
+	GError *error = NULL;
+
+	connections = nm_remote_settings_add_connections_finish (NM_REMOTE_SETTINGS (object), result, &error);
+	if (connections)
+		g_simple_async_result_set_op_res_gpointer (simple, connections, (GDestroyNotify) g_ptr_array_unref);
+	else
+		g_simple_async_result_take_error (simple, error);
+
+	g_simple_async_result_complete (simple);
+	g_object_unref (simple);
+}
+
+/**
+ * nm_client_add_connections_async:
+ * @client: the %NMClient
+ * @connections: (element-type NMConnection): the connections to add. Note
+ *   that the settings of these objects will be added, not the objects themselves
+ * @cancellable: a #GCancellable, or %NULL
+ * @callback: (scope async): callback to be called when the add operation completes
+ * @user_data: (closure): caller-specific data passed to @callback
+ *
+ * Requests that the remote settings service add all the given settings as
+ * new connections and save them to disk. The request is authorized once and
+ * succeeds or fails as a whole: if one of the connections cannot be added,
+ * none of them is.
+ *
+ * The #NMRemoteConnection objects that represent what NetworkManager actually
+ * added are returned to @callback, in the same order as @connections, once all
+ * of them are initialized.
+ *
+ * Since: 1.16
+ **/
+void
+nm_client_add_connections_async (NMClient *client,
+                                 const GPtrArray *connections,
+                                 GCancellable *cancellable,
+                                 GAsyncReadyCallback callback,
+                                 gpointer user_data)
+{
+	GSimpleAsyncResult *simple;
+	GError *error = NULL;
+
+	g_return_if_fail (NM_IS_CLIENT (client));
+	g_return_if_fail (connections);
+
+	if (!_nm_client_check_nm_running (client, &error)) {
+		g_simple_async_report_take_gerror_in_idle (G_OBJECT (client), callback, user_data, error);
+		return;
+	}
+
+	simple = g_simple_async_result_new (G_OBJECT (client), callback, user_data,
+	                                    nm_client_add_connections_async);
+	if (cancellable)
+		g_simple_async_result_set_check_cancellable (simple, cancellable);
+	nm_remote_settings_add_connections_async (NM_CLIENT_GET_PRIVATE (client)->settings,
+	                                          connections,
+	                                          cancellable, add_connections_cb, simple);
+}
+
+/**
+ * nm_client_add_connections_finish:
+ * @client: an #NMClient
+ * @result: the result passed to the #GAsyncReadyCallback
+ * @error: location for a #GError, or %NULL
+ *
+ * Gets the result of a call to nm_client_add_connections_async().
+ *
+ * Returns: (transfer full) (element-type NMRemoteConnection): the new
+ *   #NMRemoteConnection objects on success, %NULL on failure, in which
+ *   case @error will be set.
+ *
+ * Since: 1.16
+ **/
+GPtrArray *
+nm_client_add_connections_finish (NMClient *client,
+                                  GAsyncResult *result,
+                                  GError **error)
+{
+	GSimpleAsyncResult *simple;
+
+	g_return_val_if_fail (NM_IS_CLIENT (client), NULL);
+	g_return_val_if_fail (G_IS_SIMPLE_ASYNC_RESULT (result), NULL);
+
+	simple = G_SIMPLE_ASYNC_RESULT (result);
+	if (g_simple_async_result_propagate_error (simple, error))
+		return NULL;
+	else
+		return g_ptr_array_ref (g_simple_async_result_get_op_res_gpointer (simple));
+}
+
 /**
  * nm_client_load_connections:
  * @client: the %NMClient
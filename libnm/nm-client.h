@@ -273,6 +273,10 @@ gboolean nm_client_set_logging (NMClient *client,
                                 const char *domains,
                                 GError **error);
 
+NM_AVAILABLE_IN_1_16
+char **nm_client_dump_logging (NMClient *client,
+                               GError **error);
+
 NMClientPermissionResult nm_client_get_permission_result (NMClient *client,
                                                           NMClientPermission permission);
 
@@ -370,6 +374,17 @@ NMRemoteConnection *nm_client_add_connection_finish (NMClient *client,
                                                      GAsyncResult *result,
                                                      GError **error);
 
+NM_AVAILABLE_IN_1_16
+void                nm_client_add_connections_async  (NMClient *client,
+                                                      const GPtrArray *connections,
+                                                      GCancellable *cancellable,
+                                                      GAsyncReadyCallback callback,
+                                                      gpointer user_data);
+NM_AVAILABLE_IN_1_16
+GPtrArray          *nm_client_add_connections_finish (NMClient *client,
+                                                      GAsyncResult *result,
+                                                      GError **error);
+
 gboolean nm_client_load_connections        (NMClient *client,
                                             char **filenames,
                                             char ***failures,
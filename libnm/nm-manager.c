@@ -651,6 +651,24 @@ nm_manager_set_logging (NMManager *manager, const char *level, const char *domai
 	return ret;
 }
 
+char **
+nm_manager_dump_logging (NMManager *manager, GError **error)
+{
+	char **entries = NULL;
+
+	g_return_val_if_fail (NM_IS_MANAGER (manager), NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	if (!nmdbus_manager_call_dump_logging_sync (NM_MANAGER_GET_PRIVATE (manager)->proxy,
+	                                            &entries,
+	                                            NULL, error)) {
+		if (error && *error)
+			g_dbus_error_strip_remote_error (*error);
+		return NULL;
+	}
+	return entries;
+}
+
 NMClientPermissionResult
 nm_manager_get_permission_result (NMManager *manager, NMClientPermission permission)
 {
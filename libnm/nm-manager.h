@@ -117,6 +117,8 @@ gboolean nm_manager_set_logging (NMManager *manager,
                                  const char *level,
                                  const char *domains,
                                  GError **error);
+char **nm_manager_dump_logging (NMManager *manager,
+                                GError **error);
 
 NMClientPermissionResult nm_manager_get_permission_result (NMManager *manager,
                                                            NMClientPermission permission);
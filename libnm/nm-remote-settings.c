@@ -48,6 +48,8 @@ typedef struct {
 
 	/* AddConnectionInfo objects that are waiting for the connection to become initialized */
 	GSList *add_list;
+	/* AddConnectionsInfo objects that are waiting for all their connections */
+	GSList *add_multi_list;
 
 	char *hostname;
 	gboolean can_modify;
@@ -121,6 +123,82 @@ add_connection_info_complete (NMRemoteSettings *self,
 	g_slice_free (AddConnectionInfo, info);
 }
 
+typedef struct {
+	NMRemoteSettings *self;
+	GSimpleAsyncResult *simple;
+	char **paths;
+	GPtrArray *connections;
+	guint n_pending;
+} AddConnectionsInfo;
+
+static void
+add_connections_info_complete (NMRemoteSettings *self,
+                               AddConnectionsInfo *info,
+                               GError *error)
+{
+	NMRemoteSettingsPrivate *priv = NM_REMOTE_SETTINGS_GET_PRIVATE (self);
+
+	if (!error) {
+		g_simple_async_result_set_op_res_gpointer (info->simple,
+		                                           g_steal_pointer (&info->connections),
+		                                           (GDestroyNotify) g_ptr_array_unref);
+	} else
+		g_simple_async_result_set_from_error (info->simple, error);
+	g_simple_async_result_complete (info->simple);
+
+	g_object_unref (info->simple);
+	priv->add_multi_list = g_slist_remove (priv->add_multi_list, info);
+
+	g_strfreev (info->paths);
+	if (info->connections)
+		g_ptr_array_unref (info->connections);
+	g_slice_free (AddConnectionsInfo, info);
+}
+
+/* Record @remote if @info waits for it. Returns %TRUE if @info got completed. */
+static gboolean
+add_connections_info_check (NMRemoteSettings *self,
+                            AddConnectionsInfo *info,
+                            NMRemoteConnection *remote)
+{
+	const char *path = nm_connection_get_path (NM_CONNECTION (remote));
+	guint i;
+
+	if (!info->paths)
+		return FALSE;
+
+	for (i = 0; info->paths[i]; i++) {
+		if (   !info->connections->pdata[i]
+		    && nm_streq0 (info->paths[i], path)) {
+			info->connections->pdata[i] = g_object_ref (remote);
+			info->n_pending--;
+		}
+	}
+
+	if (info->n_pending > 0)
+		return FALSE;
+
+	add_connections_info_complete (self, info, NULL);
+	return TRUE;
+}
+
+static AddConnectionsInfo *
+add_connections_info_find (NMRemoteSettings *self, const char *path)
+{
+	NMRemoteSettingsPrivate *priv = NM_REMOTE_SETTINGS_GET_PRIVATE (self);
+	GSList *iter;
+
+	for (iter = priv->add_multi_list; iter; iter = g_slist_next (iter)) {
+		AddConnectionsInfo *info = iter->data;
+
+		if (   info->paths
+		    && g_strv_contains ((const char *const*) info->paths, path))
+			return info;
+	}
+
+	return NULL;
+}
+
 typedef const char * (*ConnectionStringGetter) (NMConnection *);
 
 static NMRemoteConnection *
@@ -222,6 +300,7 @@ connection_added (NMRemoteSettings *self,
 	NMRemoteSettingsPrivate *priv = NM_REMOTE_SETTINGS_GET_PRIVATE (self);
 	AddConnectionInfo *addinfo;
 	const char *path;
+	GSList *iter;
 
 	if (!g_signal_handler_find (remote, G_SIGNAL_MATCH_FUNC | G_SIGNAL_MATCH_DATA, 0, 0, NULL,
 	                            G_CALLBACK (connection_visible_changed), self)) {
@@ -240,6 +319,14 @@ connection_added (NMRemoteSettings *self,
 	addinfo = add_connection_info_find (self, path);
 	if (addinfo)
 		add_connection_info_complete (self, addinfo, remote, NULL);
+
+	iter = priv->add_multi_list;
+	while (iter) {
+		AddConnectionsInfo *addsinfo = iter->data;
+
+		iter = iter->next;
+		add_connections_info_check (self, addsinfo, remote);
+	}
 }
 
 static void
@@ -247,6 +334,7 @@ object_creation_failed (NMObject *object, const char *failed_path)
 {
 	NMRemoteSettings *self = NM_REMOTE_SETTINGS (object);
 	AddConnectionInfo *addinfo;
+	AddConnectionsInfo *addsinfo;
 	GError *add_error;
 
 	addinfo = add_connection_info_find (self, failed_path);
@@ -257,6 +345,14 @@ object_creation_failed (NMObject *object, const char *failed_path)
 		add_connection_info_complete (self, addinfo, NULL, add_error);
 		g_error_free (add_error);
 	}
+
+	while ((addsinfo = add_connections_info_find (self, failed_path))) {
+		add_error = g_error_new_literal (NM_CLIENT_ERROR,
+		                                 NM_CLIENT_ERROR_OBJECT_CREATION_FAILED,
+		                                 _("Connection removed before it was initialized"));
+		add_connections_info_complete (self, addsinfo, add_error);
+		g_error_free (add_error);
+	}
 }
 
 const GPtrArray *
@@ -352,6 +448,101 @@ nm_remote_settings_add_connection_finish (NMRemoteSettings *settings,
 		return g_object_ref (g_simple_async_result_get_op_res_gpointer (simple));
 }
 
+static void
+add_connections_done (GObject *proxy, GAsyncResult *result, gpointer user_data)
+{
+	AddConnectionsInfo *info = user_data;
+	NMRemoteSettings *self = info->self;
+	NMRemoteSettingsPrivate *priv = NM_REMOTE_SETTINGS_GET_PRIVATE (self);
+	GError *error = NULL;
+	guint i, j;
+
+	if (!nmdbus_settings_call_add_connections_finish (NMDBUS_SETTINGS (proxy),
+	                                                  &info->paths,
+	                                                  result, &error)) {
+		g_dbus_error_strip_remote_error (error);
+		add_connections_info_complete (self, info, error);
+		g_clear_error (&error);
+		return;
+	}
+
+	info->n_pending = g_strv_length (info->paths);
+	info->connections = g_ptr_array_new_full (info->n_pending, g_object_unref);
+	g_ptr_array_set_size (info->connections, info->n_pending);
+
+	/* Some of the connections might already be initialized. For the
+	 * others, we still have to wait before calling the callback. */
+	for (i = 0; i < priv->all_connections->len; i++) {
+		NMRemoteConnection *remote = priv->all_connections->pdata[i];
+
+		for (j = 0; info->paths[j]; j++) {
+			if (nm_streq0 (info->paths[j], nm_connection_get_path (NM_CONNECTION (remote)))) {
+				if (add_connections_info_check (self, info, remote))
+					return;
+				break;
+			}
+		}
+	}
+
+	if (info->n_pending == 0)
+		add_connections_info_complete (self, info, NULL);
+}
+
+void
+nm_remote_settings_add_connections_async (NMRemoteSettings *settings,
+                                          const GPtrArray *connections,
+                                          GCancellable *cancellable,
+                                          GAsyncReadyCallback callback,
+                                          gpointer user_data)
+{
+	NMRemoteSettingsPrivate *priv;
+	AddConnectionsInfo *info;
+	GVariantBuilder builder;
+	guint i;
+
+	g_return_if_fail (NM_IS_REMOTE_SETTINGS (settings));
+	g_return_if_fail (connections);
+
+	priv = NM_REMOTE_SETTINGS_GET_PRIVATE (settings);
+
+	info = g_slice_new0 (AddConnectionsInfo);
+	info->self = settings;
+	info->simple = g_simple_async_result_new (G_OBJECT (settings), callback, user_data,
+	                                          nm_remote_settings_add_connections_async);
+	if (cancellable)
+		g_simple_async_result_set_check_cancellable (info->simple, cancellable);
+
+	g_variant_builder_init (&builder, G_VARIANT_TYPE ("aa{sa{sv}}"));
+	for (i = 0; i < connections->len; i++) {
+		g_variant_builder_add_value (&builder,
+		                             nm_connection_to_dbus (connections->pdata[i],
+		                                                    NM_CONNECTION_SERIALIZE_ALL));
+	}
+
+	nmdbus_settings_call_add_connections (priv->proxy,
+	                                      g_variant_builder_end (&builder),
+	                                      NULL,
+	                                      add_connections_done, info);
+
+	priv->add_multi_list = g_slist_append (priv->add_multi_list, info);
+}
+
+GPtrArray *
+nm_remote_settings_add_connections_finish (NMRemoteSettings *settings,
+                                           GAsyncResult *result,
+                                           GError **error)
+{
+	GSimpleAsyncResult *simple;
+
+	g_return_val_if_fail (g_simple_async_result_is_valid (result, G_OBJECT (settings), nm_remote_settings_add_connections_async), NULL);
+
+	simple = G_SIMPLE_ASYNC_RESULT (result);
+	if (g_simple_async_result_propagate_error (simple, error))
+		return NULL;
+	else
+		return g_ptr_array_ref (g_simple_async_result_get_op_res_gpointer (simple));
+}
+
 gboolean
 nm_remote_settings_load_connections (NMRemoteSettings *settings,
                                      char **filenames,
@@ -84,6 +84,15 @@ NMRemoteConnection *nm_remote_settings_add_connection_finish (NMRemoteSettings *
                                                               GAsyncResult *result,
                                                               GError **error);
 
+void                nm_remote_settings_add_connections_async  (NMRemoteSettings *settings,
+                                                               const GPtrArray *connections,
+                                                               GCancellable *cancellable,
+                                                               GAsyncReadyCallback callback,
+                                                               gpointer user_data);
+GPtrArray          *nm_remote_settings_add_connections_finish (NMRemoteSettings *settings,
+                                                               GAsyncResult *result,
+                                                               GError **error);
+
 gboolean nm_remote_settings_load_connections        (NMRemoteSettings *settings,
                                                      char **filenames,
                                                      char ***failures,
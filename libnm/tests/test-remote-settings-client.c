@@ -477,6 +477,78 @@ test_add_bad_connection (void)
 
 /*****************************************************************************/
 
+static void
+add_multi_cb (GObject *s,
+              GAsyncResult *result,
+              gpointer user_data)
+{
+	GPtrArray **out_connections = user_data;
+	GError *error = NULL;
+
+	*out_connections = nm_client_add_connections_finish (client, result, &error);
+	if (!*out_connections) {
+		g_assert_error (error, NM_CONNECTION_ERROR, NM_CONNECTION_ERROR_INVALID_PROPERTY);
+		g_error_free (error);
+		*out_connections = g_ptr_array_new ();
+	} else
+		g_assert_no_error (error);
+}
+
+static void
+test_add_connections (void)
+{
+	gs_unref_ptrarray GPtrArray *connections = NULL;
+	gs_unref_ptrarray GPtrArray *added = NULL;
+	time_t start, now;
+	guint i;
+
+	if (!nmtstc_service_available (sinfo))
+		return;
+
+	connections = g_ptr_array_new_with_free_func (g_object_unref);
+	g_ptr_array_add (connections, nmtst_create_minimal_connection ("multi-1", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL));
+	g_ptr_array_add (connections, nmtst_create_minimal_connection ("multi-2", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL));
+
+	nm_client_add_connections_async (client, connections, NULL, add_multi_cb, &added);
+
+	start = time (NULL);
+	do {
+		now = time (NULL);
+		g_main_context_iteration (NULL, FALSE);
+	} while (!added && (now - start < 5));
+	g_assert (added);
+
+	/* The new connections are returned in the order they were given */
+	g_assert_cmpint (added->len, ==, connections->len);
+	for (i = 0; i < added->len; i++) {
+		g_assert (NM_IS_REMOTE_CONNECTION (added->pdata[i]));
+		g_assert (nm_connection_compare (connections->pdata[i],
+		                                 added->pdata[i],
+		                                 NM_SETTING_COMPARE_FLAG_EXACT));
+		g_assert (nm_client_get_connection_by_uuid (client, nm_connection_get_uuid (added->pdata[i])) == added->pdata[i]);
+	}
+	g_clear_pointer (&added, g_ptr_array_unref);
+
+	/* One bad connection fails the whole request and none is added.
+	 * The test daemon doesn't support bond connections. */
+	g_ptr_array_set_size (connections, 0);
+	g_ptr_array_add (connections, nmtst_create_minimal_connection ("multi-3", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL));
+	g_ptr_array_add (connections, nmtst_create_minimal_connection ("multi-bad", NULL, NM_SETTING_BOND_SETTING_NAME, NULL));
+
+	nm_client_add_connections_async (client, connections, NULL, add_multi_cb, &added);
+
+	start = time (NULL);
+	do {
+		now = time (NULL);
+		g_main_context_iteration (NULL, FALSE);
+	} while (!added && (now - start < 5));
+	g_assert (added);
+	g_assert_cmpint (added->len, ==, 0);
+	g_assert (!nm_client_get_connection_by_id (client, "multi-3"));
+}
+
+/*****************************************************************************/
+
 static void
 save_hostname_cb (GObject *s,
                   GAsyncResult *result,
@@ -549,6 +621,7 @@ main (int argc, char **argv)
 	g_test_add_func ("/client/remove_connection", test_remove_connection);
 	g_test_add_func ("/client/add_remove_connection", test_add_remove_connection);
 	g_test_add_func ("/client/add_bad_connection", test_add_bad_connection);
+	g_test_add_func ("/client/add_connections", test_add_connections);
 	g_test_add_func ("/client/save_hostname", test_save_hostname);
 
 	ret = g_test_run ();
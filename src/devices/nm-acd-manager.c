@@ -19,16 +19,34 @@
 #include "nm-acd-manager.h"
 
 #include <netinet/in.h>
+#include <netinet/if_ether.h>
+#include <net/ethernet.h>
+#include <linux/filter.h>
+#include <linux/if_packet.h>
+#include <sys/socket.h>
 #include <sys/types.h>
-#include <sys/wait.h>
 
 #include "platform/nm-platform.h"
 #include "nm-utils.h"
 #include "NetworkManagerUtils.h"
-#include "n-acd/src/n-acd.h"
 
 /*****************************************************************************/
 
+/* The timings of RFC 5227. The probe timings are given in
+ * microseconds per millisecond of the requested probe timeout, so that
+ * a timeout of 9000 msec corresponds to the values of the RFC. */
+#define ACD_PROBE_NUM                  3
+#define ACD_PROBE_WAIT_USEC            111
+#define ACD_PROBE_MIN_USEC             111
+#define ACD_PROBE_MAX_USEC             333
+#define ACD_ANNOUNCE_WAIT_USEC         222
+#define ACD_ANNOUNCE_NUM               3
+#define ACD_ANNOUNCE_INTERVAL_MSEC     2000
+#define ACD_DEFEND_INTERVAL_MSEC       10000
+
+/* the maximum number of packets to read in one wakeup. */
+#define ACD_RECV_BATCH                 128
+
 typedef enum {
 	STATE_INIT,
 	STATE_PROBING,
@@ -39,10 +57,8 @@ typedef enum {
 typedef struct {
 	in_addr_t address;
 	gboolean duplicate;
-	NMAcdManager *manager;
-	NAcd *acd;
-	GIOChannel *channel;
-	guint event_id;
+	gboolean conflict;
+	gint64 last_defend;
 } AddressInfo;
 
 enum {
@@ -57,7 +73,13 @@ typedef struct {
 	guint8         hwaddr[ETH_ALEN];
 	State          state;
 	GHashTable    *addresses;
-	guint          completed;
+	guint          n_pending;
+	guint          n_iteration;
+	guint          timeout;
+	int            fd;
+	GIOChannel    *channel;
+	guint          event_id;
+	guint          timer_id;
 } NMAcdManagerPrivate;
 
 struct _NMAcdManager {
@@ -93,52 +115,7 @@ G_DEFINE_TYPE (NMAcdManager, nm_acd_manager, G_TYPE_OBJECT)
 
 /*****************************************************************************/
 
-static const char *
-_acd_event_to_string (unsigned int event)
-{
-	switch (event) {
-	case N_ACD_EVENT_READY:
-		return "ready";
-	case N_ACD_EVENT_USED:
-		return "used";
-	case N_ACD_EVENT_DEFENDED:
-		return "defended";
-	case N_ACD_EVENT_CONFLICT:
-		return "conflict";
-	case N_ACD_EVENT_DOWN:
-		return "down";
-	}
-	return NULL;
-}
-
-#define acd_event_to_string(event) NM_UTILS_LOOKUP_STR (_acd_event_to_string, event)
-
-static const char *
-_acd_error_to_string (int error)
-{
-	if (error < 0)
-		return strerror(-error);
-
-	switch (error) {
-	case _N_ACD_E_SUCCESS:
-		return "success";
-	case N_ACD_E_DONE:
-		return "no more events (engine running)";
-	case N_ACD_E_STOPPED:
-		return "no more events (engine stopped)";
-	case N_ACD_E_PREEMPTED:
-		return "preempted";
-	case N_ACD_E_INVALID_ARGUMENT:
-		return "invalid argument";
-	case N_ACD_E_BUSY:
-		return "busy";
-	}
-	return NULL;
-}
-
-#define acd_error_to_string(error) NM_UTILS_LOOKUP_STR (_acd_error_to_string, error)
-
-/*****************************************************************************/
+static gboolean acd_timeout_cb (gpointer user_data);
 
 /**
  * nm_acd_manager_add_address:
@@ -164,123 +141,375 @@ nm_acd_manager_add_address (NMAcdManager *self, in_addr_t address)
 
 	info = g_slice_new0 (AddressInfo);
 	info->address = address;
-	info->manager = self;
 
 	g_hash_table_insert (priv->addresses, GUINT_TO_POINTER (address), info);
 
 	return TRUE;
 }
 
+static void
+acd_schedule (NMAcdManager *self, guint64 timeout_usec, guint64 jitter_usec)
+{
+	NMAcdManagerPrivate *priv = NM_ACD_MANAGER_GET_PRIVATE (self);
+
+	if (jitter_usec)
+		timeout_usec += g_random_int () % jitter_usec;
+
+	nm_clear_g_source (&priv->timer_id);
+	priv->timer_id = g_timeout_add ((timeout_usec + 999) / 1000, acd_timeout_cb, self);
+}
+
+static void
+acd_send (NMAcdManager *self, const AddressInfo *info, gboolean announce)
+{
+	NMAcdManagerPrivate *priv = NM_ACD_MANAGER_GET_PRIVATE (self);
+	const struct sockaddr_ll address = {
+		.sll_family   = AF_PACKET,
+		.sll_protocol = htons (ETH_P_ARP),
+		.sll_ifindex  = priv->ifindex,
+		.sll_halen    = ETH_ALEN,
+		.sll_addr     = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff },
+	};
+	struct ether_arp arp = {
+		.ea_hdr.ar_hrd = htons (ARPHRD_ETHER),
+		.ea_hdr.ar_pro = htons (ETHERTYPE_IP),
+		.ea_hdr.ar_hln = ETH_ALEN,
+		.ea_hdr.ar_pln = sizeof (in_addr_t),
+		.ea_hdr.ar_op  = htons (ARPOP_REQUEST),
+	};
+	int errsv;
+
+	memcpy (arp.arp_sha, priv->hwaddr, ETH_ALEN);
+	memcpy (arp.arp_tpa, &info->address, sizeof (in_addr_t));
+	if (announce)
+		memcpy (arp.arp_spa, &info->address, sizeof (in_addr_t));
+
+	if (sendto (priv->fd, &arp, sizeof (arp), MSG_NOSIGNAL,
+	            (const struct sockaddr *) &address, sizeof (address)) >= 0)
+		return;
+
+	/* a full buffer or a down interface is treated like a packet
+	 * lost on the wire. */
+	errsv = errno;
+	if (!NM_IN_SET (errsv, EAGAIN, ENOBUFS, ENETDOWN, ENXIO)) {
+		_LOGD ("couldn't send %s for address %s: %s",
+		       announce ? "announcement" : "probe",
+		       nm_utils_inet4_ntop (info->address, NULL),
+		       g_strerror (errsv));
+	}
+}
+
+static void
+acd_send_all (NMAcdManager *self, gboolean announce)
+{
+	NMAcdManagerPrivate *priv = NM_ACD_MANAGER_GET_PRIVATE (self);
+	GHashTableIter iter;
+	AddressInfo *info;
+
+	g_hash_table_iter_init (&iter, priv->addresses);
+	while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &info)) {
+		if (info->duplicate || info->conflict)
+			continue;
+		acd_send (self, info, announce);
+	}
+}
+
+static void
+acd_probe_done (NMAcdManager *self)
+{
+	NMAcdManagerPrivate *priv = NM_ACD_MANAGER_GET_PRIVATE (self);
+
+	nm_clear_g_source (&priv->timer_id);
+	priv->state = STATE_PROBE_DONE;
+	_LOGD ("probe terminated");
+
+	/* the handler may destroy @self. */
+	g_signal_emit (self, signals[PROBE_TERMINATED], 0);
+}
+
 static gboolean
-acd_event (GIOChannel *source, GIOCondition condition, gpointer data)
+acd_timeout_cb (gpointer user_data)
 {
-	AddressInfo *info = data;
-	NMAcdManager *self = info->manager;
+	NMAcdManager *self = user_data;
 	NMAcdManagerPrivate *priv = NM_ACD_MANAGER_GET_PRIVATE (self);
-	NAcdEvent *event;
-	char address_str[INET_ADDRSTRLEN];
-	gs_free char *hwaddr_str = NULL;
-	int r;
-
-	if (   n_acd_dispatch (info->acd)
-	    || n_acd_pop_event (info->acd, &event))
-		return G_SOURCE_CONTINUE;
-
-	switch (event->event) {
-	case N_ACD_EVENT_READY:
-		info->duplicate = FALSE;
-		if (priv->state == STATE_ANNOUNCING) {
-			r = n_acd_announce (info->acd, N_ACD_DEFEND_ONCE);
-			if (r) {
-				_LOGW ("couldn't announce address %s on interface '%s': %s",
-				       nm_utils_inet4_ntop (info->address, address_str),
-				       nm_platform_link_get_name (NM_PLATFORM_GET, priv->ifindex),
-				       acd_error_to_string (r));
-			} else {
-				_LOGD ("announcing address %s",
-				       nm_utils_inet4_ntop (info->address, address_str));
-			}
+
+	priv->timer_id = 0;
+
+	switch (priv->state) {
+	case STATE_PROBING:
+		if (priv->n_iteration >= ACD_PROBE_NUM) {
+			acd_probe_done (self);
+			return G_SOURCE_REMOVE;
+		}
+
+		/* one timer for all addresses: the probes of one round go
+		 * out together. */
+		acd_send_all (self, FALSE);
+		if (++priv->n_iteration >= ACD_PROBE_NUM)
+			acd_schedule (self, (guint64) priv->timeout * ACD_ANNOUNCE_WAIT_USEC, 0);
+		else {
+			acd_schedule (self,
+			              (guint64) priv->timeout * ACD_PROBE_MIN_USEC,
+			              (guint64) priv->timeout * (ACD_PROBE_MAX_USEC - ACD_PROBE_MIN_USEC));
 		}
 		break;
-	case N_ACD_EVENT_USED:
-		info->duplicate = TRUE;
-		break;
-	case N_ACD_EVENT_DEFENDED:
-		_LOGD ("defended address %s from host %s",
-		       nm_utils_inet4_ntop (info->address, address_str),
-		       (hwaddr_str = nm_utils_hwaddr_ntoa (event->defended.sender,
-		                                           event->defended.n_sender)));
-		break;
-	case N_ACD_EVENT_CONFLICT:
-		_LOGW ("conflict for address %s detected with host %s on interface '%s'",
-		       nm_utils_inet4_ntop (info->address, address_str),
-		       (hwaddr_str = nm_utils_hwaddr_ntoa (event->defended.sender,
-		                                           event->defended.n_sender)),
-		       nm_platform_link_get_name (NM_PLATFORM_GET, priv->ifindex));
+	case STATE_ANNOUNCING:
+		acd_send_all (self, TRUE);
+		if (++priv->n_iteration < ACD_ANNOUNCE_NUM)
+			acd_schedule (self, ACD_ANNOUNCE_INTERVAL_MSEC * 1000, 0);
 		break;
 	default:
-		_LOGD ("event '%s' for address %s",
-		       acd_event_to_string (event->event),
-		       nm_utils_inet4_ntop (info->address, address_str));
-		return G_SOURCE_CONTINUE;
+		nm_assert_not_reached ();
+		break;
 	}
 
-	if (   priv->state == STATE_PROBING
-	    && ++priv->completed == g_hash_table_size (priv->addresses)) {
-		priv->state = STATE_PROBE_DONE;
-		g_signal_emit (self, signals[PROBE_TERMINATED], 0);
+	return G_SOURCE_REMOVE;
+}
+
+/* returns TRUE if the probe terminated. In that case, @self
+ * might be destroyed already. */
+static gboolean
+acd_handle_packet (NMAcdManager *self, const struct ether_arp *packet)
+{
+	NMAcdManagerPrivate *priv = NM_ACD_MANAGER_GET_PRIVATE (self);
+	gs_free char *hwaddr_str = NULL;
+	AddressInfo *info = NULL;
+	in_addr_t spa, tpa;
+	gboolean hard_conflict;
+	gint64 now;
+
+	memcpy (&spa, packet->arp_spa, sizeof (spa));
+	memcpy (&tpa, packet->arp_tpa, sizeof (tpa));
+
+	/* a sender using one of our addresses is a hard conflict. Somebody
+	 * else probing for it is a soft one. */
+	if (   spa == INADDR_ANY
+	    && packet->ea_hdr.ar_op == htons (ARPOP_REQUEST)
+	    && (info = g_hash_table_lookup (priv->addresses, GUINT_TO_POINTER (tpa))))
+		hard_conflict = FALSE;
+	else if ((info = g_hash_table_lookup (priv->addresses, GUINT_TO_POINTER (spa))))
+		hard_conflict = TRUE;
+	else
+		return FALSE;
+
+	switch (priv->state) {
+	case STATE_PROBING:
+		if (info->duplicate)
+			return FALSE;
+		info->duplicate = TRUE;
+		_LOGD ("address %s is used by host %s",
+		       nm_utils_inet4_ntop (info->address, NULL),
+		       (hwaddr_str = nm_utils_hwaddr_ntoa (packet->arp_sha, ETH_ALEN)));
+		nm_assert (priv->n_pending > 0);
+		if (--priv->n_pending == 0) {
+			acd_probe_done (self);
+			return TRUE;
+		}
+		break;
+	case STATE_ANNOUNCING:
+		if (   !hard_conflict
+		    || info->duplicate
+		    || info->conflict)
+			break;
+
+		now = nm_utils_get_monotonic_timestamp_ms ();
+		if (   !info->last_defend
+		    || now > info->last_defend + ACD_DEFEND_INTERVAL_MSEC) {
+			acd_send (self, info, TRUE);
+			info->last_defend = now;
+			_LOGD ("defended address %s from host %s",
+			       nm_utils_inet4_ntop (info->address, NULL),
+			       (hwaddr_str = nm_utils_hwaddr_ntoa (packet->arp_sha, ETH_ALEN)));
+		} else {
+			info->conflict = TRUE;
+			_LOGW ("conflict for address %s detected with host %s on interface '%s'",
+			       nm_utils_inet4_ntop (info->address, NULL),
+			       (hwaddr_str = nm_utils_hwaddr_ntoa (packet->arp_sha, ETH_ALEN)),
+			       nm_platform_link_get_name (NM_PLATFORM_GET, priv->ifindex));
+		}
+		break;
+	default:
+		break;
 	}
 
-	return G_SOURCE_CONTINUE;
+	return FALSE;
 }
 
 static gboolean
-acd_probe_start (NMAcdManager *self,
-                 AddressInfo *info,
-                 guint64 timeout)
+acd_event (GIOChannel *source, GIOCondition condition, gpointer data)
 {
+	NMAcdManager *self = data;
 	NMAcdManagerPrivate *priv = NM_ACD_MANAGER_GET_PRIVATE (self);
-	NAcdConfig *config;
-	int r, fd;
+	struct ether_arp packet;
+	guint i;
+
+	for (i = 0; i < ACD_RECV_BATCH; i++) {
+		ssize_t l;
+		int errsv;
+
+		/* overlong frames are truncated on purpose, Ethernet padding
+		 * is not part of the ARP packet. */
+		l = recv (priv->fd, &packet, sizeof (packet), 0);
+		if (l == (ssize_t) sizeof (packet)) {
+			if (acd_handle_packet (self, &packet))
+				return G_SOURCE_CONTINUE;
+			continue;
+		}
+		if (l >= 0)
+			continue;
 
-	r = n_acd_new (&info->acd);
-	if (r) {
-		_LOGW ("could not create ACD for %s on interface '%s': %s",
-		       nm_utils_inet4_ntop (info->address, NULL),
-		       nm_platform_link_get_name (NM_PLATFORM_GET, priv->ifindex),
-		       acd_error_to_string (r));
-		return FALSE;
+		errsv = errno;
+		if (!NM_IN_SET (errsv, EAGAIN, ENETDOWN, ENXIO))
+			_LOGD ("couldn't receive packet: %s", g_strerror (errsv));
+		break;
 	}
 
-	n_acd_get_fd (info->acd, &fd);
-	info->channel = g_io_channel_unix_new (fd);
-	info->event_id = g_io_add_watch (info->channel, G_IO_IN, acd_event, info);
-
-	config = &(NAcdConfig) {
-		.ifindex = priv->ifindex,
-		.mac = priv->hwaddr,
-		.n_mac = ETH_ALEN,
-		.ip = info->address,
-		.timeout_msec = timeout,
-		.transport = N_ACD_TRANSPORT_ETHERNET,
-	};
+	return G_SOURCE_CONTINUE;
+}
 
-	r = n_acd_start (info->acd, config);
-	if (r) {
-		_LOGW ("could not start probe for %s on interface '%s': %s",
-		       nm_utils_inet4_ntop (info->address, NULL),
-		       nm_platform_link_get_name (NM_PLATFORM_GET, priv->ifindex),
-		       acd_error_to_string (r));
-		return FALSE;
+#define _BPF_APPEND(filter, ...) \
+	G_STMT_START { \
+		const struct sock_filter _insn = __VA_ARGS__; \
+		\
+		g_array_append_val ((filter), _insn); \
+	} G_STMT_END
+
+static GArray *
+acd_build_filter (NMAcdManager *self)
+{
+	NMAcdManagerPrivate *priv = NM_ACD_MANAGER_GET_PRIVATE (self);
+	GArray *filter;
+	GHashTableIter iter;
+	AddressInfo *info;
+	guint32 mac_hi, n_addresses;
+	guint16 mac_lo;
+	guint i;
+
+	filter = g_array_new (FALSE, FALSE, sizeof (struct sock_filter));
+
+	/* Basic ARP header validation. */
+	_BPF_APPEND (filter, BPF_STMT (BPF_LD + BPF_W + BPF_LEN, 0));
+	_BPF_APPEND (filter, BPF_JUMP (BPF_JMP + BPF_JGE + BPF_K, sizeof (struct ether_arp), 1, 0));
+	_BPF_APPEND (filter, BPF_STMT (BPF_RET + BPF_K, 0));
+	_BPF_APPEND (filter, BPF_STMT (BPF_LD + BPF_H + BPF_ABS, offsetof (struct ether_arp, ea_hdr.ar_hrd)));
+	_BPF_APPEND (filter, BPF_JUMP (BPF_JMP + BPF_JEQ + BPF_K, ARPHRD_ETHER, 1, 0));
+	_BPF_APPEND (filter, BPF_STMT (BPF_RET + BPF_K, 0));
+	_BPF_APPEND (filter, BPF_STMT (BPF_LD + BPF_H + BPF_ABS, offsetof (struct ether_arp, ea_hdr.ar_pro)));
+	_BPF_APPEND (filter, BPF_JUMP (BPF_JMP + BPF_JEQ + BPF_K, ETHERTYPE_IP, 1, 0));
+	_BPF_APPEND (filter, BPF_STMT (BPF_RET + BPF_K, 0));
+	_BPF_APPEND (filter, BPF_STMT (BPF_LD + BPF_B + BPF_ABS, offsetof (struct ether_arp, ea_hdr.ar_hln)));
+	_BPF_APPEND (filter, BPF_JUMP (BPF_JMP + BPF_JEQ + BPF_K, ETH_ALEN, 1, 0));
+	_BPF_APPEND (filter, BPF_STMT (BPF_RET + BPF_K, 0));
+	_BPF_APPEND (filter, BPF_STMT (BPF_LD + BPF_B + BPF_ABS, offsetof (struct ether_arp, ea_hdr.ar_pln)));
+	_BPF_APPEND (filter, BPF_JUMP (BPF_JMP + BPF_JEQ + BPF_K, sizeof (in_addr_t), 1, 0));
+	_BPF_APPEND (filter, BPF_STMT (BPF_RET + BPF_K, 0));
+	_BPF_APPEND (filter, BPF_STMT (BPF_LD + BPF_H + BPF_ABS, offsetof (struct ether_arp, ea_hdr.ar_op)));
+	_BPF_APPEND (filter, BPF_JUMP (BPF_JMP + BPF_JEQ + BPF_K, ARPOP_REQUEST, 2, 0));
+	_BPF_APPEND (filter, BPF_JUMP (BPF_JMP + BPF_JEQ + BPF_K, ARPOP_REPLY, 1, 0));
+	_BPF_APPEND (filter, BPF_STMT (BPF_RET + BPF_K, 0));
+
+	/* Ignore our own packets. BPF loads are big-endian while the
+	 * immediates are in host order. */
+	mac_hi =   ((guint32) priv->hwaddr[0] << 24)
+	         | ((guint32) priv->hwaddr[1] << 16)
+	         | ((guint32) priv->hwaddr[2] << 8)
+	         |  (guint32) priv->hwaddr[3];
+	mac_lo =   ((guint16) priv->hwaddr[4] << 8)
+	         |  (guint16) priv->hwaddr[5];
+	_BPF_APPEND (filter, BPF_STMT (BPF_LD + BPF_W + BPF_ABS, offsetof (struct ether_arp, arp_sha)));
+	_BPF_APPEND (filter, BPF_JUMP (BPF_JMP + BPF_JEQ + BPF_K, mac_hi, 0, 3));
+	_BPF_APPEND (filter, BPF_STMT (BPF_LD + BPF_H + BPF_ABS, offsetof (struct ether_arp, arp_sha) + 4));
+	_BPF_APPEND (filter, BPF_JUMP (BPF_JMP + BPF_JEQ + BPF_K, mac_lo, 0, 1));
+	_BPF_APPEND (filter, BPF_STMT (BPF_RET + BPF_K, 0));
+
+	/* Accept packets whose sender or target protocol address is any
+	 * of our addresses. Each comparison only skips over the next
+	 * instruction, so the program stays valid regardless of the
+	 * number of addresses (jump offsets are limited to 8 bit).
+	 * If there are too many addresses for one program, let every
+	 * ARP packet pass and leave the matching to acd_handle_packet(). */
+	n_addresses = g_hash_table_size (priv->addresses);
+	if (filter->len + 4 * n_addresses + 3 > BPF_MAXINSNS) {
+		_BPF_APPEND (filter, BPF_STMT (BPF_RET + BPF_K, 65535));
+		return filter;
 	}
 
-	if (timeout) {
-		_LOGD ("started probe for %s with timeout %llu",
-		       nm_utils_inet4_ntop (info->address, NULL),
-		       (unsigned long long) timeout);
+	for (i = 0; i < 2; i++) {
+		_BPF_APPEND (filter, BPF_STMT (BPF_LD + BPF_W + BPF_ABS,
+		                               i == 0
+		                               ? offsetof (struct ether_arp, arp_spa)
+		                               : offsetof (struct ether_arp, arp_tpa)));
+		g_hash_table_iter_init (&iter, priv->addresses);
+		while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &info)) {
+			_BPF_APPEND (filter, BPF_JUMP (BPF_JMP + BPF_JEQ + BPF_K, ntohl (info->address), 0, 1));
+			_BPF_APPEND (filter, BPF_STMT (BPF_RET + BPF_K, 65535));
+		}
 	}
+	_BPF_APPEND (filter, BPF_STMT (BPF_RET + BPF_K, 0));
+
+	return filter;
+}
 
+static gboolean
+acd_socket_open (NMAcdManager *self)
+{
+	NMAcdManagerPrivate *priv = NM_ACD_MANAGER_GET_PRIVATE (self);
+	const struct sockaddr_ll address = {
+		.sll_family   = AF_PACKET,
+		.sll_protocol = htons (ETH_P_ARP),
+		.sll_ifindex  = priv->ifindex,
+		.sll_halen    = ETH_ALEN,
+		.sll_addr     = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff },
+	};
+	nm_auto_close int fd = -1;
+	gs_unref_array GArray *filter = NULL;
+	struct sock_fprog fprog;
+	int errsv;
+
+	if (priv->fd >= 0)
+		return TRUE;
+
+	fd = socket (PF_PACKET, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+	if (fd < 0)
+		goto fail;
+
+	/* a single filter for all addresses, so that we only wake up
+	 * for packets that concern one of them. */
+	filter = acd_build_filter (self);
+	fprog = (struct sock_fprog) {
+		.len    = filter->len,
+		.filter = (struct sock_filter *) filter->data,
+	};
+	if (setsockopt (fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof (fprog)) < 0)
+		goto fail;
+
+	if (bind (fd, (const struct sockaddr *) &address, sizeof (address)) < 0)
+		goto fail;
+
+	priv->fd = nm_steal_fd (&fd);
+	priv->channel = g_io_channel_unix_new (priv->fd);
+	priv->event_id = g_io_add_watch (priv->channel, G_IO_IN, acd_event, self);
 	return TRUE;
+
+fail:
+	errsv = errno;
+	_LOGW ("could not open ACD socket on interface '%s': %s",
+	       nm_platform_link_get_name (NM_PLATFORM_GET, priv->ifindex),
+	       g_strerror (errsv));
+	return FALSE;
+}
+
+static void
+acd_socket_close (NMAcdManager *self)
+{
+	NMAcdManagerPrivate *priv = NM_ACD_MANAGER_GET_PRIVATE (self);
+
+	nm_clear_g_source (&priv->event_id);
+	g_clear_pointer (&priv->channel, g_io_channel_unref);
+	if (priv->fd >= 0) {
+		nm_close (priv->fd);
+		priv->fd = -1;
+	}
 }
 
 /**
@@ -298,24 +527,26 @@ gboolean
 nm_acd_manager_start_probe (NMAcdManager *self, guint timeout)
 {
 	NMAcdManagerPrivate *priv;
-	GHashTableIter iter;
-	AddressInfo *info;
-	gboolean success = FALSE;
 
 	g_return_val_if_fail (NM_IS_ACD_MANAGER (self), FALSE);
 	priv = NM_ACD_MANAGER_GET_PRIVATE (self);
 	g_return_val_if_fail (priv->state == STATE_INIT, FALSE);
 
-	priv->completed = 0;
+	if (!g_hash_table_size (priv->addresses))
+		return FALSE;
 
-	g_hash_table_iter_init (&iter, priv->addresses);
-	while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &info))
-		success |= acd_probe_start (self, info, timeout);
+	if (!acd_socket_open (self))
+		return FALSE;
 
-	if (success)
-		priv->state = STATE_PROBING;
+	priv->state = STATE_PROBING;
+	priv->timeout = timeout;
+	priv->n_pending = g_hash_table_size (priv->addresses);
+	priv->n_iteration = timeout ? 0 : ACD_PROBE_NUM;
+	acd_schedule (self, 0, (guint64) timeout * ACD_PROBE_WAIT_USEC);
 
-	return success;
+	_LOGD ("started probe for %u addresses with timeout %u",
+	       priv->n_pending, timeout);
+	return TRUE;
 }
 
 /**
@@ -332,6 +563,8 @@ nm_acd_manager_reset (NMAcdManager *self)
 	g_return_if_fail (NM_IS_ACD_MANAGER (self));
 	priv = NM_ACD_MANAGER_GET_PRIVATE (self);
 
+	nm_clear_g_source (&priv->timer_id);
+	acd_socket_close (self);
 	g_hash_table_remove_all (priv->addresses);
 
 	priv->state = STATE_INIT;
@@ -383,46 +616,26 @@ nm_acd_manager_check_address (NMAcdManager *self, in_addr_t address)
  * nm_acd_manager_announce_addresses:
  * @self: a #NMAcdManager
  *
- * Start announcing addresses.
+ * Start announcing addresses. Addresses found to be duplicate
+ * by a previous probe are skipped.
  */
 void
 nm_acd_manager_announce_addresses (NMAcdManager *self)
 {
 	NMAcdManagerPrivate *priv = NM_ACD_MANAGER_GET_PRIVATE (self);
-	GHashTableIter iter;
-	AddressInfo *info;
-	int r;
 
-	if (priv->state == STATE_INIT) {
-		/* n-acd can't announce without probing, therefore let's
-		 * start a fake probe with zero timeout and then perform
-		 * the announce. */
-		priv->state = STATE_ANNOUNCING;
-		g_hash_table_iter_init (&iter, priv->addresses);
-		while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &info)) {
-			if (!acd_probe_start (self, info, 0)) {
-				_LOGW ("couldn't announce address %s on interface '%s'",
-				       nm_utils_inet4_ntop (info->address, NULL),
-				       nm_platform_link_get_name (NM_PLATFORM_GET, priv->ifindex));
-			}
-		}
-	} else if (priv->state == STATE_PROBE_DONE) {
-		priv->state = STATE_ANNOUNCING;
-		g_hash_table_iter_init (&iter, priv->addresses);
-		while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &info)) {
-			if (info->duplicate)
-				continue;
-			r = n_acd_announce (info->acd, N_ACD_DEFEND_ONCE);
-			if (r) {
-				_LOGW ("couldn't announce address %s on interface '%s': %s",
-				       nm_utils_inet4_ntop (info->address, NULL),
-				       nm_platform_link_get_name (NM_PLATFORM_GET, priv->ifindex),
-				       acd_error_to_string (r));
-			} else
-				_LOGD ("announcing address %s", nm_utils_inet4_ntop (info->address, NULL));
-		}
-	} else
-		nm_assert_not_reached ();
+	g_return_if_fail (NM_IN_SET (priv->state, STATE_INIT, STATE_PROBE_DONE));
+
+	if (!acd_socket_open (self)) {
+		_LOGW ("couldn't announce addresses on interface '%s'",
+		       nm_platform_link_get_name (NM_PLATFORM_GET, priv->ifindex));
+		return;
+	}
+
+	priv->state = STATE_ANNOUNCING;
+	priv->n_iteration = 0;
+	_LOGD ("announcing %u addresses", g_hash_table_size (priv->addresses));
+	acd_schedule (self, 0, 0);
 }
 
 static void
@@ -430,10 +643,6 @@ destroy_address_info (gpointer data)
 {
 	AddressInfo *info = (AddressInfo *) data;
 
-	g_clear_pointer (&info->channel, g_io_channel_unref);
-	g_clear_pointer (&info->acd, n_acd_free);
-	nm_clear_g_source (&info->event_id);
-
 	g_slice_free (AddressInfo, info);
 }
 
@@ -447,6 +656,7 @@ nm_acd_manager_init (NMAcdManager *self)
 	priv->addresses = g_hash_table_new_full (nm_direct_hash, NULL,
 	                                         NULL, destroy_address_info);
 	priv->state = STATE_INIT;
+	priv->fd = -1;
 }
 
 NMAcdManager *
@@ -472,6 +682,8 @@ dispose (GObject *object)
 	NMAcdManager *self = NM_ACD_MANAGER (object);
 	NMAcdManagerPrivate *priv = NM_ACD_MANAGER_GET_PRIVATE (self);
 
+	nm_clear_g_source (&priv->timer_id);
+	acd_socket_close (self);
 	g_clear_pointer (&priv->addresses, g_hash_table_destroy);
 
 	G_OBJECT_CLASS (nm_acd_manager_parent_class)->dispose (object);
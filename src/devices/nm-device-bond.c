@@ -94,6 +94,11 @@ set_bond_attr (NMDevice *device, NMBondMode mode, const char *attr, const char *
 	if (!_nm_setting_bond_option_supported (attr, mode))
 		return FALSE;
 
+	/* Unlike bridges (see nm_platform_link_bridge_change()), bond options
+	 * are still set one by one via sysfs. Their string values are parsed
+	 * by the kernel's sysfs handlers, which also accept the "+"/"-" syntax
+	 * for arp_ip_target, and apply_bonding_config() relies on setting them
+	 * in a certain order. */
 	ret = nm_platform_sysctl_master_set_option (nm_device_get_platform (device), ifindex, attr, value);
 	if (!ret)
 		_LOGW (LOGD_PLATFORM, "failed to set bonding attribute '%s' to '%s'", attr, value);
@@ -191,14 +191,12 @@ static const Option slave_options[] = {
 	{ NULL, NULL }
 };
 
-static void
-commit_option (NMDevice *device, NMSetting *setting, const Option *option, gboolean slave)
+static guint32
+_option_get_uval (NMSetting *setting, const Option *option)
 {
-	int ifindex = nm_device_get_ifindex (device);
 	GParamSpec *pspec;
 	GValue val = G_VALUE_INIT;
 	guint32 uval = 0;
-	gs_free char *value = NULL;
 
 	g_assert (setting);
 
@@ -234,7 +232,28 @@ commit_option (NMDevice *device, NMSetting *setting, const Option *option, gbool
 		g_assert_not_reached ();
 	g_value_unset (&val);
 
-	value = g_strdup_printf ("%u", uval);
+	return uval;
+}
+
+static guint32
+_option_get_uval_by_name (NMSetting *setting, const Option *options, const char *name)
+{
+	const Option *option;
+
+	for (option = options; option->name; option++) {
+		if (nm_streq (option->name, name))
+			return _option_get_uval (setting, option);
+	}
+	g_return_val_if_reached (0);
+}
+
+static void
+commit_option (NMDevice *device, NMSetting *setting, const Option *option, gboolean slave)
+{
+	int ifindex = nm_device_get_ifindex (device);
+	char value[32];
+
+	nm_sprintf_buf (value, "%u", _option_get_uval (setting, option));
 	if (slave)
 		nm_platform_sysctl_slave_set_option (nm_device_get_platform (device), ifindex, option->sysname, value);
 	else
@@ -244,9 +263,29 @@ commit_option (NMDevice *device, NMSetting *setting, const Option *option, gbool
 static void
 commit_master_options (NMDevice *device, NMSettingBridge *setting)
 {
+	NMPlatform *platform = nm_device_get_platform (device);
+	int ifindex = nm_device_get_ifindex (device);
 	const Option *option;
 	NMSetting *s = NM_SETTING (setting);
 
+	/* If the kernel exposes the bridge options via netlink, set them all
+	 * with one request instead of writing each sysfs file separately. */
+	if (nm_platform_link_get_lnk_bridge (platform, ifindex, NULL)) {
+		const NMPlatformLnkBridge props = {
+			.stp_state      = _option_get_uval_by_name (s, master_options, NM_SETTING_BRIDGE_STP),
+			.priority       = _option_get_uval_by_name (s, master_options, NM_SETTING_BRIDGE_PRIORITY),
+			.forward_delay  = _option_get_uval_by_name (s, master_options, NM_SETTING_BRIDGE_FORWARD_DELAY),
+			.hello_time     = _option_get_uval_by_name (s, master_options, NM_SETTING_BRIDGE_HELLO_TIME),
+			.max_age        = _option_get_uval_by_name (s, master_options, NM_SETTING_BRIDGE_MAX_AGE),
+			.ageing_time    = _option_get_uval_by_name (s, master_options, NM_SETTING_BRIDGE_AGEING_TIME),
+			.group_fwd_mask = _option_get_uval_by_name (s, master_options, NM_SETTING_BRIDGE_GROUP_FORWARD_MASK),
+			.mcast_snooping = !!_option_get_uval_by_name (s, master_options, NM_SETTING_BRIDGE_MULTICAST_SNOOPING),
+		};
+
+		if (nm_platform_link_bridge_change (platform, ifindex, &props))
+			return;
+	}
+
 	for (option = master_options; option->name; option++)
 		commit_option (device, s, option, FALSE);
 }
@@ -262,9 +301,23 @@ commit_slave_options (NMDevice *device, NMSettingBridgePort *setting)
 	else
 		s = s_clear = nm_setting_bridge_port_new ();
 
+	{
+		const NMPlatformBridgePort props = {
+			.priority     = _option_get_uval_by_name (s, slave_options, NM_SETTING_BRIDGE_PORT_PRIORITY),
+			.path_cost    = _option_get_uval_by_name (s, slave_options, NM_SETTING_BRIDGE_PORT_PATH_COST),
+			.hairpin_mode = !!_option_get_uval_by_name (s, slave_options, NM_SETTING_BRIDGE_PORT_HAIRPIN_MODE),
+		};
+
+		if (nm_platform_link_bridge_port_change (nm_device_get_platform (device),
+		                                         nm_device_get_ifindex (device),
+		                                         &props))
+			goto out;
+	}
+
 	for (option = slave_options; option->name; option++)
 		commit_option (device, s, option, TRUE);
 
+out:
 	g_clear_object (&s_clear);
 }
 
@@ -274,6 +327,7 @@ update_connection (NMDevice *device, NMConnection *connection)
 	NMDeviceBridge *self = NM_DEVICE_BRIDGE (device);
 	NMSettingBridge *s_bridge = nm_connection_get_setting_bridge (connection);
 	int ifindex = nm_device_get_ifindex (device);
+	const NMPlatformLnkBridge *lnk;
 	const Option *option;
 
 	if (!s_bridge) {
@@ -281,6 +335,23 @@ update_connection (NMDevice *device, NMConnection *connection)
 		nm_connection_add_setting (connection, (NMSetting *) s_bridge);
 	}
 
+	lnk = nm_platform_link_get_lnk_bridge (nm_device_get_platform (device), ifindex, NULL);
+	if (lnk) {
+		/* the cached link already carries all options, no need to read sysfs.
+		 * Time values are in centiseconds, see commit_option(). */
+		g_object_set (s_bridge,
+		              NM_SETTING_BRIDGE_STP, (gboolean) (lnk->stp_state != 0),
+		              NM_SETTING_BRIDGE_PRIORITY, (guint) lnk->priority,
+		              NM_SETTING_BRIDGE_FORWARD_DELAY, (guint) (lnk->forward_delay / 100),
+		              NM_SETTING_BRIDGE_HELLO_TIME, (guint) (lnk->hello_time / 100),
+		              NM_SETTING_BRIDGE_MAX_AGE, (guint) (lnk->max_age / 100),
+		              NM_SETTING_BRIDGE_AGEING_TIME, (guint) (lnk->ageing_time / 100),
+		              NM_SETTING_BRIDGE_GROUP_FORWARD_MASK, (guint) lnk->group_fwd_mask,
+		              NM_SETTING_BRIDGE_MULTICAST_SNOOPING, (gboolean) lnk->mcast_snooping,
+		              NULL);
+		return;
+	}
+
 	for (option = master_options; option->name; option++) {
 		gs_free char *str = nm_platform_sysctl_master_get_option (nm_device_get_platform (device), ifindex, option->sysname);
 		int value;
@@ -99,6 +99,8 @@ void nm_device_recheck_available_connections (NMDevice *device);
 void nm_device_master_check_slave_physical_port (NMDevice *self, NMDevice *slave,
                                                  NMLogDomain log_domain);
 
+gboolean nm_device_master_has_pending_slaves (NMDevice *self, NMDevice *exclude);
+
 void nm_device_set_carrier (NMDevice *self, gboolean carrier);
 
 void nm_device_queue_recheck_assume (NMDevice *device);
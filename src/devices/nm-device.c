@@ -1149,9 +1149,12 @@ nm_device_ipv4_sysctl_set (NMDevice *self, const char *property, const char *val
 		value_to_set = value_to_free;
 	}
 
-	return nm_platform_sysctl_set (platform,
-	                               NMP_SYSCTL_PATHID_ABSOLUTE (nm_utils_sysctl_ip_conf_path (AF_INET, buf, nm_device_get_ip_iface (self), property)),
-	                               value_to_set);
+	return nm_platform_sysctl_ip_conf_set (platform,
+	                                       AF_INET,
+	                                       nm_device_get_ip_ifindex (self),
+	                                       nm_device_get_ip_iface (self),
+	                                       property,
+	                                       value_to_set);
 }
 
 static guint32
@@ -1168,15 +1171,15 @@ nm_device_ipv4_sysctl_get_effective_uint32 (NMDevice *self, const char *property
 	 *
 	 * Also do that, by reading both sysctls and return the maximum. */
 
-	v = nm_platform_sysctl_get_int_checked (nm_device_get_platform (self),
-	                                        NMP_SYSCTL_PATHID_ABSOLUTE (nm_utils_sysctl_ip_conf_path (AF_INET,
-	                                                                                                  buf,
-	                                                                                                  nm_device_get_ip_iface (self),
-	                                                                                                  property)),
-	                                        10,
-	                                        0,
-	                                        G_MAXUINT32,
-	                                        -1);
+	v = nm_platform_sysctl_ip_conf_get_int_checked (nm_device_get_platform (self),
+	                                                AF_INET,
+	                                                nm_device_get_ip_ifindex (self),
+	                                                nm_device_get_ip_iface (self),
+	                                                property,
+	                                                10,
+	                                                0,
+	                                                G_MAXUINT32,
+	                                                -1);
 
 	v_all = nm_platform_sysctl_get_int_checked (nm_device_get_platform (self),
 	                                            NMP_SYSCTL_PATHID_ABSOLUTE (nm_utils_sysctl_ip_conf_path (AF_INET,
@@ -1195,28 +1198,32 @@ nm_device_ipv4_sysctl_get_effective_uint32 (NMDevice *self, const char *property
 gboolean
 nm_device_ipv6_sysctl_set (NMDevice *self, const char *property, const char *value)
 {
-	char buf[NM_UTILS_SYSCTL_IP_CONF_PATH_BUFSIZE];
-
 	if (!nm_device_get_ip_ifindex (self))
 		return FALSE;
 
-	return nm_platform_sysctl_set (nm_device_get_platform (self), NMP_SYSCTL_PATHID_ABSOLUTE (nm_utils_sysctl_ip_conf_path (AF_INET6, buf, nm_device_get_ip_iface (self), property)), value);
+	return nm_platform_sysctl_ip_conf_set (nm_device_get_platform (self),
+	                                       AF_INET6,
+	                                       nm_device_get_ip_ifindex (self),
+	                                       nm_device_get_ip_iface (self),
+	                                       property,
+	                                       value);
 }
 
 static guint32
 nm_device_ipv6_sysctl_get_uint32 (NMDevice *self, const char *property, guint32 fallback)
 {
-	char buf[NM_UTILS_SYSCTL_IP_CONF_PATH_BUFSIZE];
-
 	if (!nm_device_get_ip_ifindex (self))
 		return fallback;
 
-	return nm_platform_sysctl_get_int_checked (nm_device_get_platform (self),
-	                                           NMP_SYSCTL_PATHID_ABSOLUTE (nm_utils_sysctl_ip_conf_path (AF_INET6, buf, nm_device_get_ip_iface (self), property)),
-	                                           10,
-	                                           0,
-	                                           G_MAXUINT32,
-	                                           fallback);
+	return nm_platform_sysctl_ip_conf_get_int_checked (nm_device_get_platform (self),
+	                                                   AF_INET6,
+	                                                   nm_device_get_ip_ifindex (self),
+	                                                   nm_device_get_ip_iface (self),
+	                                                   property,
+	                                                   10,
+	                                                   0,
+	                                                   G_MAXUINT32,
+	                                                   fallback);
 }
 
 gboolean
@@ -2481,12 +2488,15 @@ concheck_is_possible (NMDevice *self)
 	return TRUE;
 }
 
+#define CONCHECK_P_JITTER_FRACTION 8
+#define CONCHECK_P_JITTER_MAX_MS   10000
+
 static gboolean
 concheck_periodic_schedule_do (NMDevice *self, gint64 now_ns)
 {
 	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (self);
 	gboolean periodic_check_disabled = FALSE;
-	gint64 expiry, tdiff;
+	gint64 expiry, tdiff, jitter_ms;
 
 	/* we always cancel whatever was pending. */
 	if (nm_clear_g_source (&priv->concheck_p_cur_id))
@@ -2510,12 +2520,21 @@ concheck_periodic_schedule_do (NMDevice *self, gint64 now_ns)
 	expiry = priv->concheck_p_cur_basetime_ns + (priv->concheck_p_cur_interval * NM_UTILS_NS_PER_SECOND);
 	tdiff = expiry - now_ns;
 
+	/* delay the timeout by a random fraction of the interval, so that devices
+	 * that got configured at the same time don't all probe at the same instant.
+	 * The jitter only affects the timer, not cur-basetime, so it does not
+	 * accumulate over subsequent checks. */
+	jitter_ms = NM_MIN ((gint64) priv->concheck_p_cur_interval * 1000 / CONCHECK_P_JITTER_FRACTION,
+	                    CONCHECK_P_JITTER_MAX_MS);
+	if (jitter_ms > 0)
+		jitter_ms = g_random_int_range (0, jitter_ms + 1);
+
 	_LOGT (LOGD_CONCHECK, "connectivity: periodic-check: %sscheduled in %lld milliseconds (%u seconds interval)",
 	       periodic_check_disabled ? "re-" : "",
-	       (long long) (tdiff / NM_UTILS_NS_PER_MSEC),
+	       (long long) (NM_MAX ((gint64) 0, tdiff) / NM_UTILS_NS_PER_MSEC + jitter_ms),
 	       priv->concheck_p_cur_interval);
 
-	priv->concheck_p_cur_id = g_timeout_add (NM_MAX ((gint64) 0, tdiff) / NM_UTILS_NS_PER_MSEC,
+	priv->concheck_p_cur_id = g_timeout_add (NM_MAX ((gint64) 0, tdiff) / NM_UTILS_NS_PER_MSEC + jitter_ms,
 	                                         concheck_periodic_timeout_cb,
 	                                         self);
 	return TRUE;
@@ -3136,6 +3155,8 @@ nm_device_master_release_one_slave (NMDevice *self, NMDevice *slave, gboolean co
 	/* first, let subclasses handle the release ... */
 	if (info->slave_is_enslaved)
 		NM_DEVICE_GET_CLASS (self)->release_slave (self, slave, configure);
+	else if (NM_DEVICE_GET_CLASS (self)->release_pending_slave)
+		NM_DEVICE_GET_CLASS (self)->release_pending_slave (self, slave);
 
 	/* raise notifications about the release, including clearing is_enslaved. */
 	nm_device_slave_notify_release (slave, reason);
@@ -4746,6 +4767,30 @@ nm_device_master_check_slave_physical_port (NMDevice *self, NMDevice *slave,
 	}
 }
 
+/**
+ * nm_device_master_has_pending_slaves:
+ * @self: the master device
+ * @exclude: (allow-none): a slave device to ignore
+ *
+ * Returns: %TRUE if @self has slaves other than @exclude that are registered
+ *   but not yet enslaved.
+ */
+gboolean
+nm_device_master_has_pending_slaves (NMDevice *self, NMDevice *exclude)
+{
+	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (self);
+	SlaveInfo *info;
+	CList *iter;
+
+	c_list_for_each (iter, &priv->slaves) {
+		info = c_list_entry (iter, SlaveInfo, lst_slave);
+		if (   info->slave != exclude
+		    && !info->slave_is_enslaved)
+			return TRUE;
+	}
+	return FALSE;
+}
+
 /* release all slaves */
 static void
 nm_device_master_release_slaves (NMDevice *self)
@@ -9066,6 +9111,43 @@ nm_device_commit_mtu (NMDevice *self)
 		_LOGT (LOGD_DEVICE, "mtu: commit-mtu... skip due to state %s", nm_device_state_to_str (state));
 }
 
+static void
+ndisc_refresh_lifetimes (NMDevice *self, const NMNDiscData *rdata)
+{
+	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (self);
+	gs_unref_ptrarray GPtrArray *refreshed = NULL;
+	gint32 now;
+	guint i;
+
+	if (!nm_ip6_config_refresh_lifetimes_ndisc (priv->ip_config_6,
+	                                            rdata->addresses,
+	                                            rdata->addresses_n,
+	                                            &refreshed))
+		return;
+
+	/* the addresses are already configured. Only bump their lifetimes in
+	 * the kernel, instead of syncing the entire configuration. */
+	now = nm_utils_get_monotonic_timestamp_s ();
+	for (i = 0; i < refreshed->len; i++) {
+		const NMPlatformIP6Address *a = NMP_OBJECT_CAST_IP6_ADDRESS (refreshed->pdata[i]);
+		guint32 lifetime, preferred;
+
+		lifetime = nm_utils_lifetime_get (a->timestamp, a->lifetime, a->preferred,
+		                                  now, &preferred);
+		if (!lifetime)
+			continue;
+
+		nm_platform_ip6_address_add (nm_device_get_platform (self),
+		                             a->ifindex,
+		                             a->address,
+		                             a->plen,
+		                             a->peer_address,
+		                             lifetime,
+		                             preferred,
+		                             a->n_ifa_flags);
+	}
+}
+
 static void
 ndisc_config_changed (NMNDisc *ndisc, const NMNDiscData *rdata, guint changed_int, NMDevice *self)
 {
@@ -9078,7 +9160,8 @@ ndisc_config_changed (NMNDisc *ndisc, const NMNDiscData *rdata, guint changed_in
 	if (!applied_config_get_current (&priv->ac_ip6_config))
 		applied_config_init_new (&priv->ac_ip6_config, self, AF_INET6);
 
-	if (changed & NM_NDISC_CONFIG_ADDRESSES) {
+	if (NM_FLAGS_ANY (changed,   NM_NDISC_CONFIG_ADDRESSES
+	                           | NM_NDISC_CONFIG_LIFETIMES)) {
 		guint8 plen;
 		guint32 ifa_flags;
 
@@ -9180,6 +9263,14 @@ ndisc_config_changed (NMNDisc *ndisc, const NMNDiscData *rdata, guint changed_in
 		}
 	}
 
+	if (   changed == NM_NDISC_CONFIG_LIFETIMES
+	    && priv->ip6_state == IP_DONE
+	    && priv->ip_config_6) {
+		/* a periodic RA that only refreshed lifetimes. Nothing to merge. */
+		ndisc_refresh_lifetimes (self, rdata);
+		return;
+	}
+
 	nm_device_activate_schedule_ip6_config_result (self);
 }
 
@@ -385,6 +385,11 @@ typedef struct _NMDeviceClass {
 	                                   NMDevice *slave,
 	                                   gboolean configure);
 
+	/* Called instead of release_slave() for a slave that gets removed
+	 * before it was enslaved, for example because it failed to activate. */
+	void            (* release_pending_slave) (NMDevice *self,
+	                                           NMDevice *slave);
+
 	void            (* parent_changed_notify) (NMDevice *self,
 	                                           int old_ifindex,
 	                                           NMDevice *old_parent,
@@ -83,6 +83,9 @@ typedef struct {
 	guint         ratelimit_id;
 
 	GVariant     *variant;
+
+	/* the neighbor variants that @variant was built from. */
+	GPtrArray    *variant_children;
 } NMLldpListenerPrivate;
 
 struct _NMLldpListener {
@@ -110,6 +113,10 @@ typedef struct {
 
 	bool valid:1;
 
+	/* hash over all fields, to quickly tell apart neighbors whose
+	 * content differs. See lldp_neighbor_content_hash(). */
+	guint content_hash;
+
 	LldpAttrData attrs[_LLDP_PROP_ID_COUNT];
 
 	GVariant *variant;
@@ -332,6 +339,38 @@ lldp_neighbor_freep (LldpNeighbor **ptr)
 	lldp_neighbor_free (*ptr);
 }
 
+static guint
+lldp_neighbor_content_hash (const LldpNeighbor *neigh)
+{
+	LldpAttrId attr_id;
+	NMHashState h;
+
+	nm_hash_init (&h, 1279211771u);
+	nm_hash_update_str0 (&h, neigh->chassis_id);
+	nm_hash_update_str0 (&h, neigh->port_id);
+	nm_hash_update_vals (&h,
+	                     neigh->chassis_id_type,
+	                     neigh->port_id_type,
+	                     (bool) neigh->valid);
+	nm_hash_update (&h, &neigh->destination_address, sizeof (neigh->destination_address));
+	for (attr_id = 0; attr_id < _LLDP_PROP_ID_COUNT; attr_id++) {
+		const LldpAttrData *data = &neigh->attrs[attr_id];
+
+		nm_hash_update_val (&h, data->attr_type);
+		switch (data->attr_type) {
+		case LLDP_ATTR_TYPE_UINT32:
+			nm_hash_update_val (&h, data->v_uint32);
+			break;
+		case LLDP_ATTR_TYPE_STRING:
+			nm_hash_update_str (&h, data->v_string);
+			break;
+		default:
+			break;
+		}
+	}
+	return nm_hash_complete (&h);
+}
+
 static gboolean
 lldp_neighbor_equal (LldpNeighbor *a, LldpNeighbor *b)
 {
@@ -340,9 +379,12 @@ lldp_neighbor_equal (LldpNeighbor *a, LldpNeighbor *b)
 	nm_assert (a);
 	nm_assert (b);
 
+	if (a->content_hash != b->content_hash)
+		return FALSE;
+
 	if (   a->chassis_id_type != b->chassis_id_type
 	    || a->port_id_type != b->port_id_type
-	    || ether_addr_equal (&a->destination_address, &b->destination_address)
+	    || !ether_addr_equal (&a->destination_address, &b->destination_address)
 	    || !nm_streq0 (a->chassis_id, b->chassis_id)
 	    || !nm_streq0 (a->port_id, b->port_id))
 		return FALSE;
@@ -550,6 +592,7 @@ lldp_neighbor_new (sd_lldp_neighbor *neighbor_sd, GError **error)
 	neigh->valid = TRUE;
 
 out:
+	neigh->content_hash = lldp_neighbor_content_hash (neigh);
 	return g_steal_pointer (&neigh);
 }
 
@@ -617,10 +660,75 @@ lldp_neighbor_to_variant (LldpNeighbor *neigh)
 
 /*****************************************************************************/
 
+static GVariant *
+neighbors_to_variant (NMLldpListenerPrivate *priv, GVariant *old_variant)
+{
+	GVariantBuilder array_builder;
+	gs_free LldpNeighbor **neighbors = NULL;
+	guint i, n;
+
+	neighbors = (LldpNeighbor **) nm_utils_hash_keys_to_array (priv->lldp_neighbors,
+	                                                           lldp_neighbor_id_cmp_p,
+	                                                           NULL,
+	                                                           &n);
+
+	if (   old_variant
+	    && priv->variant_children
+	    && priv->variant_children->len == n) {
+		/* check whether the neighbors are the same as we exported the last time.
+		 * Don't compare with the children of @old_variant: once it was serialized
+		 * for D-Bus, it returns new instances for them. Compare with the variants
+		 * it was built from instead, which unchanged neighbors still share. */
+		for (i = 0; i < n; i++) {
+			GVariant *old_child = priv->variant_children->pdata[i];
+			GVariant *child = lldp_neighbor_to_variant (neighbors[i]);
+
+			if (old_child == child)
+				continue;
+			if (!g_variant_equal (old_child, child))
+				break;
+
+			/* the neighbor was replaced by an equal one. Remember its variant,
+			 * so that the next time the pointers match. */
+			g_variant_unref (old_child);
+			priv->variant_children->pdata[i] = g_variant_ref (child);
+		}
+		if (i == n)
+			return g_variant_ref (old_variant);
+	}
+
+	if (priv->variant_children)
+		g_ptr_array_set_size (priv->variant_children, 0);
+	else
+		priv->variant_children = g_ptr_array_new_with_free_func ((GDestroyNotify) g_variant_unref);
+
+	g_variant_builder_init (&array_builder, G_VARIANT_TYPE ("aa{sv}"));
+	for (i = 0; i < n; i++) {
+		GVariant *child = lldp_neighbor_to_variant (neighbors[i]);
+
+		g_variant_builder_add_value (&array_builder, child);
+		g_ptr_array_add (priv->variant_children, g_variant_ref (child));
+	}
+	return g_variant_ref_sink (g_variant_builder_end (&array_builder));
+}
+
 static void
 data_changed_notify (NMLldpListener *self, NMLldpListenerPrivate *priv)
 {
-	nm_clear_g_variant (&priv->variant);
+	gs_unref_variant GVariant *old_variant = NULL;
+
+	old_variant = g_steal_pointer (&priv->variant);
+	if (old_variant) {
+		/* when neighbors got refreshed or changed back within the rate-limit
+		 * interval, the exported list is still the same. Don't emit a property
+		 * change in that case. */
+		priv->variant = neighbors_to_variant (priv, old_variant);
+		if (priv->variant == old_variant) {
+			_LOGT ("neighbors unchanged, suppress update");
+			return;
+		}
+	}
+
 	_notify (self, PROP_NEIGHBORS);
 }
 
@@ -845,20 +953,8 @@ nm_lldp_listener_get_neighbors (NMLldpListener *self)
 
 	priv = NM_LLDP_LISTENER_GET_PRIVATE (self);
 
-	if (G_UNLIKELY (!priv->variant)) {
-		GVariantBuilder array_builder;
-		gs_free LldpNeighbor **neighbors = NULL;
-		guint i, n;
-
-		g_variant_builder_init (&array_builder, G_VARIANT_TYPE ("aa{sv}"));
-		neighbors = (LldpNeighbor **) nm_utils_hash_keys_to_array (priv->lldp_neighbors,
-		                                                           lldp_neighbor_id_cmp_p,
-		                                                           NULL,
-		                                                           &n);
-		for (i = 0; i < n; i++)
-			g_variant_builder_add_value (&array_builder, lldp_neighbor_to_variant (neighbors[i]));
-		priv->variant = g_variant_ref_sink (g_variant_builder_end (&array_builder));
-	}
+	if (G_UNLIKELY (!priv->variant))
+		priv->variant = neighbors_to_variant (priv, NULL);
 	return priv->variant;
 }
 
@@ -914,6 +1010,7 @@ finalize (GObject *object)
 	g_hash_table_unref (priv->lldp_neighbors);
 
 	nm_clear_g_variant (&priv->variant);
+	g_clear_pointer (&priv->variant_children, g_ptr_array_unref);
 
 	_LOGT ("lldp listener destroyed");
 
@@ -70,8 +70,11 @@ typedef struct {
 	GSocketConnection *conn;
 	GCancellable *cancellable;
 	char buf[4096];                 /* Input buffer */
-	size_t bufp;                    /* Last decoded byte in the input buffer. */
 	GString *input;                 /* JSON stream waiting for decoding. */
+	gsize scan_pos;                 /* Bytes of input already scanned for message boundaries. */
+	guint scan_depth;               /* Nesting level of the message being scanned. */
+	bool scan_in_string:1;
+	bool scan_escaped:1;
 	GString *output;                /* JSON stream to be sent. */
 	gint64 seq;
 	GArray *calls;                  /* Method calls waiting for a response. */
@@ -126,6 +129,7 @@ typedef struct {
 	OvsdbCommand command;
 	OvsdbMethodCallback callback;
 	gpointer user_data;
+	bool no_batch;                          /* a merged transaction failed, retry alone */
 	union {
 		char *ifname;
 		struct {
@@ -198,6 +202,7 @@ ovsdb_call_method (NMOvsdb *self, OvsdbCommand command,
 	call->command = command;
 	call->callback = callback;
 	call->user_data = user_data;
+	call->no_batch = FALSE;
 
 	switch (call->command) {
 	case OVSDB_MONITOR:
@@ -338,7 +343,7 @@ _set_port_interfaces (json_t *params, const char *ifname, json_t *new_interfaces
  * Returns an commands that adds new interface from a given connection.
  */
 static void
-_insert_interface (json_t *params, NMConnection *interface)
+_insert_interface (json_t *params, NMConnection *interface, const char *uuid_name)
 {
 	const char *type = NULL;
 	NMSettingOvsInterface *s_ovs_iface;
@@ -366,7 +371,7 @@ _insert_interface (json_t *params, NMConnection *interface)
 		           "type", type ?: "",
 		           "options", options,
 		           "external_ids", "map", "NM.connection.uuid", nm_connection_get_uuid (interface),
-		           "uuid-name", "rowInterface"));
+		           "uuid-name", uuid_name));
 }
 
 /**
@@ -375,7 +380,7 @@ _insert_interface (json_t *params, NMConnection *interface)
  * Returns an commands that adds new port from a given connection.
  */
 static void
-_insert_port (json_t *params, NMConnection *port, json_t *new_interfaces)
+_insert_port (json_t *params, NMConnection *port, json_t *new_interfaces, const char *uuid_name)
 {
 	NMSettingOvsPort *s_ovs_port;
 	const char *vlan_mode = NULL;
@@ -421,7 +426,7 @@ _insert_port (json_t *params, NMConnection *port, json_t *new_interfaces)
 	/* Create a new one. */
 	json_array_append_new (params,
 		json_pack ("{s:s, s:s, s:o, s:s}", "op", "insert", "table", "Port",
-		           "row", row, "uuid-name", "rowPort"));
+		           "row", row, "uuid-name", uuid_name));
 }
 
 /**
@@ -487,14 +492,15 @@ _inc_next_cfg (const char *db_uuid)
 }
 
 /**
- * _add_interface:
+ * _add_interfaces:
  *
- * Adds an interface as specified by @interface connection, optionally creating
- * a parent @port and @bridge if needed.
+ * Adds the interfaces as specified by the @calls, optionally creating
+ * their parent ports and the @bridge if needed. All calls share the same
+ * bridge and have distinct ports (see _calls_can_batch()).
  */
 static void
-_add_interface (NMOvsdb *self, json_t *params,
-                NMConnection *bridge, NMConnection *port, NMConnection *interface)
+_add_interfaces (NMOvsdb *self, json_t *params, NMConnection *bridge,
+                 const OvsdbMethodCall *const*calls, guint n_calls)
 {
 	NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE (self);
 	GHashTableIter iter;
@@ -502,40 +508,86 @@ _add_interface (NMOvsdb *self, json_t *params,
 	const char *port_uuid;
 	const char *interface_uuid;
 	OpenvswitchBridge *ovs_bridge = NULL;
-	OpenvswitchPort *ovs_port = NULL;
-	OpenvswitchInterface *ovs_interface = NULL;
+	OpenvswitchBridge *b;
+	OpenvswitchPort *ovs_port;
+	OpenvswitchInterface *ovs_interface;
 	int pi;
 	int ii;
+	guint i;
 	json_t *bridges, *new_bridges;
 	json_t *ports, *new_ports;
 	json_t *interfaces, *new_interfaces;
-	gboolean has_interface = FALSE;
+	gboolean has_interface;
+	gboolean ports_changed = FALSE;
 
 	bridges = json_array ();
 	ports = json_array ();
-	interfaces = json_array ();
 	new_bridges = json_array ();
 	new_ports = json_array ();
-	new_interfaces = json_array ();
 
 	g_hash_table_iter_init (&iter, priv->bridges);
-	while (g_hash_table_iter_next (&iter, (gpointer) &bridge_uuid, (gpointer) &ovs_bridge)) {
+	while (g_hash_table_iter_next (&iter, (gpointer) &bridge_uuid, (gpointer) &b)) {
 		json_array_append_new (bridges, json_pack ("[s, s]", "uuid", bridge_uuid));
 
-		if (   g_strcmp0 (ovs_bridge->name, nm_connection_get_interface_name (bridge)) != 0
-		    || g_strcmp0 (ovs_bridge->connection_uuid, nm_connection_get_uuid (bridge)) != 0)
-			continue;
+		if (   !ovs_bridge
+		    && g_strcmp0 (b->name, nm_connection_get_interface_name (bridge)) == 0
+		    && g_strcmp0 (b->connection_uuid, nm_connection_get_uuid (bridge)) == 0)
+			ovs_bridge = b;
+	}
 
+	if (ovs_bridge) {
 		for (pi = 0; pi < ovs_bridge->ports->len; pi++) {
 			port_uuid = g_ptr_array_index (ovs_bridge->ports, pi);
-			ovs_port = g_hash_table_lookup (priv->ports, port_uuid);
-
 			json_array_append_new (ports, json_pack ("[s, s]", "uuid", port_uuid));
+		}
+	}
 
-			if (   g_strcmp0 (ovs_port->name, nm_connection_get_interface_name (port)) != 0
-			    || g_strcmp0 (ovs_port->connection_uuid, nm_connection_get_uuid (port)) != 0)
-				continue;
+	json_array_extend (new_bridges, bridges);
+	json_array_extend (new_ports, ports);
 
+	if (!ovs_bridge) {
+		/* Need to create a bridge. */
+		_expect_ovs_bridges (params, priv->db_uuid, bridges);
+		json_array_append_new (new_bridges, json_pack ("[s, s]", "named-uuid", "rowBridge"));
+		_set_ovs_bridges (params, priv->db_uuid, new_bridges);
+		_insert_bridge (params, bridge, new_ports);
+	}
+
+	for (i = 0; i < n_calls; i++) {
+		NMConnection *port = calls[i]->port;
+		NMConnection *interface = calls[i]->interface;
+		char row_port[64];
+		char row_interface[64];
+
+		nm_sprintf_buf (row_port, "rowPort%u", i);
+		nm_sprintf_buf (row_interface, "rowInterface%u", i);
+
+		ovs_port = NULL;
+		if (ovs_bridge) {
+			for (pi = 0; pi < ovs_bridge->ports->len; pi++) {
+				OpenvswitchPort *p;
+
+				port_uuid = g_ptr_array_index (ovs_bridge->ports, pi);
+				p = g_hash_table_lookup (priv->ports, port_uuid);
+				if (   g_strcmp0 (p->name, nm_connection_get_interface_name (port)) == 0
+				    && g_strcmp0 (p->connection_uuid, nm_connection_get_uuid (port)) == 0) {
+					ovs_port = p;
+					break;
+				}
+			}
+		}
+
+		interfaces = json_array ();
+		new_interfaces = json_array ();
+		has_interface = FALSE;
+
+		if (!ovs_port) {
+			/* Need to create a port. */
+			json_array_append_new (new_ports, json_pack ("[s, s]", "named-uuid", row_port));
+			_insert_port (params, port, new_interfaces, row_port);
+			ports_changed = TRUE;
+		} else {
+			/* Port already exists */
 			for (ii = 0; ii < ovs_port->interfaces->len; ii++) {
 				interface_uuid = g_ptr_array_index (ovs_port->interfaces, ii);
 				ovs_interface = g_hash_table_lookup (priv->interfaces, interface_uuid);
@@ -546,63 +598,42 @@ _add_interface (NMOvsdb *self, json_t *params,
 				    && g_strcmp0 (ovs_interface->connection_uuid, nm_connection_get_uuid (interface)) == 0)
 					has_interface = TRUE;
 			}
+			json_array_extend (new_interfaces, interfaces);
 
-			break;
+			_expect_port_interfaces (params, ovs_port->name, interfaces);
+			_set_port_interfaces (params, nm_connection_get_interface_name (port), new_interfaces);
 		}
 
-		break;
-	}
-
-	json_array_extend (new_bridges, bridges);
-	json_array_extend (new_ports, ports);
-	json_array_extend (new_interfaces, interfaces);
-
-	if (json_array_size (interfaces) == 0) {
-		/* Need to create a port. */
-		if (json_array_size (ports) == 0) {
-			/* Need to create a bridge. */
-			_expect_ovs_bridges (params, priv->db_uuid, bridges);
-			json_array_append_new (new_bridges, json_pack ("[s, s]", "named-uuid", "rowBridge"));
-			_set_ovs_bridges (params, priv->db_uuid, new_bridges);
-			_insert_bridge (params, bridge, new_ports);
-		} else {
-			/* Bridge already exists. */
-			g_return_if_fail (ovs_bridge);
-			_expect_bridge_ports (params, ovs_bridge->name, ports);
-			_set_bridge_ports (params, nm_connection_get_interface_name (bridge), new_ports);
+		if (!has_interface) {
+			_insert_interface (params, interface, row_interface);
+			json_array_append_new (new_interfaces, json_pack ("[s, s]", "named-uuid", row_interface));
 		}
 
-		json_array_append_new (new_ports, json_pack ("[s, s]", "named-uuid", "rowPort"));
-		_insert_port (params, port, new_interfaces);
-	} else {
-		/* Port already exists */
-		g_return_if_fail (ovs_port);
-		_expect_port_interfaces (params, ovs_port->name, interfaces);
-		_set_port_interfaces (params, nm_connection_get_interface_name (port), new_interfaces);
+		json_decref (interfaces);
+		json_decref (new_interfaces);
 	}
 
-	if (!has_interface) {
-		_insert_interface (params, interface);
-		json_array_append_new (new_interfaces, json_pack ("[s, s]", "named-uuid", "rowInterface"));
+	if (ovs_bridge && ports_changed) {
+		/* Bridge already exists. */
+		_expect_bridge_ports (params, ovs_bridge->name, ports);
+		_set_bridge_ports (params, nm_connection_get_interface_name (bridge), new_ports);
 	}
 
-	json_decref (interfaces);
 	json_decref (ports);
 	json_decref (bridges);
 
-	json_decref (new_interfaces);
 	json_decref (new_ports);
 	json_decref (new_bridges);
 }
 
 /**
- * _delete_interface:
+ * _delete_interfaces:
  *
- * Removes an interface of @ifname name, collecting empty ports and bridge
- * if last item is removed from them.
+ * Removes the interfaces named in @ifnames, collecting empty ports and
+ * bridges if last item is removed from them.
  */
 static void
-_delete_interface (NMOvsdb *self, json_t *params, const char *ifname)
+_delete_interfaces (NMOvsdb *self, json_t *params, GHashTable *ifnames)
 {
 	NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE (self);
 	GHashTableIter iter;
@@ -649,7 +680,7 @@ _delete_interface (NMOvsdb *self, json_t *params, const char *ifname)
 
 				json_array_append_new (interfaces, json_pack ("[s,s]", "uuid", interface_uuid));
 
-				if (strcmp (ovs_interface->name, ifname) == 0) {
+				if (g_hash_table_contains (ifnames, ovs_interface->name)) {
 					/* skip the interface */
 					interfaces_changed = TRUE;
 					continue;
@@ -690,23 +721,85 @@ _delete_interface (NMOvsdb *self, json_t *params, const char *ifname)
 		_expect_ovs_bridges (params, priv->db_uuid, bridges);
 		_set_ovs_bridges (params, priv->db_uuid, new_bridges);
 	}
+
+	json_decref (bridges);
+	json_decref (new_bridges);
+}
+
+/**
+ * _calls_can_batch:
+ *
+ * Whether @call can be sent in the same transaction as the @n_batch calls
+ * in @batch. Deletions can always be merged. Additions can be merged if they
+ * are for the same bridge and don't touch the same port or interface, so
+ * that the commands of one call never depend on the result of another.
+ *
+ * A transaction is atomic, so the merged calls share its fate: if one of
+ * them fails, none of them is committed. ovsdb_got_msg() then requeues
+ * them with @no_batch set, and each one is retried in a transaction of
+ * its own, so that only the offending call reports the error.
+ */
+static gboolean
+_calls_can_batch (const OvsdbMethodCall *const*batch, guint n_batch, const OvsdbMethodCall *call)
+{
+	guint i;
+
+	if (call->id != COMMAND_PENDING)
+		return FALSE;
+	if (call->no_batch || batch[0]->no_batch)
+		return FALSE;
+	if (call->command != batch[0]->command)
+		return FALSE;
+
+	switch (call->command) {
+	case OVSDB_MONITOR:
+		return FALSE;
+	case OVSDB_DEL_INTERFACE:
+		return TRUE;
+	case OVSDB_ADD_INTERFACE:
+		if (   !nm_streq0 (nm_connection_get_interface_name (call->bridge),
+		                   nm_connection_get_interface_name (batch[0]->bridge))
+		    || !nm_streq0 (nm_connection_get_uuid (call->bridge),
+		                   nm_connection_get_uuid (batch[0]->bridge)))
+			return FALSE;
+		for (i = 0; i < n_batch; i++) {
+			if (   nm_streq0 (nm_connection_get_interface_name (call->port),
+			                  nm_connection_get_interface_name (batch[i]->port))
+			    || nm_streq0 (nm_connection_get_interface_name (call->interface),
+			                  nm_connection_get_interface_name (batch[i]->interface)))
+				return FALSE;
+		}
+		return TRUE;
+	}
+
+	return FALSE;
 }
 
+/* Upper limit of calls that get merged into one transaction. */
+#define BATCH_MAX 256
+
 /**
  * ovsdb_next_command:
  *
  * Translates a higher level operation (add/remove bridge/port) to a RFC 7047
  * command serialized into JSON ands sends it over to the database.
-
+ *
  * Only called when no command is waiting for a response, since the serialized
  * command might depend on result of a previous one (add and remove need to
  * include an up to date bridge list in their transactions to rule out races).
+ * To still avoid a round trip per operation, consecutive queued calls that
+ * don't depend on each other are merged into one transaction. They share
+ * the same id and get completed together, unless the transaction fails (see
+ * _calls_can_batch()).
  */
 static void
 ovsdb_next_command (NMOvsdb *self)
 {
 	NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE (self);
+	const OvsdbMethodCall *batch[BATCH_MAX];
 	OvsdbMethodCall *call = NULL;
+	guint n_batch;
+	guint i;
 	char *cmd;
 	json_t *msg = NULL;
 	json_t *params;
@@ -718,7 +811,21 @@ ovsdb_next_command (NMOvsdb *self)
 	call = &g_array_index (priv->calls, OvsdbMethodCall, 0);
 	if (call->id != COMMAND_PENDING)
 		return;
+
+	batch[0] = call;
+	n_batch = 1;
+	while (   n_batch < priv->calls->len
+	       && n_batch < G_N_ELEMENTS (batch)) {
+		const OvsdbMethodCall *c = &g_array_index (priv->calls, OvsdbMethodCall, n_batch);
+
+		if (!_calls_can_batch (batch, n_batch, c))
+			break;
+		batch[n_batch++] = c;
+	}
+
 	call->id = priv->seq++;
+	for (i = 1; i < n_batch; i++)
+		g_array_index (priv->calls, OvsdbMethodCall, i).id = call->id;
 
 	switch (call->command) {
 	case OVSDB_MONITOR:
@@ -740,27 +847,35 @@ ovsdb_next_command (NMOvsdb *self)
 		json_array_append_new (params, json_string ("Open_vSwitch"));
 		json_array_append_new (params, _inc_next_cfg (priv->db_uuid));
 
-		_add_interface (self, params, call->bridge, call->port, call->interface);
+		_add_interfaces (self, params, call->bridge, batch, n_batch);
 
 		msg = json_pack ("{s:i, s:s, s:o}",
 		                 "id", call->id,
 		                 "method", "transact", "params", params);
 		break;
-	case OVSDB_DEL_INTERFACE:
+	case OVSDB_DEL_INTERFACE: {
+		gs_unref_hashtable GHashTable *ifnames = NULL;
+
+		ifnames = g_hash_table_new (nm_str_hash, g_str_equal);
+		for (i = 0; i < n_batch; i++)
+			g_hash_table_add (ifnames, batch[i]->ifname);
+
 		params = json_array ();
 		json_array_append_new (params, json_string ("Open_vSwitch"));
 		json_array_append_new (params, _inc_next_cfg (priv->db_uuid));
 
-		_delete_interface (self, params, call->ifname);
+		_delete_interfaces (self, params, ifnames);
 
 		msg = json_pack ("{s:i, s:s, s:o}",
 		                 "id", call->id,
 		                 "method", "transact", "params", params);
 		break;
 	}
+	}
 
 	g_return_if_fail (msg);
-	_call_trace ("send", call, msg);
+	for (i = 0; i < n_batch; i++)
+		_call_trace ("send", (OvsdbMethodCall *) batch[i], i == 0 ? msg : NULL);
 	cmd = json_dumps (msg, 0);
 
 	g_string_append (priv->output, cmd);
@@ -828,12 +943,49 @@ _connection_uuid_from_external_ids (json_t *external_ids)
 	return NULL;
 }
 
+static gboolean
+_row_update_str (char **dst, const char *src)
+{
+	if (g_strcmp0 (*dst, src) == 0)
+		return FALSE;
+	g_free (*dst);
+	*dst = g_strdup (src);
+	return TRUE;
+}
+
+static gboolean
+_row_update_connection_uuid (char **dst, const json_t *external_ids)
+{
+	char *connection_uuid;
+
+	connection_uuid = _connection_uuid_from_external_ids ((json_t *) external_ids);
+	if (g_strcmp0 (*dst, connection_uuid) == 0) {
+		g_free (connection_uuid);
+		return FALSE;
+	}
+	g_free (*dst);
+	*dst = connection_uuid;
+	return TRUE;
+}
+
+static void
+_row_update_uuids (GPtrArray *array, const json_t *items)
+{
+	g_ptr_array_set_size (array, 0);
+	_uuids_to_array (array, items);
+}
+
 /**
  * ovsdb_got_update:
  *
  * Called when we've got an "update" method call (we asked for it with the monitor
  * command). We use it to maintain a consistent view of bridge list regardless of
  * whether the changes are done by us or externally.
+ *
+ * A modification only lists the changed columns in the "old" row. Rows that
+ * keep their name are updated in place, and a change is only announced if it
+ * touches something we track -- other controllers rewriting external_ids of
+ * their rows don't cost us more than a lookup.
  */
 static void
 ovsdb_got_update (NMOvsdb *self, json_t *msg)
@@ -845,6 +997,7 @@ ovsdb_got_update (NMOvsdb *self, json_t *msg)
 	json_t *interface = NULL;
 	json_t *items;
 	json_t *external_ids;
+	json_t *row_old;
 	json_error_t json_error = { 0, };
 	void *iter;
 	const char *name;
@@ -874,8 +1027,9 @@ ovsdb_got_update (NMOvsdb *self, json_t *msg)
 	json_object_foreach (interface, key, value) {
 		gboolean old = FALSE;
 		gboolean new = FALSE;
+		gboolean changed;
 
-		if (json_unpack (value, "{s:{}}", "old") == 0)
+		if (json_unpack (value, "{s:o}", "old", &row_old) == 0)
 			old = TRUE;
 
 		if (json_unpack (value, "{s:{s:s, s:s, s:o}}", "new",
@@ -884,6 +1038,26 @@ ovsdb_got_update (NMOvsdb *self, json_t *msg)
 		                 "external_ids", &external_ids) == 0)
 			new = TRUE;
 
+		if (old && new) {
+			ovs_interface = g_hash_table_lookup (priv->interfaces, key);
+			if (   ovs_interface
+			    && g_strcmp0 (ovs_interface->name, name) == 0) {
+				changed = FALSE;
+				if (json_object_get (row_old, "type"))
+					changed |= _row_update_str (&ovs_interface->type, type);
+				if (json_object_get (row_old, "external_ids"))
+					changed |= _row_update_connection_uuid (&ovs_interface->connection_uuid, external_ids);
+				if (changed) {
+					_LOGT ("changed an '%s' interface: %s%s%s", type, ovs_interface->name,
+					       ovs_interface->connection_uuid ? ", " : "",
+					       ovs_interface->connection_uuid ?: "");
+					g_signal_emit (self, signals[DEVICE_CHANGED], 0,
+					               "ovs-interface", ovs_interface->name);
+				}
+				continue;
+			}
+		}
+
 		if (old) {
 			ovs_interface = g_hash_table_lookup (priv->interfaces, key);
 			if (!new || g_strcmp0 (ovs_interface->name, name) != 0) {
@@ -933,8 +1107,9 @@ ovsdb_got_update (NMOvsdb *self, json_t *msg)
 	json_object_foreach (port, key, value) {
 		gboolean old = FALSE;
 		gboolean new = FALSE;
+		gboolean changed;
 
-		if (json_unpack (value, "{s:{}}", "old") == 0)
+		if (json_unpack (value, "{s:o}", "old", &row_old) == 0)
 			old = TRUE;
 
 		if (json_unpack (value, "{s:{s:s, s:o, s:o}}", "new",
@@ -943,6 +1118,28 @@ ovsdb_got_update (NMOvsdb *self, json_t *msg)
 		                 "interfaces", &items) == 0)
 			new = TRUE;
 
+		if (old && new) {
+			ovs_port = g_hash_table_lookup (priv->ports, key);
+			if (   ovs_port
+			    && g_strcmp0 (ovs_port->name, name) == 0) {
+				changed = FALSE;
+				if (json_object_get (row_old, "external_ids"))
+					changed |= _row_update_connection_uuid (&ovs_port->connection_uuid, external_ids);
+				if (json_object_get (row_old, "interfaces")) {
+					_row_update_uuids (ovs_port->interfaces, items);
+					changed = TRUE;
+				}
+				if (changed) {
+					_LOGT ("changed a port: %s%s%s", ovs_port->name,
+					       ovs_port->connection_uuid ? ", " : "",
+					       ovs_port->connection_uuid ?: "");
+					g_signal_emit (self, signals[DEVICE_CHANGED], 0,
+					               NM_SETTING_OVS_PORT_SETTING_NAME, ovs_port->name);
+				}
+				continue;
+			}
+		}
+
 		if (old) {
 			ovs_port = g_hash_table_lookup (priv->ports, key);
 			if (!new || g_strcmp0 (ovs_port->name, name) != 0) {
@@ -983,8 +1180,9 @@ ovsdb_got_update (NMOvsdb *self, json_t *msg)
 	json_object_foreach (bridge, key, value) {
 		gboolean old = FALSE;
 		gboolean new = FALSE;
+		gboolean changed;
 
-		if (json_unpack (value, "{s:{}}", "old") == 0)
+		if (json_unpack (value, "{s:o}", "old", &row_old) == 0)
 			old = TRUE;
 
 		if (json_unpack (value, "{s:{s:s, s:o, s:o}}", "new",
@@ -993,6 +1191,28 @@ ovsdb_got_update (NMOvsdb *self, json_t *msg)
 		                 "ports", &items) == 0)
 			new = TRUE;
 
+		if (old && new) {
+			ovs_bridge = g_hash_table_lookup (priv->bridges, key);
+			if (   ovs_bridge
+			    && g_strcmp0 (ovs_bridge->name, name) == 0) {
+				changed = FALSE;
+				if (json_object_get (row_old, "external_ids"))
+					changed |= _row_update_connection_uuid (&ovs_bridge->connection_uuid, external_ids);
+				if (json_object_get (row_old, "ports")) {
+					_row_update_uuids (ovs_bridge->ports, items);
+					changed = TRUE;
+				}
+				if (changed) {
+					_LOGT ("changed a bridge: %s%s%s", ovs_bridge->name,
+					       ovs_bridge->connection_uuid ? ", " : "",
+					       ovs_bridge->connection_uuid ?: "");
+					g_signal_emit (self, signals[DEVICE_CHANGED], 0,
+					               NM_SETTING_OVS_BRIDGE_SETTING_NAME, ovs_bridge->name);
+				}
+				continue;
+			}
+		}
+
 		if (old) {
 			ovs_bridge = g_hash_table_lookup (priv->bridges, key);
 			if (!new || g_strcmp0 (ovs_bridge->name, name) != 0) {
@@ -1057,6 +1277,28 @@ ovsdb_got_echo (NMOvsdb *self, json_int_t id, json_t *data)
 		ovsdb_write (self);
 }
 
+/**
+ * _transaction_failed:
+ *
+ * Whether the response to a "transact" call indicates that the transaction
+ * was aborted, either as a whole or because one of its operations failed.
+ */
+static gboolean
+_transaction_failed (json_t *result, json_t *error)
+{
+	size_t index;
+	json_t *value;
+
+	if (!json_is_null (error))
+		return TRUE;
+
+	json_array_foreach (result, index, value) {
+		if (json_object_get (value, "error"))
+			return TRUE;
+	}
+	return FALSE;
+}
+
 /**
  * ovsdb_got_msg::
  *
@@ -1130,6 +1372,25 @@ ovsdb_got_msg (NMOvsdb *self, json_t *msg)
 
 		_call_trace ("response", call, msg);
 
+		if (   priv->calls->len > 1
+		    && g_array_index (priv->calls, OvsdbMethodCall, 1).id == id
+		    && _transaction_failed (result, error)) {
+			guint i;
+
+			/* Nothing of a failed transaction got committed. Don't fail
+			 * all the merged calls, but retry each one on its own. */
+			_LOGD ("merged transaction %" G_GUINT64_FORMAT " failed, retrying its calls separately", id);
+			for (i = 0; i < priv->calls->len; i++) {
+				call = &g_array_index (priv->calls, OvsdbMethodCall, i);
+				if (call->id != id)
+					break;
+				call->id = COMMAND_PENDING;
+				call->no_batch = TRUE;
+			}
+			ovsdb_next_command (self);
+			return;
+		}
+
 		if (!json_is_null (error)) {
 			/* The response contains an error. */
 			g_set_error (&local, G_IO_ERROR, G_IO_ERROR_FAILED,
@@ -1137,15 +1398,23 @@ ovsdb_got_msg (NMOvsdb *self, json_t *msg)
 			              json_string_value (error));
 		}
 
-		callback = call->callback;
-		user_data = call->user_data;
-		g_array_remove_index (priv->calls, 0);
-		callback (self, result, local, user_data);
+		/* Calls that were merged into one transaction share the id
+		 * and are completed together. */
+		do {
+			callback = call->callback;
+			user_data = call->user_data;
+			g_array_remove_index (priv->calls, 0);
+			callback (self, result, local, user_data);
 
-		/* Don't progress further commands in case the callback hit an error
-		 * and disconnected us. */
-		if (!priv->conn)
-			return;
+			/* Don't progress further commands in case the callback hit an error
+			 * and disconnected us. */
+			if (!priv->conn)
+				return;
+
+			if (!priv->calls->len)
+				break;
+			call = &g_array_index (priv->calls, OvsdbMethodCall, 0);
+		} while (call->id == id);
 
 		/* Now we're free to serialize and send the next command, if any. */
 		ovsdb_next_command (self);
@@ -1162,22 +1431,55 @@ ovsdb_got_msg (NMOvsdb *self, json_t *msg)
 /* Lower level marshalling and demarshalling of the JSON-RPC traffic on the
  * ovsdb socket. */
 
-static size_t
-_json_callback (void *buffer, size_t buflen, void *user_data)
+/**
+ * _json_scan:
+ *
+ * Looks for the end of the next complete top-level JSON value in the input
+ * buffer. The scanner state is kept across calls, so that every byte is
+ * looked at only once regardless of how many reads a large message (such as
+ * the initial monitor reply) is split into.
+ *
+ * Returns: offset just past the end of the value, or 0 if the input doesn't
+ *   contain a complete value yet.
+ */
+static gsize
+_json_scan (NMOvsdbPrivate *priv)
 {
-	NMOvsdb *self = NM_OVSDB (user_data);
-	NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE (self);
+	const char *str = priv->input->str;
+	gsize i;
+
+	for (i = priv->scan_pos; i < priv->input->len; i++) {
+		if (priv->scan_in_string) {
+			if (priv->scan_escaped)
+				priv->scan_escaped = FALSE;
+			else if (str[i] == '\\')
+				priv->scan_escaped = TRUE;
+			else if (str[i] == '"')
+				priv->scan_in_string = FALSE;
+			continue;
+		}
 
-	if (priv->bufp == priv->input->len) {
-		/* No more bytes buffered for decoding. */
-		return 0;
+		switch (str[i]) {
+		case '"':
+			priv->scan_in_string = TRUE;
+			break;
+		case '{':
+		case '[':
+			priv->scan_depth++;
+			break;
+		case '}':
+		case ']':
+			if (   priv->scan_depth > 0
+			    && --priv->scan_depth == 0) {
+				priv->scan_pos = i + 1;
+				return i + 1;
+			}
+			break;
+		}
 	}
 
-	/* Pass one more byte to the JSON decoder. */
-	*(char *)buffer = priv->input->str[priv->bufp];
-	priv->bufp++;
-
-	return (size_t)1;
+	priv->scan_pos = i;
+	return 0;
 }
 
 /**
@@ -1194,6 +1496,8 @@ ovsdb_read_cb (GObject *source_object, GAsyncResult *res, gpointer user_data)
 	GInputStream *stream = G_INPUT_STREAM (source_object);
 	GError *error = NULL;
 	gssize size;
+	gsize start = 0;
+	gsize end;
 	json_t *msg;
 	json_error_t json_error = { 0, };
 
@@ -1206,21 +1510,23 @@ ovsdb_read_cb (GObject *source_object, GAsyncResult *res, gpointer user_data)
 	}
 
 	g_string_append_len (priv->input, priv->buf, size);
-	do {
-		priv->bufp = 0;
-		/* The callback always eats up only up to a single byte. This makes
-		 * it possible for us to identify complete JSON objects in spite of
-		 * us not knowing the length in advance. */
-		msg = json_load_callback (_json_callback, self, JSON_DISABLE_EOF_CHECK, &json_error);
-		if (msg) {
-			ovsdb_got_msg (self, msg);
-			g_string_erase (priv->input, 0, priv->bufp);
+	while ((end = _json_scan (priv)) > 0) {
+		msg = json_loadb (&priv->input->str[start], end - start, 0, &json_error);
+		start = end;
+		if (!msg) {
+			_LOGW ("invalid JSON from ovsdb: %s", json_error.text);
+			ovsdb_disconnect (self, FALSE);
+			return;
 		}
+		ovsdb_got_msg (self, msg);
 		json_decref (msg);
-	} while (msg);
 
-	if (!priv->conn)
-		return;
+		if (!priv->conn)
+			return;
+	}
+
+	g_string_erase (priv->input, 0, start);
+	priv->scan_pos -= start;
 
 	if (size)
 		ovsdb_read (self);
@@ -1311,7 +1617,10 @@ ovsdb_disconnect (NMOvsdb *self, gboolean is_disposing)
 		callback (self, NULL, error, user_data);
 	}
 
-	priv->bufp = 0;
+	priv->scan_pos = 0;
+	priv->scan_depth = 0;
+	priv->scan_in_string = FALSE;
+	priv->scan_escaped = FALSE;
 	g_string_truncate (priv->input, 0);
 	g_string_truncate (priv->output, 0);
 	g_clear_object (&priv->client);
@@ -177,6 +177,30 @@ teamd_read_timeout_cb (gpointer user_data)
 	return G_SOURCE_REMOVE;
 }
 
+static void
+teamd_schedule_read_config (NMDeviceTeam *self, NMDevice *slave)
+{
+	NMDeviceTeamPrivate *priv = NM_DEVICE_TEAM_GET_PRIVATE (self);
+
+	/* The actual configuration only changes as a consequence of port changes,
+	 * and fetching it costs O(ports). teamd has no way to notify us when it's
+	 * done processing them, so read it once after the last port change:
+	 * while other slaves are still waiting to be enslaved, their enslavement
+	 * (or their removal, see release_pending_slave()) will schedule the read
+	 * instead. A read that is already armed is left alone meanwhile. A burst
+	 * of port changes (re)arms a single timeout. */
+	if (!priv->tdc)
+		return;
+
+	if (nm_device_master_has_pending_slaves (NM_DEVICE (self), slave))
+		return;
+
+	nm_clear_g_source (&priv->teamd_read_timeout);
+	priv->teamd_read_timeout = g_timeout_add_seconds (5,
+	                                                  teamd_read_timeout_cb,
+	                                                  self);
+}
+
 static void
 update_connection (NMDevice *device, NMConnection *connection)
 {
@@ -212,6 +236,7 @@ master_update_slave_connection (NMDevice *self,
                                 NMConnection *connection,
                                 GError **error)
 {
+	NMDeviceTeamPrivate *priv = NM_DEVICE_TEAM_GET_PRIVATE ((NMDeviceTeam *) self);
 	NMSettingTeamPort *s_port;
 	char *port_config = NULL;
 	int err = 0;
@@ -220,31 +245,38 @@ master_update_slave_connection (NMDevice *self,
 	const char *iface = nm_device_get_iface (self);
 	const char *iface_slave = nm_device_get_iface (slave);
 
-	tdc = teamdctl_alloc ();
+	/* Reuse the control connection we already hold, connecting to teamd
+	 * is way more expensive than the query itself. */
+	tdc = priv->tdc;
 	if (!tdc) {
-		g_set_error (error,
-		             NM_DEVICE_ERROR,
-		             NM_DEVICE_ERROR_FAILED,
-		             "update slave connection for slave '%s' failed to connect to teamd for master %s (out of memory?)",
-		             iface_slave, iface);
-		g_return_val_if_reached (FALSE);
-	}
+		tdc = teamdctl_alloc ();
+		if (!tdc) {
+			g_set_error (error,
+			             NM_DEVICE_ERROR,
+			             NM_DEVICE_ERROR_FAILED,
+			             "update slave connection for slave '%s' failed to connect to teamd for master %s (out of memory?)",
+			             iface_slave, iface);
+			g_return_val_if_reached (FALSE);
+		}
 
-	err = teamdctl_connect (tdc, iface, NULL, NULL);
-	if (err) {
-		teamdctl_free (tdc);
-		g_set_error (error,
-		             NM_DEVICE_ERROR,
-		             NM_DEVICE_ERROR_FAILED,
-		             "update slave connection for slave '%s' failed to connect to teamd for master %s (err=%d)",
-		             iface_slave, iface, err);
-		return FALSE;
+		err = teamdctl_connect (tdc, iface, NULL, NULL);
+		if (err) {
+			teamdctl_free (tdc);
+			g_set_error (error,
+			             NM_DEVICE_ERROR,
+			             NM_DEVICE_ERROR_FAILED,
+			             "update slave connection for slave '%s' failed to connect to teamd for master %s (err=%d)",
+			             iface_slave, iface, err);
+			return FALSE;
+		}
 	}
 
 	err = teamdctl_port_config_get_raw_direct (tdc, iface_slave, (char **)&team_port_config);
 	port_config = g_strdup (team_port_config);
-	teamdctl_disconnect (tdc);
-	teamdctl_free (tdc);
+	if (tdc != priv->tdc) {
+		teamdctl_disconnect (tdc);
+		teamdctl_free (tdc);
+	}
 	if (err) {
 		g_set_error (error,
 		             NM_DEVICE_ERROR,
@@ -727,15 +759,12 @@ enslave_slave (NMDevice *device,
 		if (!success)
 			return FALSE;
 
-		nm_clear_g_source (&priv->teamd_read_timeout);
-		priv->teamd_read_timeout = g_timeout_add_seconds (5,
-		                                                  teamd_read_timeout_cb,
-		                                                  self);
-
 		_LOGI (LOGD_TEAM, "enslaved team port %s", slave_iface);
 	} else
 		_LOGI (LOGD_TEAM, "team port %s was enslaved", slave_iface);
 
+	teamd_schedule_read_config (self, slave);
+
 	return TRUE;
 }
 
@@ -745,7 +774,6 @@ release_slave (NMDevice *device,
                gboolean configure)
 {
 	NMDeviceTeam *self = NM_DEVICE_TEAM (device);
-	NMDeviceTeamPrivate *priv = NM_DEVICE_TEAM_GET_PRIVATE (self);
 	gboolean success;
 
 	if (configure) {
@@ -765,13 +793,17 @@ release_slave (NMDevice *device,
 		if (!nm_device_bring_up (slave, TRUE, NULL))
 			_LOGW (LOGD_TEAM, "released team port %s could not be brought up",
 			       nm_device_get_ip_iface (slave));
-
-		nm_clear_g_source (&priv->teamd_read_timeout);
-		priv->teamd_read_timeout = g_timeout_add_seconds (5,
-		                                                  teamd_read_timeout_cb,
-		                                                  self);
 	} else
 		_LOGI (LOGD_TEAM, "team port %s was released", nm_device_get_ip_iface (slave));
+
+	teamd_schedule_read_config (self, slave);
+}
+
+static void
+release_pending_slave (NMDevice *device, NMDevice *slave)
+{
+	/* the config read might have been put off waiting for @slave. */
+	teamd_schedule_read_config (NM_DEVICE_TEAM (device), slave);
 }
 
 static gboolean
@@ -918,6 +950,7 @@ nm_device_team_class_init (NMDeviceTeamClass *klass)
 	device_class->deactivate = deactivate;
 	device_class->enslave_slave = enslave_slave;
 	device_class->release_slave = release_slave;
+	device_class->release_pending_slave = release_pending_slave;
 
 	obj_properties[PROP_CONFIG] =
 	    g_param_spec_string (NM_DEVICE_TEAM_CONFIG, "", "",
@@ -55,9 +55,9 @@ fixture_setup (test_fixture *fixture, gconstpointer user_data)
 }
 
 typedef struct {
-	in_addr_t addresses[8];
+	in_addr_t addresses[16];
 	in_addr_t peer_addresses[8];
-	gboolean expected_result[8];
+	gboolean expected_result[16];
 } TestInfo;
 
 static void
@@ -143,6 +143,25 @@ test_acd_probe_2 (test_fixture *fixture, gconstpointer user_data)
 	test_acd_common (fixture, &info);
 }
 
+static void
+test_acd_probe_many (test_fixture *fixture, gconstpointer user_data)
+{
+	TestInfo info = { };
+	guint i;
+
+	/* all addresses share the socket and filter of one manager. Only
+	 * the address that the peer has must be reported as duplicate. */
+	for (i = 0; i < G_N_ELEMENTS (info.addresses) - 1; i++) {
+		info.addresses[i] = htonl (0x0a000001 + i);
+		info.expected_result[i] = TRUE;
+	}
+	info.peer_addresses[0] = htonl (0x0a000100);
+	info.peer_addresses[1] = info.addresses[9];
+	info.expected_result[9] = FALSE;
+
+	test_acd_common (fixture, &info);
+}
+
 static void
 test_acd_announce (test_fixture *fixture, gconstpointer user_data)
 {
@@ -181,5 +200,6 @@ _nmtstp_setup_tests (void)
 {
 	g_test_add ("/acd/probe/1", test_fixture, NULL, fixture_setup, test_acd_probe_1, fixture_teardown);
 	g_test_add ("/acd/probe/2", test_fixture, NULL, fixture_setup, test_acd_probe_2, fixture_teardown);
+	g_test_add ("/acd/probe/many", test_fixture, NULL, fixture_setup, test_acd_probe_many, fixture_teardown);
 	g_test_add ("/acd/announce", test_fixture, NULL, fixture_setup, test_acd_announce, fixture_teardown);
 }
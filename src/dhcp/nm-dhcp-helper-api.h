@@ -31,6 +31,12 @@
 #define NM_DHCP_HELPER_SERVER_INTERFACE_NAME    "org.freedesktop.nm_dhcp_server"
 #define NM_DHCP_HELPER_SERVER_METHOD_NOTIFY     "Notify"
 
+/* Besides the D-Bus method, the helper can notify NetworkManager with a
+ * single datagram on a unix socket. The payload is the list of options
+ * encoded as "key=value" strings, each terminated by a NUL byte. */
+#define NM_DHCP_HELPER_EVENT_SOCKET_PATH        NMRUNDIR "/private-dhcp-event"
+#define NM_DHCP_HELPER_EVENT_MAX_SIZE           (64 * 1024)
+
 /*****************************************************************************/
 
 #endif /* __NM_DHCP_HELPER_API_H__ */
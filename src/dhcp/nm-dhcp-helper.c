@@ -24,6 +24,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 
 #include "nm-utils/nm-vpn-plugin-macros.h"
 
@@ -108,6 +110,64 @@ build_signal_parameters (void)
 	return g_variant_ref_sink (g_variant_new ("(a{sv})", &builder));
 }
 
+static gboolean
+notify_datagram (GVariant *parameters)
+{
+	struct sockaddr_un addr = {
+		.sun_family = AF_UNIX,
+		.sun_path = NM_DHCP_HELPER_EVENT_SOCKET_PATH,
+	};
+	const struct timeval timeout = {
+		.tv_sec = 1,
+	};
+	nm_auto_free_gstring GString *data = NULL;
+	gs_unref_variant GVariant *options = NULL;
+	nm_auto_close int fd = -1;
+	GVariantIter iter;
+	const char *name;
+	GVariant *value;
+	int errsv;
+
+	data = g_string_sized_new (1024);
+	options = g_variant_get_child_value (parameters, 0);
+	g_variant_iter_init (&iter, options);
+	while (g_variant_iter_next (&iter, "{&sv}", &name, &value)) {
+		const char *val;
+		gsize len;
+
+		val = g_variant_get_fixed_array (value, &len, 1);
+		g_string_append (data, name);
+		g_string_append_c (data, '=');
+		g_string_append_len (data, val, len);
+		g_string_append_c (data, '\0');
+		g_variant_unref (value);
+	}
+
+	if (data->len > NM_DHCP_HELPER_EVENT_MAX_SIZE) {
+		_LOGi ("event too large for %s (%zu bytes)", NM_DHCP_HELPER_EVENT_SOCKET_PATH, data->len);
+		return FALSE;
+	}
+
+	fd = socket (AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+	if (fd < 0) {
+		errsv = errno;
+		_LOGi ("could not create socket: %s", g_strerror (errsv));
+		return FALSE;
+	}
+
+	/* the receive queue of NetworkManager might be full. Don't block forever. */
+	setsockopt (fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof (timeout));
+
+	if (sendto (fd, data->str, data->len, MSG_NOSIGNAL,
+	            (struct sockaddr *) &addr, sizeof (addr)) != (gssize) data->len) {
+		errsv = errno;
+		_LOGi ("could not send event to %s: %s", NM_DHCP_HELPER_EVENT_SOCKET_PATH, g_strerror (errsv));
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
 static void
 kill_pid (void)
 {
@@ -134,6 +194,16 @@ main (int argc, char *argv[])
 	guint try_count = 0;
 	gint64 time_end;
 
+	parameters = build_signal_parameters ();
+
+	/* a single datagram is much cheaper than setting up a D-Bus connection.
+	 * An older NetworkManager, which doesn't listen on the socket, is still
+	 * notified via D-Bus. */
+	if (notify_datagram (parameters)) {
+		success = TRUE;
+		goto out;
+	}
+
 	/* FIXME: g_dbus_connection_new_for_address_sync() tries to connect to the socket in
 	 * non-blocking mode, which can easily fail with EAGAIN, causing the creation of the
 	 * socket to fail with "Could not connect: Resource temporarily unavailable".
@@ -150,8 +220,6 @@ main (int argc, char *argv[])
 		goto out;
 	}
 
-	parameters = build_signal_parameters ();
-
 	time_end = g_get_monotonic_time () + (200 * 1000L); /* retry for at most 200 milliseconds */
 
 do_notify:
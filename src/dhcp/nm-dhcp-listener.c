@@ -22,6 +22,8 @@
 #include "nm-dhcp-listener.h"
 
 #include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
 #include <sys/wait.h>
 #include <signal.h>
 #include <string.h>
@@ -39,6 +41,9 @@
 #define PRIV_SOCK_PATH            NMRUNDIR "/private-dhcp"
 #define PRIV_SOCK_TAG             "dhcp"
 
+/* how many datagrams to handle per wakeup of the event socket */
+#define EVENT_SOCK_BATCH          32
+
 /*****************************************************************************/
 
 const NMDhcpClientFactory *const _nm_dhcp_manager_factories[4] = {
@@ -64,6 +69,9 @@ typedef struct {
 	gulong              new_conn_id;
 	gulong              dis_conn_id;
 	GHashTable *        connections;
+	GIOChannel *        event_channel;
+	guint               event_id;
+	int                 event_fd;
 } NMDhcpListenerPrivate;
 
 struct _NMDhcpListener {
@@ -276,6 +284,174 @@ dis_connection_cb (NMDBusManager *mgr,
 
 /*****************************************************************************/
 
+static GVariant *
+_event_parse (const char *buf, gsize len)
+{
+	GVariantBuilder builder;
+	const char *end = &buf[len];
+
+	g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
+	while (buf < end) {
+		const char *item_end, *eq;
+		gs_free char *name = NULL;
+
+		item_end = memchr (buf, '\0', end - buf);
+		if (!item_end) {
+			g_variant_builder_clear (&builder);
+			return NULL;
+		}
+
+		eq = memchr (buf, '=', item_end - buf);
+		if (eq && eq > buf) {
+			name = g_strndup (buf, eq - buf);
+			g_variant_builder_add (&builder, "{sv}",
+			                       name,
+			                       g_variant_new_fixed_array (G_VARIANT_TYPE_BYTE,
+			                                                  eq + 1,
+			                                                  item_end - (eq + 1),
+			                                                  1));
+		}
+		buf = item_end + 1;
+	}
+
+	return g_variant_new ("(a{sv})", &builder);
+}
+
+static gboolean
+event_socket_cb (GIOChannel *channel, GIOCondition condition, gpointer user_data)
+{
+	NMDhcpListener *self = user_data;
+	NMDhcpListenerPrivate *priv = NM_DHCP_LISTENER_GET_PRIVATE (self);
+	gs_free char *buf = NULL;
+	guint i;
+
+	buf = g_malloc (NM_DHCP_HELPER_EVENT_MAX_SIZE);
+
+	for (i = 0; i < EVENT_SOCK_BATCH; i++) {
+		gs_unref_variant GVariant *parameters = NULL;
+		union {
+			struct cmsghdr cmsg;
+			char buf[CMSG_SPACE (sizeof (struct ucred))];
+		} control = { };
+		struct iovec iov = {
+			.iov_base = buf,
+			.iov_len = NM_DHCP_HELPER_EVENT_MAX_SIZE,
+		};
+		struct msghdr msg = {
+			.msg_iov = &iov,
+			.msg_iovlen = 1,
+			.msg_control = &control,
+			.msg_controllen = sizeof (control),
+		};
+		const struct ucred *cred = NULL;
+		struct cmsghdr *cmsg;
+		gssize n;
+		int errsv;
+
+		n = recvmsg (priv->event_fd, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+		if (n < 0) {
+			errsv = errno;
+			if (errsv == EINTR)
+				continue;
+			if (errsv != EAGAIN)
+				_LOGW ("dhcp-event: failure to receive event: %s", g_strerror (errsv));
+			break;
+		}
+
+		for (cmsg = CMSG_FIRSTHDR (&msg); cmsg; cmsg = CMSG_NXTHDR (&msg, cmsg)) {
+			if (   cmsg->cmsg_level == SOL_SOCKET
+			    && cmsg->cmsg_type == SCM_CREDENTIALS
+			    && cmsg->cmsg_len >= CMSG_LEN (sizeof (struct ucred)))
+				cred = (const struct ucred *) CMSG_DATA (cmsg);
+		}
+
+		/* the helper is run by the DHCP client, which runs as root. */
+		if (!cred || cred->uid != 0) {
+			_LOGW ("dhcp-event: drop event from unprivileged sender (uid %lld)",
+			       cred ? (long long) cred->uid : -1LL);
+			continue;
+		}
+
+		if (NM_FLAGS_HAS (msg.msg_flags, MSG_TRUNC)) {
+			_LOGW ("dhcp-event: (pid %lld) drop truncated event", (long long) cred->pid);
+			continue;
+		}
+
+		parameters = _event_parse (buf, n);
+		if (!parameters) {
+			_LOGW ("dhcp-event: (pid %lld) drop malformed event", (long long) cred->pid);
+			continue;
+		}
+
+		g_variant_ref_sink (parameters);
+		_method_call_handle (self, parameters);
+	}
+
+	return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+event_socket_open (NMDhcpListener *self)
+{
+	NMDhcpListenerPrivate *priv = NM_DHCP_LISTENER_GET_PRIVATE (self);
+	struct sockaddr_un addr = {
+		.sun_family = AF_UNIX,
+		.sun_path = NM_DHCP_HELPER_EVENT_SOCKET_PATH,
+	};
+	nm_auto_close int fd = -1;
+	const int one = 1;
+	int errsv;
+
+	fd = socket (AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+	if (fd < 0) {
+		errsv = errno;
+		_LOGW ("failure to create event socket: %s", g_strerror (errsv));
+		return FALSE;
+	}
+
+	if (setsockopt (fd, SOL_SOCKET, SO_PASSCRED, &one, sizeof (one)) < 0) {
+		errsv = errno;
+		_LOGW ("failure to enable credentials on event socket: %s", g_strerror (errsv));
+		return FALSE;
+	}
+
+	unlink (NM_DHCP_HELPER_EVENT_SOCKET_PATH);
+	if (bind (fd, (struct sockaddr *) &addr, sizeof (addr)) < 0) {
+		errsv = errno;
+		_LOGW ("failure to bind event socket %s: %s",
+		       NM_DHCP_HELPER_EVENT_SOCKET_PATH, g_strerror (errsv));
+		return FALSE;
+	}
+	chmod (NM_DHCP_HELPER_EVENT_SOCKET_PATH, 0600);
+
+	priv->event_fd = nm_steal_fd (&fd);
+	priv->event_channel = g_io_channel_unix_new (priv->event_fd);
+	g_io_channel_set_encoding (priv->event_channel, NULL, NULL);
+	g_io_channel_set_buffered (priv->event_channel, FALSE);
+	priv->event_id = g_io_add_watch (priv->event_channel,
+	                                 G_IO_IN,
+	                                 event_socket_cb,
+	                                 self);
+	return TRUE;
+}
+
+static void
+event_socket_close (NMDhcpListener *self)
+{
+	NMDhcpListenerPrivate *priv = NM_DHCP_LISTENER_GET_PRIVATE (self);
+
+	if (priv->event_fd < 0)
+		return;
+
+	nm_clear_g_source (&priv->event_id);
+	g_clear_pointer (&priv->event_channel, g_io_channel_unref);
+	nm_close (priv->event_fd);
+	priv->event_fd = -1;
+	unlink (NM_DHCP_HELPER_EVENT_SOCKET_PATH);
+}
+
+/*****************************************************************************/
+
 static void
 nm_dhcp_listener_init (NMDhcpListener *self)
 {
@@ -286,6 +462,11 @@ nm_dhcp_listener_init (NMDhcpListener *self)
 
 	priv->dbus_mgr = nm_dbus_manager_get ();
 
+	/* the helper prefers notifying us with a datagram on this socket
+	 * and only falls back to D-Bus if it is not available. */
+	priv->event_fd = -1;
+	event_socket_open (self);
+
 	/* Register the socket our DHCP clients will return lease info on */
 	nm_dbus_manager_private_server_register (priv->dbus_mgr, PRIV_SOCK_PATH, PRIV_SOCK_TAG);
 	priv->new_conn_id = g_signal_connect (priv->dbus_mgr,
@@ -307,6 +488,8 @@ dispose (GObject *object)
 	nm_clear_g_signal_handler (priv->dbus_mgr, &priv->dis_conn_id);
 	priv->dbus_mgr = NULL;
 
+	event_socket_close ((NMDhcpListener *) object);
+
 	g_clear_pointer (&priv->connections, g_hash_table_destroy);
 
 	G_OBJECT_CLASS (nm_dhcp_listener_parent_class)->dispose (object);
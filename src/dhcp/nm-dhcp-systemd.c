@@ -30,6 +30,7 @@
 
 #include "nm-utils/nm-dedup-multi.h"
 #include "nm-utils/unaligned.h"
+#include "nm-utils/nm-io-utils.h"
 
 #include "nm-utils.h"
 #include "nm-dhcp-utils.h"
@@ -59,6 +60,13 @@ typedef struct {
 	sd_dhcp6_client *client6;
 	char *lease_file;
 
+	/* the lease persisted by a previous instance, reported before the
+	 * server confirmed it (INIT-REBOOT). */
+	sd_dhcp_lease *reboot_lease;
+	guint32 reboot_lease_age;
+	guint reboot_id;
+	guint reboot_expiry_id;
+
 	guint request_count;
 
 	bool privacy:1;
@@ -220,6 +228,7 @@ lease_to_ip4_config (NMDedupMultiIndex *multi_idx,
                      const char *iface,
                      int ifindex,
                      sd_dhcp_lease *lease,
+                     guint32 lease_age,
                      GHashTable *options,
                      guint32 route_table,
                      guint32 route_metric,
@@ -270,6 +279,8 @@ lease_to_ip4_config (NMDedupMultiIndex *multi_idx,
 
 	/* Lease time */
 	sd_dhcp_lease_get_lifetime (lease, &lifetime);
+	if (lifetime != NM_PLATFORM_LIFETIME_PERMANENT)
+		lifetime -= NM_MIN (lifetime, lease_age);
 	address.timestamp = nm_utils_get_monotonic_timestamp_s ();
 	address.lifetime = address.preferred = lifetime;
 	end_time = (guint64) time (NULL) + lifetime;
@@ -469,6 +480,176 @@ _save_client_id (NMDhcpSystemd *self,
 	}
 }
 
+static void
+reboot_lease_clear (NMDhcpSystemd *self)
+{
+	NMDhcpSystemdPrivate *priv = NM_DHCP_SYSTEMD_GET_PRIVATE (self);
+
+	nm_clear_g_source (&priv->reboot_id);
+	nm_clear_g_source (&priv->reboot_expiry_id);
+	g_clear_pointer (&priv->reboot_lease, sd_dhcp_lease_unref);
+}
+
+static gboolean
+reboot_lease_expired_cb (gpointer user_data)
+{
+	NMDhcpSystemd *self = user_data;
+	NMDhcpSystemdPrivate *priv = NM_DHCP_SYSTEMD_GET_PRIVATE (self);
+
+	priv->reboot_expiry_id = 0;
+	_LOGI ("persisted lease expired before the server confirmed it");
+	reboot_lease_clear (self);
+	nm_dhcp_client_set_state (NM_DHCP_CLIENT (self), NM_DHCP_STATE_EXPIRE, NULL, NULL);
+	return G_SOURCE_REMOVE;
+}
+
+static gboolean
+reboot_lease_bound_cb (gpointer user_data)
+{
+	NMDhcpSystemd *self = user_data;
+	NMDhcpSystemdPrivate *priv = NM_DHCP_SYSTEMD_GET_PRIVATE (self);
+	const char *iface = nm_dhcp_client_get_iface (NM_DHCP_CLIENT (self));
+	gs_unref_object NMIP4Config *ip4_config = NULL;
+	gs_unref_hashtable GHashTable *options = NULL;
+	gs_free_error GError *error = NULL;
+	guint32 lifetime = 0;
+
+	priv->reboot_id = 0;
+
+	options = g_hash_table_new_full (nm_str_hash, g_str_equal, NULL, g_free);
+	ip4_config = lease_to_ip4_config (nm_dhcp_client_get_multi_idx (NM_DHCP_CLIENT (self)),
+	                                  iface,
+	                                  nm_dhcp_client_get_ifindex (NM_DHCP_CLIENT (self)),
+	                                  priv->reboot_lease,
+	                                  priv->reboot_lease_age,
+	                                  options,
+	                                  nm_dhcp_client_get_route_table (NM_DHCP_CLIENT (self)),
+	                                  nm_dhcp_client_get_route_metric (NM_DHCP_CLIENT (self)),
+	                                  TRUE,
+	                                  &error);
+	if (!ip4_config) {
+		/* just wait for the server. */
+		_LOGD ("can't use persisted lease: %s", error->message);
+		reboot_lease_clear (self);
+		return G_SOURCE_REMOVE;
+	}
+
+	/* don't let the persisted lease outlive its lifetime, if the server
+	 * keeps quiet. */
+	sd_dhcp_lease_get_lifetime (priv->reboot_lease, &lifetime);
+	if (lifetime != NM_PLATFORM_LIFETIME_PERMANENT) {
+		/* reboot_lease_usable() only accepts leases before T1. */
+		nm_assert (lifetime > priv->reboot_lease_age);
+		priv->reboot_expiry_id = g_timeout_add_seconds (lifetime - priv->reboot_lease_age,
+		                                                reboot_lease_expired_cb,
+		                                                self);
+	}
+
+	_LOGI ("using persisted lease while the server confirms it");
+	add_requests_to_options (options, dhcp4_requests);
+	nm_dhcp_client_set_state (NM_DHCP_CLIENT (self),
+	                          NM_DHCP_STATE_BOUND,
+	                          NM_IP_CONFIG_CAST (ip4_config),
+	                          options);
+	return G_SOURCE_REMOVE;
+}
+
+static gint64
+_now_boottime_s (void)
+{
+	return nm_utils_monotonic_timestamp_as_boottime (nm_utils_get_monotonic_timestamp_s (),
+	                                                 NM_UTILS_NS_PER_SECOND);
+}
+
+static void
+lease_save (NMDhcpSystemd *self, sd_dhcp_lease *lease)
+{
+	NMDhcpSystemdPrivate *priv = NM_DHCP_SYSTEMD_GET_PRIVATE (self);
+	gs_free char *contents = NULL;
+	gs_free char *acquired = NULL;
+	gs_free char *new_contents = NULL;
+	gs_free_error GError *error = NULL;
+
+	if (dhcp_lease_save (lease, priv->lease_file) < 0)
+		return;
+
+	/* remember when the lease was acquired, for reboot_lease_usable(). */
+	if (nm_utils_file_get_contents (-1, priv->lease_file, 1024*1024,
+	                                NM_UTILS_FILE_GET_CONTENTS_FLAG_NONE,
+	                                &contents, NULL, &error) < 0) {
+		_LOGD ("can't read back lease file: %s", error->message);
+		return;
+	}
+	acquired = nm_dhcp_utils_lease_acquired_to_string (nm_utils_get_boot_id (),
+	                                                   _now_boottime_s ());
+	new_contents = g_strconcat (contents, acquired, NULL);
+	if (!nm_utils_file_set_contents (priv->lease_file, new_contents, -1, 0644, &error))
+		_LOGD ("can't record the lease acquisition time: %s", error->message);
+}
+
+/* A lease from a previous instance can be reported right away, if it is
+ * still in its first half (before T1) and the address is still configured
+ * on the interface. That is the case after a restart of NetworkManager,
+ * which leaves the address in place.
+ *
+ * This deliberately deviates from RFC 2131, section 3.2, which allows
+ * using the previous lease only after the INIT-REBOOT REQUEST went
+ * unanswered through all retransmissions. The address is already
+ * configured and in use, so reporting it early only avoids holding
+ * up activation; the server's answer still takes precedence. */
+static gboolean
+reboot_lease_usable (NMDhcpSystemd *self,
+                     sd_dhcp_lease *lease,
+                     const char *last_ip4_address,
+                     guint32 *out_age)
+{
+	NMDhcpSystemdPrivate *priv = NM_DHCP_SYSTEMD_GET_PRIVATE (self);
+	gs_free char *contents = NULL;
+	struct in_addr addr, netmask;
+	guint32 lifetime, t1;
+	gint64 acquired, now;
+
+	if (   sd_dhcp_lease_get_address (lease, &addr) < 0
+	    || sd_dhcp_lease_get_netmask (lease, &netmask) < 0
+	    || sd_dhcp_lease_get_lifetime (lease, &lifetime) < 0)
+		return FALSE;
+
+	if (last_ip4_address) {
+		in_addr_t last_addr = 0;
+
+		if (   inet_pton (AF_INET, last_ip4_address, &last_addr) != 1
+		    || last_addr != addr.s_addr)
+			return FALSE;
+	}
+
+	/* only a lease acquired during this boot has a known age. */
+	if (nm_utils_file_get_contents (-1, priv->lease_file, 1024*1024,
+	                                NM_UTILS_FILE_GET_CONTENTS_FLAG_NONE,
+	                                &contents, NULL, NULL) < 0)
+		return FALSE;
+	if (!nm_dhcp_utils_lease_acquired_from_string (contents, nm_utils_get_boot_id (), &acquired))
+		return FALSE;
+	now = _now_boottime_s ();
+	if (now < acquired)
+		return FALSE;
+
+	if (sd_dhcp_lease_get_t1 (lease, &t1) < 0)
+		t1 = 0;
+	if (   lifetime != NM_PLATFORM_LIFETIME_PERMANENT
+	    && !nm_dhcp_utils_lease_before_t1 (lifetime, t1, now - acquired))
+		return FALSE;
+
+	if (!nm_platform_ip4_address_get (NM_PLATFORM_GET,
+	                                  nm_dhcp_client_get_ifindex (NM_DHCP_CLIENT (self)),
+	                                  addr.s_addr,
+	                                  nm_utils_ip4_netmask_to_prefix (netmask.s_addr),
+	                                  addr.s_addr))
+		return FALSE;
+
+	*out_age = lifetime == NM_PLATFORM_LIFETIME_PERMANENT ? 0 : (guint32) (now - acquired);
+	return TRUE;
+}
+
 static void
 bound4_handle (NMDhcpSystemd *self)
 {
@@ -489,11 +670,14 @@ bound4_handle (NMDhcpSystemd *self)
 
 	_LOGD ("lease available");
 
+	reboot_lease_clear (self);
+
 	options = g_hash_table_new_full (nm_str_hash, g_str_equal, NULL, g_free);
 	ip4_config = lease_to_ip4_config (nm_dhcp_client_get_multi_idx (NM_DHCP_CLIENT (self)),
 	                                  iface,
 	                                  nm_dhcp_client_get_ifindex (NM_DHCP_CLIENT (self)),
 	                                  lease,
+	                                  0,
 	                                  options,
 	                                  nm_dhcp_client_get_route_table (NM_DHCP_CLIENT (self)),
 	                                  nm_dhcp_client_get_route_metric (NM_DHCP_CLIENT (self)),
@@ -505,7 +689,7 @@ bound4_handle (NMDhcpSystemd *self)
 		uint8_t type = 0;
 
 		add_requests_to_options (options, dhcp4_requests);
-		dhcp_lease_save (lease, priv->lease_file);
+		lease_save (self, lease);
 
 		sd_dhcp_client_get_client_id (priv->client4, &type, &client_id, &client_id_len);
 		if (client_id)
@@ -537,9 +721,11 @@ dhcp_event_cb (sd_dhcp_client *client, int event, gpointer user_data)
 
 	switch (event) {
 	case SD_DHCP_CLIENT_EVENT_EXPIRED:
+		reboot_lease_clear (self);
 		nm_dhcp_client_set_state (NM_DHCP_CLIENT (user_data), NM_DHCP_STATE_EXPIRE, NULL, NULL);
 		break;
 	case SD_DHCP_CLIENT_EVENT_STOP:
+		reboot_lease_clear (self);
 		nm_dhcp_client_set_state (NM_DHCP_CLIENT (user_data), NM_DHCP_STATE_FAIL, NULL, NULL);
 		break;
 	case SD_DHCP_CLIENT_EVENT_RENEW:
@@ -695,6 +881,15 @@ ip4_start (NMDhcpClient *client,
 		goto errout;
 	}
 
+	/* the client sends a REQUEST for the previous address (INIT-REBOOT).
+	 * Meanwhile, keep using the persisted lease if it is still valid. */
+	if (   lease
+	    && !priv->reboot_lease
+	    && reboot_lease_usable (self, lease, last_ip4_address, &priv->reboot_lease_age)) {
+		priv->reboot_lease = sd_dhcp_lease_ref (lease);
+		priv->reboot_id = g_idle_add (reboot_lease_bound_cb, self);
+	}
+
 	nm_dhcp_client_start_timeout (client);
 
 	success = TRUE;
@@ -992,6 +1187,8 @@ stop (NMDhcpClient *client, gboolean release, GBytes *duid)
 
 	NM_DHCP_CLIENT_CLASS (nm_dhcp_systemd_parent_class)->stop (client, release, duid);
 
+	reboot_lease_clear (self);
+
 	_LOGT ("dhcp-client%d: stop %p",
 	       priv->client4 ? '4' : '6',
 	       priv->client4 ? (gpointer) priv->client4 : (gpointer) priv->client6);
@@ -1020,6 +1217,7 @@ dispose (GObject *object)
 {
 	NMDhcpSystemdPrivate *priv = NM_DHCP_SYSTEMD_GET_PRIVATE ((NMDhcpSystemd *) object);
 
+	reboot_lease_clear ((NMDhcpSystemd *) object);
 	g_clear_pointer (&priv->lease_file, g_free);
 
 	if (priv->client4) {
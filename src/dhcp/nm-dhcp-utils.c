@@ -775,3 +775,96 @@ nm_dhcp_utils_client_id_string_to_bytes (const char *client_id)
 	return bytes;
 }
 
+
+#define LEASE_KEY_BOOT_ID  "NM_BOOT_ID="
+#define LEASE_KEY_ACQUIRED "NM_ACQUIRED="
+
+/**
+ * nm_dhcp_utils_lease_acquired_to_string:
+ * @boot_id: the boot id of the running kernel
+ * @acquired: the CLOCK_BOOTTIME in seconds when the lease was acquired
+ *
+ * Returns: the lines to append to a persisted lease file, so that
+ *   nm_dhcp_utils_lease_acquired_from_string() can later tell the
+ *   age of the lease. Unlike wall-clock time, CLOCK_BOOTTIME is not
+ *   affected by clock steps, but is only meaningful within the same
+ *   boot, hence the boot id.
+ */
+char *
+nm_dhcp_utils_lease_acquired_to_string (const char *boot_id, gint64 acquired)
+{
+	g_return_val_if_fail (boot_id && boot_id[0], NULL);
+	g_return_val_if_fail (acquired >= 0, NULL);
+
+	return g_strdup_printf (LEASE_KEY_BOOT_ID"%s\n"
+	                        LEASE_KEY_ACQUIRED"%"G_GINT64_FORMAT"\n",
+	                        boot_id,
+	                        acquired);
+}
+
+/**
+ * nm_dhcp_utils_lease_acquired_from_string:
+ * @contents: the contents of a persisted lease file
+ * @boot_id: the boot id of the running kernel
+ * @out_acquired: (out): the CLOCK_BOOTTIME in seconds when the lease
+ *   was acquired
+ *
+ * Returns: %TRUE if @contents has an acquisition time that was recorded
+ *   during the boot @boot_id.
+ */
+gboolean
+nm_dhcp_utils_lease_acquired_from_string (const char *contents,
+                                          const char *boot_id,
+                                          gint64 *out_acquired)
+{
+	gs_strfreev char **lines = NULL;
+	const char *file_boot_id = NULL;
+	gint64 acquired = -1;
+	guint i;
+
+	g_return_val_if_fail (boot_id && boot_id[0], FALSE);
+	g_return_val_if_fail (out_acquired, FALSE);
+
+	if (!contents)
+		return FALSE;
+
+	lines = g_strsplit (contents, "\n", -1);
+	for (i = 0; lines[i]; i++) {
+		if (g_str_has_prefix (lines[i], LEASE_KEY_BOOT_ID))
+			file_boot_id = &lines[i][NM_STRLEN (LEASE_KEY_BOOT_ID)];
+		else if (g_str_has_prefix (lines[i], LEASE_KEY_ACQUIRED)) {
+			acquired = _nm_utils_ascii_str_to_int64 (&lines[i][NM_STRLEN (LEASE_KEY_ACQUIRED)],
+			                                         10, 0, G_MAXINT64, -1);
+		}
+	}
+
+	if (   acquired < 0
+	    || !nm_streq0 (file_boot_id, boot_id))
+		return FALSE;
+
+	*out_acquired = acquired;
+	return TRUE;
+}
+
+/**
+ * nm_dhcp_utils_lease_before_t1:
+ * @lifetime: the lease time in seconds
+ * @t1: the renewal time (T1) in seconds as sent by the server, or 0 if
+ *   it sent none
+ * @age: the seconds since the lease was acquired
+ *
+ * Returns: %TRUE if a lease of age @age did not yet reach its renewal
+ *   time. A T1 that is missing or not shorter than the lease time is
+ *   replaced by half the lease time, like RFC 2131, section 4.4.5
+ *   suggests as default.
+ */
+gboolean
+nm_dhcp_utils_lease_before_t1 (guint32 lifetime, guint32 t1, gint64 age)
+{
+	if (   t1 == 0
+	    || t1 >= lifetime)
+		t1 = lifetime / 2;
+
+	return    age >= 0
+	       && age < t1;
+}
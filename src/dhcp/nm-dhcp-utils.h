@@ -43,5 +43,13 @@ char *nm_dhcp_utils_duid_to_string (GBytes *duid);
 
 GBytes *     nm_dhcp_utils_client_id_string_to_bytes (const char *client_id);
 
+char *nm_dhcp_utils_lease_acquired_to_string (const char *boot_id, gint64 acquired);
+
+gboolean nm_dhcp_utils_lease_acquired_from_string (const char *contents,
+                                                   const char *boot_id,
+                                                   gint64 *out_acquired);
+
+gboolean nm_dhcp_utils_lease_before_t1 (guint32 lifetime, guint32 t1, gint64 age);
+
 #endif /* __NETWORKMANAGER_DHCP_UTILS_H__ */
 
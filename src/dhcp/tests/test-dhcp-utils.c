@@ -720,6 +720,53 @@ test_client_id_from_string (void)
 	COMPARE_ID (endcolon, TRUE, endcolon, strlen (endcolon));
 }
 
+static void
+test_lease_acquired (void)
+{
+	const char *boot_id = "5c7ad5de-6a0a-4b41-9c1c-02a6bd4e0fc8";
+	const char *lease = "# This is private data. Do not parse.\n"
+	                    "ADDRESS=192.168.1.10\n"
+	                    "LIFETIME=3600\n";
+	gs_free char *acquired = NULL;
+	gs_free char *contents = NULL;
+	gint64 t = -1;
+
+	acquired = nm_dhcp_utils_lease_acquired_to_string (boot_id, 4711);
+	contents = g_strconcat (lease, acquired, NULL);
+
+	g_assert (nm_dhcp_utils_lease_acquired_from_string (contents, boot_id, &t));
+	g_assert_cmpint (t, ==, 4711);
+
+	/* a lease from another boot has no known age. */
+	t = -1;
+	g_assert (!nm_dhcp_utils_lease_acquired_from_string (contents, "another-boot", &t));
+	g_assert_cmpint (t, ==, -1);
+
+	/* nor does one written without the acquisition time. */
+	g_assert (!nm_dhcp_utils_lease_acquired_from_string (lease, boot_id, &t));
+	g_assert (!nm_dhcp_utils_lease_acquired_from_string (NULL, boot_id, &t));
+	g_assert (!nm_dhcp_utils_lease_acquired_from_string ("NM_BOOT_ID=5c7ad5de-6a0a-4b41-9c1c-02a6bd4e0fc8\n"
+	                                                     "NM_ACQUIRED=foo\n",
+	                                                     boot_id, &t));
+	g_assert_cmpint (t, ==, -1);
+
+	/* the age must be before T1 ... */
+	g_assert (nm_dhcp_utils_lease_before_t1 (3600, 1800, 0));
+	g_assert (nm_dhcp_utils_lease_before_t1 (3600, 1800, 1799));
+	g_assert (!nm_dhcp_utils_lease_before_t1 (3600, 1800, 1800));
+	g_assert (!nm_dhcp_utils_lease_before_t1 (3600, 1800, -1));
+
+	/* ... which defaults to half the lease time. */
+	g_assert (nm_dhcp_utils_lease_before_t1 (3600, 0, 1799));
+	g_assert (!nm_dhcp_utils_lease_before_t1 (3600, 0, 1800));
+
+	/* a T1 not shorter than the lease time is ignored, otherwise an
+	 * already expired lease would pass. */
+	g_assert (!nm_dhcp_utils_lease_before_t1 (3600, 3600, 1800));
+	g_assert (!nm_dhcp_utils_lease_before_t1 (3600, 7200, 4000));
+	g_assert (nm_dhcp_utils_lease_before_t1 (3600, 7200, 1000));
+}
+
 NMTST_DEFINE ();
 
 int main (int argc, char **argv)
@@ -746,6 +793,7 @@ int main (int argc, char **argv)
 	g_test_add_func ("/dhcp/ip4-missing-prefix-8", test_ip4_missing_prefix_8);
 	g_test_add_func ("/dhcp/ip4-prefix-classless", test_ip4_prefix_classless);
 	g_test_add_func ("/dhcp/client-id-from-string", test_client_id_from_string);
+	g_test_add_func ("/dhcp/lease-acquired", test_lease_acquired);
 	g_test_add_func ("/dhcp/vendor-option-metered", test_vendor_option_metered);
 
 	return g_test_run ();
@@ -357,6 +357,11 @@ main (int argc, char *argv[])
 		nm_logging_syslog_openlog (v, nm_config_get_is_debug (config));
 	}
 
+	nm_logging_trace_ring_set_enabled (nm_config_data_get_value_boolean (NM_CONFIG_GET_DATA_ORIG,
+	                                                                     NM_CONFIG_KEYFILE_GROUP_LOGGING,
+	                                                                     NM_CONFIG_KEYFILE_KEY_LOGGING_TRACE_RING,
+	                                                                     FALSE));
+
 	nm_log_info (LOGD_CORE, "NetworkManager (version " NM_DIST_VERSION ") is starting... (%s)",
 	             nm_config_get_first_start (config) ? "for the first time" : "after a restart");
 
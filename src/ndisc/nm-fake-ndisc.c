@@ -267,8 +267,7 @@ receive_ra (gpointer user_data)
 	for (i = 0; i < ra->gateways->len; i++) {
 		NMNDiscGateway *item = &g_array_index (ra->gateways, NMNDiscGateway, i);
 
-		if (nm_ndisc_add_gateway (ndisc, item))
-			changed |= NM_NDISC_CONFIG_GATEWAYS;
+		changed |= nm_ndisc_add_gateway (ndisc, item);
 	}
 
 	for (i = 0; i < ra->prefixes->len; i++) {
@@ -284,8 +283,7 @@ receive_ra (gpointer user_data)
 
 		g_assert (route.plen > 0 && route.plen <= 128);
 
-		if (nm_ndisc_add_route (ndisc, &route))
-			changed |= NM_NDISC_CONFIG_ROUTES;
+		changed |= nm_ndisc_add_route (ndisc, &route);
 
 		if (item->plen == 64) {
 			NMNDiscAddress address = {
@@ -296,23 +294,20 @@ receive_ra (gpointer user_data)
 				.dad_counter = 0,
 			};
 
-			if (nm_ndisc_complete_and_add_address (ndisc, &address))
-				changed |= NM_NDISC_CONFIG_ADDRESSES;
+			changed |= nm_ndisc_complete_and_add_address (ndisc, &address);
 		}
 	}
 
 	for (i = 0; i < ra->dns_servers->len; i++) {
 		NMNDiscDNSServer *item = &g_array_index (ra->dns_servers, NMNDiscDNSServer, i);
 
-		if (nm_ndisc_add_dns_server (ndisc, item))
-			changed |= NM_NDISC_CONFIG_DNS_SERVERS;
+		changed |= nm_ndisc_add_dns_server (ndisc, item);
 	}
 
 	for (i = 0; i < ra->dns_domains->len; i++) {
 		NMNDiscDNSDomain *item = &g_array_index (ra->dns_domains, NMNDiscDNSDomain, i);
 
-		if (nm_ndisc_add_dns_domain (ndisc, item))
-			changed |= NM_NDISC_CONFIG_DNS_DOMAINS;
+		changed |= nm_ndisc_add_dns_domain (ndisc, item);
 	}
 
 	if (rdata->public.mtu != ra->mtu) {
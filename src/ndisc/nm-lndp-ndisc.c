@@ -179,8 +179,7 @@ receive_ra (struct ndp *ndp, struct ndp_msg *msg, gpointer user_data)
 			.preference = _route_preference_coerce (ndp_msgra_route_preference (msgra)),
 		};
 
-		if (nm_ndisc_add_gateway (ndisc, &gateway))
-			changed |= NM_NDISC_CONFIG_GATEWAYS;
+		changed |= nm_ndisc_add_gateway (ndisc, &gateway);
 	}
 
 	/* Addresses & Routes */
@@ -207,8 +206,7 @@ receive_ra (struct ndp *ndp, struct ndp_msg *msg, gpointer user_data)
 				.lifetime = ndp_msg_opt_prefix_valid_time (msg, offset),
 			};
 
-			if (nm_ndisc_add_route (ndisc, &route))
-				changed |= NM_NDISC_CONFIG_ROUTES;
+			changed |= nm_ndisc_add_route (ndisc, &route);
 		}
 
 		/* Address */
@@ -223,8 +221,7 @@ receive_ra (struct ndp *ndp, struct ndp_msg *msg, gpointer user_data)
 
 			if (address.preferred > address.lifetime)
 				address.preferred = address.lifetime;
-			if (nm_ndisc_complete_and_add_address (ndisc, &address))
-				changed |= NM_NDISC_CONFIG_ADDRESSES;
+			changed |= nm_ndisc_complete_and_add_address (ndisc, &address);
 		}
 	}
 	ndp_msg_opt_for_each_offset(offset, msg, NDP_MSG_OPT_ROUTE) {
@@ -241,8 +238,7 @@ receive_ra (struct ndp *ndp, struct ndp_msg *msg, gpointer user_data)
 
 		/* Routers through this particular gateway */
 		nm_utils_ip6_address_clear_host_address (&route.network, ndp_msg_opt_route_prefix (msg, offset), route.plen);
-		if (nm_ndisc_add_route (ndisc, &route))
-			changed |= NM_NDISC_CONFIG_ROUTES;
+		changed |= nm_ndisc_add_route (ndisc, &route);
 	}
 
 	/* DNS information */
@@ -264,8 +260,7 @@ receive_ra (struct ndp *ndp, struct ndp_msg *msg, gpointer user_data)
 			 */
 			if (dns_server.lifetime && dns_server.lifetime < 7200)
 				dns_server.lifetime = 7200;
-			if (nm_ndisc_add_dns_server (ndisc, &dns_server))
-				changed |= NM_NDISC_CONFIG_DNS_SERVERS;
+			changed |= nm_ndisc_add_dns_server (ndisc, &dns_server);
 		}
 	}
 	ndp_msg_opt_for_each_offset(offset, msg, NDP_MSG_OPT_DNSSL) {
@@ -286,8 +281,7 @@ receive_ra (struct ndp *ndp, struct ndp_msg *msg, gpointer user_data)
 			 */
 			if (dns_domain.lifetime && dns_domain.lifetime < 7200)
 				dns_domain.lifetime = 7200;
-			if (nm_ndisc_add_dns_domain (ndisc, &dns_domain))
-				changed |= NM_NDISC_CONFIG_DNS_DOMAINS;
+			changed |= nm_ndisc_add_dns_domain (ndisc, &dns_domain);
 		}
 	}
 
@@ -351,7 +345,7 @@ static gboolean
 send_ra (NMNDisc *ndisc, GError **error)
 {
 	NMLndpNDiscPrivate *priv = NM_LNDP_NDISC_GET_PRIVATE ((NMLndpNDisc *) ndisc);
-	NMNDiscDataInternal *rdata = ndisc->rdata;
+	const NMNDiscData *rdata = nm_ndisc_get_rdata (ndisc);
 	gint32 now = nm_utils_get_monotonic_timestamp_s ();
 	int errsv;
 	struct in6_addr *addr;
@@ -380,8 +374,8 @@ send_ra (NMNDisc *ndisc, GError **error)
 
 	/* The device let us know about all addresses that the device got
 	 * whose prefixes are suitable for delegating. Let's announce them. */
-	for (i = 0; i < rdata->addresses->len; i++) {
-		NMNDiscAddress *address = &g_array_index (rdata->addresses, NMNDiscAddress, i);
+	for (i = 0; i < rdata->addresses_n; i++) {
+		const NMNDiscAddress *address = &rdata->addresses[i];
 		guint32 age = NM_CLAMP ((gint64) now - (gint64) address->timestamp, 0, G_MAXUINT32 - 1);
 		guint32 lifetime = address->lifetime;
 		guint32 preferred = address->preferred;
@@ -412,9 +406,9 @@ send_ra (NMNDisc *ndisc, GError **error)
 		prefix->nd_opt_pi_prefix.s6_addr32[3] = 0;
 	}
 
-	if (rdata->dns_servers->len) {
+	if (rdata->dns_servers_n) {
 		NMLndpRdnssOption *option;
-		int len = sizeof(*option) + sizeof(option->addrs[0]) * rdata->dns_servers->len;
+		int len = sizeof(*option) + sizeof(option->addrs[0]) * rdata->dns_servers_n;
 
 		option = _ndp_msg_add_option (msg, len);
 		if (option) {
@@ -422,8 +416,8 @@ send_ra (NMNDisc *ndisc, GError **error)
 			option->header.nd_opt_len = len / 8;
 			option->lifetime = htonl (900);
 
-			for (i = 0; i < rdata->dns_servers->len; i++) {
-				NMNDiscDNSServer *dns_server = &g_array_index (rdata->dns_servers, NMNDiscDNSServer, i);
+			for (i = 0; i < rdata->dns_servers_n; i++) {
+				const NMNDiscDNSServer *dns_server = &rdata->dns_servers[i];
 				option->addrs[i] = dns_server->address;
 			}
 		} else {
@@ -432,14 +426,14 @@ send_ra (NMNDisc *ndisc, GError **error)
 
 	}
 
-	if (rdata->dns_domains->len) {
+	if (rdata->dns_domains_n) {
 		NMLndpDnsslOption *option;
-		NMNDiscDNSDomain *dns_server;
+		const NMNDiscDNSDomain *dns_server;
 		int len = sizeof(*option);
 		char *search_list;
 
-		for (i = 0; i < rdata->dns_domains->len; i++) {
-			dns_server = &g_array_index (rdata->dns_domains, NMNDiscDNSDomain, i);
+		for (i = 0; i < rdata->dns_domains_n; i++) {
+			dns_server = &rdata->dns_domains[i];
 			len += strlen (dns_server->domain) + 2;
 		}
 		len = (len + 8) & ~0x7;
@@ -451,8 +445,8 @@ send_ra (NMNDisc *ndisc, GError **error)
 			option->lifetime = htonl (900);
 
 			search_list = option->search_list;
-			for (i = 0; i < rdata->dns_domains->len; i++) {
-				NMNDiscDNSDomain *dns_domain = &g_array_index (rdata->dns_domains, NMNDiscDNSDomain, i);
+			for (i = 0; i < rdata->dns_domains_n; i++) {
+				const NMNDiscDNSDomain *dns_domain = &rdata->dns_domains[i];
 				uint8_t domain_len = strlen (dns_domain->domain);
 
 				*search_list++ = domain_len;
@@ -37,6 +37,15 @@
 
 /*****************************************************************************/
 
+typedef enum {
+	ITEM_TYPE_GATEWAY,
+	ITEM_TYPE_ADDRESS,
+	ITEM_TYPE_ROUTE,
+	ITEM_TYPE_DNS_SERVER,
+	ITEM_TYPE_DNS_DOMAIN,
+	_ITEM_TYPE_NUM,
+} ItemType;
+
 struct _NMNDiscPrivate {
 	/* this *must* be the first field. */
 	NMNDiscDataInternal rdata;
@@ -55,6 +64,10 @@ struct _NMNDiscPrivate {
 	};
 	guint ra_timeout_id;  /* first RA timeout */
 	guint timeout_id;   /* prefix/dns/etc lifetime timeout */
+	GHashTable *items[_ITEM_TYPE_NUM]; /* NDiscItem indexed by their key */
+	GPtrArray *expiry_heap; /* NDiscItem ordered by their next_event */
+	guint64 items_seq;
+	NMNDiscConfigMap rdata_dirty;
 	char *last_error;
 	NMUtilsIPv6IfaceId iid;
 
@@ -178,6 +191,419 @@ nm_ndisc_get_node_type (NMNDisc *self)
 
 /*****************************************************************************/
 
+static gint32
+get_expiry_time (guint32 timestamp, guint32 lifetime)
+{
+	gint64 t;
+
+	/* timestamp is supposed to come from nm_utils_get_monotonic_timestamp_s().
+	 * It is expected to be within a certain range. */
+	nm_assert (timestamp > 0);
+	nm_assert (timestamp <= G_MAXINT32);
+
+	if (lifetime == NM_NDISC_INFINITY)
+		return G_MAXINT32;
+
+	t = (gint64) timestamp + (gint64) lifetime;
+	return CLAMP (t, 0, G_MAXINT32 - 1);
+}
+
+#define get_expiry(item) \
+	({ \
+		typeof (item) _item = (item); \
+		nm_assert (_item); \
+		get_expiry_time ((_item->timestamp), (_item->lifetime)); \
+	})
+
+#define get_expiry_half(item) \
+	({ \
+		typeof (item) _item = (item); \
+		nm_assert (_item); \
+		get_expiry_time ((_item->timestamp),\
+		                 (_item->lifetime) == NM_NDISC_INFINITY \
+		                   ? NM_NDISC_INFINITY \
+		                   : (_item->lifetime) / 2); \
+	})
+
+/*****************************************************************************/
+
+/* Every advertised item lives in a hash table of its type, indexed by its
+ * key (the address, the route destination or the domain), so that an RA
+ * option is merged with a single lookup. Items that can expire are also
+ * kept in a min-heap ordered by their next event, thus the lifetime check
+ * only touches the items that are due.
+ *
+ * The arrays of NMNDiscData are views on these items. They are only
+ * rebuilt after items were added or removed. Items that are merely
+ * refreshed are patched in place. */
+
+static const struct {
+	NMNDiscConfigMap config_map;
+	gsize size;
+} item_types[_ITEM_TYPE_NUM] = {
+	[ITEM_TYPE_GATEWAY]    = { NM_NDISC_CONFIG_GATEWAYS,    sizeof (NMNDiscGateway),   },
+	[ITEM_TYPE_ADDRESS]    = { NM_NDISC_CONFIG_ADDRESSES,   sizeof (NMNDiscAddress),   },
+	[ITEM_TYPE_ROUTE]      = { NM_NDISC_CONFIG_ROUTES,      sizeof (NMNDiscRoute),     },
+	[ITEM_TYPE_DNS_SERVER] = { NM_NDISC_CONFIG_DNS_SERVERS, sizeof (NMNDiscDNSServer), },
+	[ITEM_TYPE_DNS_DOMAIN] = { NM_NDISC_CONFIG_DNS_DOMAINS, sizeof (NMNDiscDNSDomain), },
+};
+
+#define HEAP_IDX_NONE G_MAXUINT
+
+typedef struct {
+	/* this *must* be the first field. The public arrays are filled by
+	 * copying item_types[type].size bytes of the item. */
+	union {
+		NMNDiscGateway gateway;
+		NMNDiscAddress address;
+		NMNDiscRoute route;
+		NMNDiscDNSServer dns_server;
+		NMNDiscDNSDomain dns_domain;
+	};
+	ItemType type;
+	guint heap_idx;
+	guint array_idx;
+	gint32 next_event;
+	guint64 seq;
+} NDiscItem;
+
+static guint
+_item_hash (gconstpointer ptr)
+{
+	const NDiscItem *item = ptr;
+	NMHashState h;
+
+	nm_hash_init (&h, 1671432959u);
+	switch (item->type) {
+	case ITEM_TYPE_GATEWAY:
+		nm_hash_update_in6addr (&h, &item->gateway.address);
+		break;
+	case ITEM_TYPE_ADDRESS:
+		nm_hash_update_in6addr (&h, &item->address.address);
+		break;
+	case ITEM_TYPE_ROUTE:
+		nm_hash_update_in6addr (&h, &item->route.network);
+		nm_hash_update_val (&h, item->route.plen);
+		break;
+	case ITEM_TYPE_DNS_SERVER:
+		nm_hash_update_in6addr (&h, &item->dns_server.address);
+		break;
+	case ITEM_TYPE_DNS_DOMAIN:
+		nm_hash_update_str0 (&h, item->dns_domain.domain);
+		break;
+	default:
+		nm_assert_not_reached ();
+	}
+	return nm_hash_complete (&h);
+}
+
+static gboolean
+_item_equal (gconstpointer ptr_a, gconstpointer ptr_b)
+{
+	const NDiscItem *a = ptr_a;
+	const NDiscItem *b = ptr_b;
+
+	nm_assert (a->type == b->type);
+
+	switch (a->type) {
+	case ITEM_TYPE_GATEWAY:
+		return IN6_ARE_ADDR_EQUAL (&a->gateway.address, &b->gateway.address);
+	case ITEM_TYPE_ADDRESS:
+		return IN6_ARE_ADDR_EQUAL (&a->address.address, &b->address.address);
+	case ITEM_TYPE_ROUTE:
+		return    a->route.plen == b->route.plen
+		       && IN6_ARE_ADDR_EQUAL (&a->route.network, &b->route.network);
+	case ITEM_TYPE_DNS_SERVER:
+		return IN6_ARE_ADDR_EQUAL (&a->dns_server.address, &b->dns_server.address);
+	case ITEM_TYPE_DNS_DOMAIN:
+		return nm_streq0 (a->dns_domain.domain, b->dns_domain.domain);
+	default:
+		nm_assert_not_reached ();
+	}
+	return FALSE;
+}
+
+static void
+_item_free (gpointer data)
+{
+	NDiscItem *item = data;
+
+	nm_assert (item->heap_idx == HEAP_IDX_NONE);
+
+	if (item->type == ITEM_TYPE_DNS_DOMAIN)
+		g_free (item->dns_domain.domain);
+	g_slice_free (NDiscItem, item);
+}
+
+static gint32
+_item_get_expiry (const NDiscItem *item)
+{
+	switch (item->type) {
+	case ITEM_TYPE_GATEWAY:
+		return get_expiry (&item->gateway);
+	case ITEM_TYPE_ADDRESS:
+		return get_expiry (&item->address);
+	case ITEM_TYPE_ROUTE:
+		return get_expiry (&item->route);
+	case ITEM_TYPE_DNS_SERVER:
+		return get_expiry (&item->dns_server);
+	case ITEM_TYPE_DNS_DOMAIN:
+		return get_expiry (&item->dns_domain);
+	default:
+		nm_assert_not_reached ();
+	}
+	return G_MAXINT32;
+}
+
+static gint32
+_item_get_next_event (const NDiscItem *item)
+{
+	/* DNS information gets refreshed by soliciting new RAs when half
+	 * of its lifetime passed. */
+	switch (item->type) {
+	case ITEM_TYPE_DNS_SERVER:
+		return get_expiry_half (&item->dns_server);
+	case ITEM_TYPE_DNS_DOMAIN:
+		return get_expiry_half (&item->dns_domain);
+	default:
+		return _item_get_expiry (item);
+	}
+}
+
+/*****************************************************************************/
+
+static gboolean
+_heap_less (GPtrArray *heap, guint a, guint b)
+{
+	return ((NDiscItem *) heap->pdata[a])->next_event < ((NDiscItem *) heap->pdata[b])->next_event;
+}
+
+static void
+_heap_swap (GPtrArray *heap, guint a, guint b)
+{
+	NDiscItem *item_a = heap->pdata[a];
+	NDiscItem *item_b = heap->pdata[b];
+
+	heap->pdata[a] = item_b;
+	heap->pdata[b] = item_a;
+	item_b->heap_idx = a;
+	item_a->heap_idx = b;
+}
+
+static void
+_heap_sift (GPtrArray *heap, guint idx)
+{
+	while (idx > 0) {
+		guint parent = (idx - 1) / 2;
+
+		if (!_heap_less (heap, idx, parent))
+			break;
+		_heap_swap (heap, idx, parent);
+		idx = parent;
+	}
+
+	for (;;) {
+		guint child = 2 * idx + 1;
+		guint min = idx;
+
+		if (child < heap->len && _heap_less (heap, child, min))
+			min = child;
+		if (child + 1 < heap->len && _heap_less (heap, child + 1, min))
+			min = child + 1;
+		if (min == idx)
+			break;
+		_heap_swap (heap, idx, min);
+		idx = min;
+	}
+}
+
+static void
+_heap_remove (GPtrArray *heap, NDiscItem *item)
+{
+	guint idx = item->heap_idx;
+	guint last;
+
+	if (idx == HEAP_IDX_NONE)
+		return;
+
+	nm_assert (idx < heap->len && heap->pdata[idx] == item);
+
+	item->heap_idx = HEAP_IDX_NONE;
+	last = heap->len - 1;
+	if (idx != last) {
+		heap->pdata[idx] = heap->pdata[last];
+		((NDiscItem *) heap->pdata[idx])->heap_idx = idx;
+	}
+	g_ptr_array_set_size (heap, last);
+	if (idx != last)
+		_heap_sift (heap, idx);
+}
+
+static void
+_heap_schedule (GPtrArray *heap, NDiscItem *item, gint32 next_event)
+{
+	item->next_event = next_event;
+	if (next_event == G_MAXINT32) {
+		/* infinite lifetime. Nothing to do for this item. */
+		_heap_remove (heap, item);
+		return;
+	}
+
+	if (item->heap_idx == HEAP_IDX_NONE) {
+		item->heap_idx = heap->len;
+		g_ptr_array_add (heap, item);
+	}
+	_heap_sift (heap, item->heap_idx);
+}
+
+/*****************************************************************************/
+
+static GArray *
+_data_get_array (NMNDiscDataInternal *rdata, ItemType type)
+{
+	switch (type) {
+	case ITEM_TYPE_GATEWAY:
+		return rdata->gateways;
+	case ITEM_TYPE_ADDRESS:
+		return rdata->addresses;
+	case ITEM_TYPE_ROUTE:
+		return rdata->routes;
+	case ITEM_TYPE_DNS_SERVER:
+		return rdata->dns_servers;
+	case ITEM_TYPE_DNS_DOMAIN:
+		return rdata->dns_domains;
+	default:
+		nm_assert_not_reached ();
+	}
+	return NULL;
+}
+
+static NDiscItem *
+_item_lookup (NMNDiscPrivate *priv, ItemType type, gconstpointer data)
+{
+	NDiscItem needle;
+
+	memcpy (&needle, data, item_types[type].size);
+	needle.type = type;
+	return g_hash_table_lookup (priv->items[type], &needle);
+}
+
+static NDiscItem *
+_item_add (NMNDiscPrivate *priv, ItemType type, gconstpointer data)
+{
+	NDiscItem *item;
+
+	item = g_slice_new0 (NDiscItem);
+	memcpy (item, data, item_types[type].size);
+	item->type = type;
+	item->heap_idx = HEAP_IDX_NONE;
+	item->seq = ++priv->items_seq;
+	if (type == ITEM_TYPE_DNS_DOMAIN)
+		item->dns_domain.domain = g_strdup (item->dns_domain.domain);
+
+	nm_assert (!g_hash_table_contains (priv->items[type], item));
+	g_hash_table_add (priv->items[type], item);
+	priv->rdata_dirty |= item_types[type].config_map;
+	_heap_schedule (priv->expiry_heap, item, _item_get_next_event (item));
+	return item;
+}
+
+static void
+_item_remove (NMNDiscPrivate *priv, NDiscItem *item)
+{
+	_heap_remove (priv->expiry_heap, item);
+	priv->rdata_dirty |= item_types[item->type].config_map;
+	g_hash_table_remove (priv->items[item->type], item);
+}
+
+static void
+_item_refreshed (NMNDiscPrivate *priv, NDiscItem *item)
+{
+	_heap_schedule (priv->expiry_heap, item, _item_get_next_event (item));
+
+	/* the key did not change, so the item keeps its position in the array. */
+	if (!NM_FLAGS_ANY (priv->rdata_dirty, item_types[item->type].config_map)) {
+		GArray *array = _data_get_array (&priv->rdata, item->type);
+
+		nm_assert (item->array_idx < array->len);
+		memcpy (array->data + (item->array_idx * item_types[item->type].size),
+		        item,
+		        item_types[item->type].size);
+	}
+}
+
+static void
+_items_clear (NMNDiscPrivate *priv, ItemType type)
+{
+	GHashTableIter iter;
+	NDiscItem *item;
+
+	g_hash_table_iter_init (&iter, priv->items[type]);
+	while (g_hash_table_iter_next (&iter, (gpointer *) &item, NULL)) {
+		_heap_remove (priv->expiry_heap, item);
+		g_hash_table_iter_remove (&iter);
+	}
+	priv->rdata_dirty |= item_types[type].config_map;
+}
+
+static int
+_item_cmp (gconstpointer ptr_a, gconstpointer ptr_b, gpointer user_data)
+{
+	const NDiscItem *a = *((const NDiscItem *const*) ptr_a);
+	const NDiscItem *b = *((const NDiscItem *const*) ptr_b);
+
+	switch (a->type) {
+	case ITEM_TYPE_GATEWAY:
+		/* more preferable gateways first, otherwise in the order they were added. */
+		NM_CMP_DIRECT (_preference_to_priority (b->gateway.preference),
+		               _preference_to_priority (a->gateway.preference));
+		break;
+	case ITEM_TYPE_ROUTE:
+		/* more preferable routes first, otherwise the most recent one first. */
+		NM_CMP_DIRECT (_preference_to_priority (b->route.preference),
+		               _preference_to_priority (a->route.preference));
+		NM_CMP_DIRECT (b->seq, a->seq);
+		return 0;
+	default:
+		break;
+	}
+	NM_CMP_DIRECT (a->seq, b->seq);
+	return 0;
+}
+
+static void
+_data_sync (NMNDiscPrivate *priv)
+{
+	ItemType type;
+
+	if (!priv->rdata_dirty)
+		return;
+
+	for (type = 0; type < _ITEM_TYPE_NUM; type++) {
+		gs_free NDiscItem **items = NULL;
+		GArray *array;
+		guint i, n;
+
+		if (!NM_FLAGS_ANY (priv->rdata_dirty, item_types[type].config_map))
+			continue;
+
+		items = (NDiscItem **) g_hash_table_get_keys_as_array (priv->items[type], &n);
+		if (n > 1)
+			g_qsort_with_data (items, n, sizeof (NDiscItem *), _item_cmp, NULL);
+
+		array = _data_get_array (&priv->rdata, type);
+		g_array_set_size (array, 0);
+		for (i = 0; i < n; i++) {
+			items[i]->array_idx = i;
+			g_array_append_vals (array, items[i], 1);
+		}
+	}
+
+	priv->rdata_dirty = NM_NDISC_CONFIG_NONE;
+}
+
+/*****************************************************************************/
+
 static void
 _ASSERT_data_gateways (const NMNDiscDataInternal *data)
 {
@@ -211,8 +637,11 @@ _ASSERT_data_gateways (const NMNDiscDataInternal *data)
 /*****************************************************************************/
 
 static const NMNDiscData *
-_data_complete (NMNDiscDataInternal *data)
+_data_complete (NMNDiscPrivate *priv)
 {
+	NMNDiscDataInternal *data = &priv->rdata;
+
+	_data_sync (priv);
 	_ASSERT_data_gateways (data);
 
 #define _SET(data, field) \
@@ -231,61 +660,55 @@ _data_complete (NMNDiscDataInternal *data)
 	return &data->public;
 }
 
+const NMNDiscData *
+nm_ndisc_get_rdata (NMNDisc *self)
+{
+	g_return_val_if_fail (NM_IS_NDISC (self), NULL);
+
+	return _data_complete (NM_NDISC_GET_PRIVATE (self));
+}
+
 void
 nm_ndisc_emit_config_change (NMNDisc *self, NMNDiscConfigMap changed)
 {
+	const NMNDiscData *rdata;
+
+	rdata = _data_complete (NM_NDISC_GET_PRIVATE (self));
 	_config_changed_log (self, changed);
 	g_signal_emit (self, signals[CONFIG_RECEIVED], 0,
-	               _data_complete (&NM_NDISC_GET_PRIVATE (self)->rdata),
+	               rdata,
 	               (guint) changed);
 }
 
 /*****************************************************************************/
 
-gboolean
+NMNDiscConfigMap
 nm_ndisc_add_gateway (NMNDisc *ndisc, const NMNDiscGateway *new)
 {
-	NMNDiscDataInternal *rdata = &NM_NDISC_GET_PRIVATE(ndisc)->rdata;
-	guint i;
-	guint insert_idx = G_MAXUINT;
-
-	for (i = 0; i < rdata->gateways->len; ) {
-		NMNDiscGateway *item = &g_array_index (rdata->gateways, NMNDiscGateway, i);
-
-		if (IN6_ARE_ADDR_EQUAL (&item->address, &new->address)) {
-			if (new->lifetime == 0) {
-				g_array_remove_index (rdata->gateways, i);
-				_ASSERT_data_gateways (rdata);
-				return TRUE;
-			}
-
-			if (item->preference != new->preference) {
-				g_array_remove_index (rdata->gateways, i);
-				continue;
-			}
+	NMNDiscPrivate *priv = NM_NDISC_GET_PRIVATE (ndisc);
+	NDiscItem *item;
 
-			*item = *new;
-			_ASSERT_data_gateways (rdata);
-			return FALSE;
+	item = _item_lookup (priv, ITEM_TYPE_GATEWAY, new);
+	if (item) {
+		if (new->lifetime == 0) {
+			_item_remove (priv, item);
+			return NM_NDISC_CONFIG_GATEWAYS;
 		}
 
-		/* Put before less preferable gateways. */
-		if (   _preference_to_priority (item->preference) < _preference_to_priority (new->preference)
-		    && insert_idx == G_MAXUINT)
-			insert_idx = i;
+		if (item->gateway.preference == new->preference) {
+			item->gateway = *new;
+			_item_refreshed (priv, item);
+			return NM_NDISC_CONFIG_NONE;
+		}
 
-		i++;
+		/* re-add it to sort it according to the new preference. */
+		_item_remove (priv, item);
 	}
 
-	if (new->lifetime) {
-		g_array_insert_val (rdata->gateways,
-		                    insert_idx == G_MAXUINT
-		                      ? rdata->gateways->len
-		                      : insert_idx,
-		                    *new);
-	}
-	_ASSERT_data_gateways (rdata);
-	return !!new->lifetime;
+	if (!new->lifetime)
+		return NM_NDISC_CONFIG_NONE;
+	_item_add (priv, ITEM_TYPE_GATEWAY, new);
+	return NM_NDISC_CONFIG_GATEWAYS;
 }
 
 /**
@@ -342,34 +765,32 @@ complete_address (NMNDisc *ndisc, NMNDiscAddress *addr)
 	return FALSE;
 }
 
-static gboolean
+static NMNDiscConfigMap
 nm_ndisc_add_address (NMNDisc *ndisc, const NMNDiscAddress *new)
 {
 	NMNDiscPrivate *priv = NM_NDISC_GET_PRIVATE (ndisc);
-	NMNDiscDataInternal *rdata = &priv->rdata;
-	guint i;
+	NDiscItem *item;
 
 	nm_assert (new);
 	nm_assert (new->timestamp > 0 && new->timestamp < G_MAXINT32);
 	nm_assert (!IN6_IS_ADDR_UNSPECIFIED (&new->address));
 	nm_assert (!IN6_IS_ADDR_LINKLOCAL (&new->address));
 
-	for (i = 0; i < rdata->addresses->len; i++) {
-		NMNDiscAddress *item = &g_array_index (rdata->addresses, NMNDiscAddress, i);
-
-		if (IN6_ARE_ADDR_EQUAL (&item->address, &new->address)) {
-			gboolean changed;
+	item = _item_lookup (priv, ITEM_TYPE_ADDRESS, new);
+	if (item) {
+		gboolean changed;
 
-			if (new->lifetime == 0) {
-				g_array_remove_index (rdata->addresses, i);
-				return TRUE;
-			}
-
-			changed = item->timestamp + item->lifetime  != new->timestamp + new->lifetime ||
-			          item->timestamp + item->preferred != new->timestamp + new->preferred;
-			*item = *new;
-			return changed;
+		if (new->lifetime == 0) {
+			_item_remove (priv, item);
+			return NM_NDISC_CONFIG_ADDRESSES;
 		}
+
+		/* the address is already known; only its expiry can change. */
+		changed = item->address.timestamp + item->address.lifetime  != new->timestamp + new->lifetime ||
+		          item->address.timestamp + item->address.preferred != new->timestamp + new->preferred;
+		item->address = *new;
+		_item_refreshed (priv, item);
+		return changed ? NM_NDISC_CONFIG_LIFETIMES : NM_NDISC_CONFIG_NONE;
 	}
 
 	/* we create at most max_addresses autoconf addresses. This is different from
@@ -377,30 +798,29 @@ nm_ndisc_add_address (NMNDisc *ndisc, const NMNDiscAddress *new)
 	 * static and other temporary addresses).
 	 **/
 	if (   priv->max_addresses
-	    && rdata->addresses->len >= priv->max_addresses)
-		return FALSE;
+	    && g_hash_table_size (priv->items[ITEM_TYPE_ADDRESS]) >= priv->max_addresses)
+		return NM_NDISC_CONFIG_NONE;
 
-	if (new->lifetime)
-		g_array_append_val (rdata->addresses, *new);
-	return !!new->lifetime;
+	if (!new->lifetime)
+		return NM_NDISC_CONFIG_NONE;
+	_item_add (priv, ITEM_TYPE_ADDRESS, new);
+	return NM_NDISC_CONFIG_ADDRESSES;
 }
 
-gboolean
+NMNDiscConfigMap
 nm_ndisc_complete_and_add_address (NMNDisc *ndisc, NMNDiscAddress *new)
 {
 	if (!complete_address (ndisc, new))
-		return FALSE;
+		return NM_NDISC_CONFIG_NONE;
 
 	return nm_ndisc_add_address (ndisc, new);
 }
 
-gboolean
+NMNDiscConfigMap
 nm_ndisc_add_route (NMNDisc *ndisc, const NMNDiscRoute *new)
 {
 	NMNDiscPrivate *priv;
-	NMNDiscDataInternal *rdata;
-	guint i;
-	guint insert_idx = G_MAXUINT;
+	NDiscItem *item;
 
 	if (new->plen == 0 || new->plen > 128) {
 		/* Only expect non-default routes.  The router has no idea what the
@@ -410,120 +830,94 @@ nm_ndisc_add_route (NMNDisc *ndisc, const NMNDiscRoute *new)
 		 * Also, upper layers also don't expect that NMNDisc exposes routes
 		 * with a plen or zero or larger then 128.
 		 */
-		g_return_val_if_reached (FALSE);
+		g_return_val_if_reached (NM_NDISC_CONFIG_NONE);
 	}
 
 	priv = NM_NDISC_GET_PRIVATE (ndisc);
-	rdata = &priv->rdata;
 
-	for (i = 0; i < rdata->routes->len; ) {
-		NMNDiscRoute *item = &g_array_index (rdata->routes, NMNDiscRoute, i);
-
-		if (IN6_ARE_ADDR_EQUAL (&item->network, &new->network) && item->plen == new->plen) {
-			if (new->lifetime == 0) {
-				g_array_remove_index (rdata->routes, i);
-				return TRUE;
-			}
-
-			if (item->preference != new->preference) {
-				g_array_remove_index (rdata->routes, i);
-				continue;
-			}
-
-			memcpy (item, new, sizeof (*new));
-			return FALSE;
+	item = _item_lookup (priv, ITEM_TYPE_ROUTE, new);
+	if (item) {
+		if (new->lifetime == 0) {
+			_item_remove (priv, item);
+			return NM_NDISC_CONFIG_ROUTES;
 		}
 
-		/* Put before less preferable routes. */
-		if (   _preference_to_priority (item->preference) < _preference_to_priority (new->preference)
-		    && insert_idx == G_MAXUINT)
-			insert_idx = i;
+		if (item->route.preference == new->preference) {
+			item->route = *new;
+			_item_refreshed (priv, item);
+			return NM_NDISC_CONFIG_NONE;
+		}
 
-		i++;
+		/* re-add it to sort it according to the new preference. */
+		_item_remove (priv, item);
 	}
 
-	if (new->lifetime) {
-		g_array_insert_val (rdata->routes,
-		                    insert_idx == G_MAXUINT
-		                      ? 0u
-		                      : insert_idx,
-		                    *new);
-	}
-	return !!new->lifetime;
+	if (!new->lifetime)
+		return NM_NDISC_CONFIG_NONE;
+	_item_add (priv, ITEM_TYPE_ROUTE, new);
+	return NM_NDISC_CONFIG_ROUTES;
 }
 
-gboolean
+NMNDiscConfigMap
 nm_ndisc_add_dns_server (NMNDisc *ndisc, const NMNDiscDNSServer *new)
 {
 	NMNDiscPrivate *priv;
-	NMNDiscDataInternal *rdata;
-	guint i;
+	NDiscItem *item;
 
 	priv = NM_NDISC_GET_PRIVATE (ndisc);
-	rdata = &priv->rdata;
 
-	for (i = 0; i < rdata->dns_servers->len; i++) {
-		NMNDiscDNSServer *item = &g_array_index (rdata->dns_servers, NMNDiscDNSServer, i);
-
-		if (IN6_ARE_ADDR_EQUAL (&item->address, &new->address)) {
-			if (new->lifetime == 0) {
-				g_array_remove_index (rdata->dns_servers, i);
-				return TRUE;
-			}
-			if (item->timestamp != new->timestamp || item->lifetime != new->lifetime) {
-				*item = *new;
-				return TRUE;
-			}
-			return FALSE;
+	item = _item_lookup (priv, ITEM_TYPE_DNS_SERVER, new);
+	if (item) {
+		if (new->lifetime == 0) {
+			_item_remove (priv, item);
+			return NM_NDISC_CONFIG_DNS_SERVERS;
+		}
+		if (item->dns_server.timestamp != new->timestamp || item->dns_server.lifetime != new->lifetime) {
+			item->dns_server = *new;
+			_item_refreshed (priv, item);
+			return NM_NDISC_CONFIG_LIFETIMES;
 		}
+		return NM_NDISC_CONFIG_NONE;
 	}
 
-	if (new->lifetime)
-		g_array_append_val (rdata->dns_servers, *new);
-	return !!new->lifetime;
+	if (!new->lifetime)
+		return NM_NDISC_CONFIG_NONE;
+	_item_add (priv, ITEM_TYPE_DNS_SERVER, new);
+	return NM_NDISC_CONFIG_DNS_SERVERS;
 }
 
 /* Copies new->domain if 'new' is added to the dns_domains list */
-gboolean
+NMNDiscConfigMap
 nm_ndisc_add_dns_domain (NMNDisc *ndisc, const NMNDiscDNSDomain *new)
 {
 	NMNDiscPrivate *priv;
-	NMNDiscDataInternal *rdata;
-	NMNDiscDNSDomain *item;
-	guint i;
+	NDiscItem *item;
 
 	priv = NM_NDISC_GET_PRIVATE (ndisc);
-	rdata = &priv->rdata;
 
-	for (i = 0; i < rdata->dns_domains->len; i++) {
-		item = &g_array_index (rdata->dns_domains, NMNDiscDNSDomain, i);
-
-		if (!g_strcmp0 (item->domain, new->domain)) {
-			gboolean changed;
-
-			if (new->lifetime == 0) {
-				g_array_remove_index (rdata->dns_domains, i);
-				return TRUE;
-			}
-
-			changed = (item->timestamp != new->timestamp ||
-			           item->lifetime != new->lifetime);
-			if (changed) {
-				item->timestamp = new->timestamp;
-				item->lifetime = new->lifetime;
-			}
-			return changed;
+	item = _item_lookup (priv, ITEM_TYPE_DNS_DOMAIN, new);
+	if (item) {
+		gboolean changed;
+
+		if (new->lifetime == 0) {
+			_item_remove (priv, item);
+			return NM_NDISC_CONFIG_DNS_DOMAINS;
 		}
-	}
 
-	if (new->lifetime) {
-		g_array_append_val (rdata->dns_domains, *new);
-		item = &g_array_index (rdata->dns_domains,
-		                       NMNDiscDNSDomain,
-		                       rdata->dns_domains->len - 1);
-		item->domain = g_strdup (new->domain);
+		changed = (item->dns_domain.timestamp != new->timestamp ||
+		           item->dns_domain.lifetime != new->lifetime);
+		if (changed) {
+			item->dns_domain.timestamp = new->timestamp;
+			item->dns_domain.lifetime = new->lifetime;
+			_item_refreshed (priv, item);
+		}
+		return changed ? NM_NDISC_CONFIG_LIFETIMES : NM_NDISC_CONFIG_NONE;
 	}
-	return !!new->lifetime;
+
+	if (!new->lifetime)
+		return NM_NDISC_CONFIG_NONE;
+	_item_add (priv, ITEM_TYPE_DNS_DOMAIN, new);
+	return NM_NDISC_CONFIG_DNS_DOMAINS;
 }
 
 /*****************************************************************************/
@@ -727,12 +1121,10 @@ gboolean
 nm_ndisc_set_iid (NMNDisc *ndisc, const NMUtilsIPv6IfaceId iid)
 {
 	NMNDiscPrivate *priv;
-	NMNDiscDataInternal *rdata;
 
 	g_return_val_if_fail (NM_IS_NDISC (ndisc), FALSE);
 
 	priv = NM_NDISC_GET_PRIVATE (ndisc);
-	rdata = &priv->rdata;
 
 	if (priv->iid.id != iid.id) {
 		priv->iid = iid;
@@ -740,9 +1132,9 @@ nm_ndisc_set_iid (NMNDisc *ndisc, const NMUtilsIPv6IfaceId iid)
 		if (priv->addr_gen_mode == NM_SETTING_IP6_CONFIG_ADDR_GEN_MODE_STABLE_PRIVACY)
 			return FALSE;
 
-		if (rdata->addresses->len) {
+		if (g_hash_table_size (priv->items[ITEM_TYPE_ADDRESS])) {
 			_LOGD ("IPv6 interface identifier changed, flushing addresses");
-			g_array_remove_range (rdata->addresses, 0, rdata->addresses->len);
+			_items_clear (priv, ITEM_TYPE_ADDRESS);
 			nm_ndisc_emit_config_change (ndisc, NM_NDISC_CONFIG_ADDRESSES);
 			solicit_routers (ndisc);
 		}
@@ -799,33 +1191,34 @@ nm_ndisc_start (NMNDisc *ndisc)
 NMNDiscConfigMap
 nm_ndisc_dad_failed (NMNDisc *ndisc, const struct in6_addr *address, gboolean emit_changed_signal)
 {
-	NMNDiscDataInternal *rdata;
-	guint i;
-	gboolean changed = FALSE;
-
-	rdata = &NM_NDISC_GET_PRIVATE (ndisc)->rdata;
-
-	for (i = 0; i < rdata->addresses->len; ) {
-		NMNDiscAddress *item = &g_array_index (rdata->addresses, NMNDiscAddress, i);
-
-		if (IN6_ARE_ADDR_EQUAL (&item->address, address)) {
-			_LOGD ("DAD failed for discovered address %s", nm_utils_inet6_ntop (address, NULL));
-			changed = TRUE;
-			if (!complete_address (ndisc, item)) {
-				g_array_remove_index (rdata->addresses, i);
-				continue;
-			}
-		}
-		i++;
+	NMNDiscPrivate *priv = NM_NDISC_GET_PRIVATE (ndisc);
+	NDiscItem *item;
+
+	item = _item_lookup (priv, ITEM_TYPE_ADDRESS, &((NMNDiscAddress) { .address = *address }));
+	if (!item)
+		return NM_NDISC_CONFIG_NONE;
+
+	_LOGD ("DAD failed for discovered address %s", nm_utils_inet6_ntop (address, NULL));
+
+	/* the address is the key of the item. Take it out of the index while
+	 * a new one is generated. */
+	g_hash_table_steal (priv->items[ITEM_TYPE_ADDRESS], item);
+	priv->rdata_dirty |= NM_NDISC_CONFIG_ADDRESSES;
+	if (   complete_address (ndisc, &item->address)
+	    && !g_hash_table_contains (priv->items[ITEM_TYPE_ADDRESS], item))
+		g_hash_table_add (priv->items[ITEM_TYPE_ADDRESS], item);
+	else {
+		_heap_remove (priv->expiry_heap, item);
+		_item_free (item);
 	}
 
-	if (emit_changed_signal && changed)
+	if (emit_changed_signal)
 		nm_ndisc_emit_config_change (ndisc, NM_NDISC_CONFIG_ADDRESSES);
 
-	return changed ? NM_NDISC_CONFIG_ADDRESSES : NM_NDISC_CONFIG_NONE;
+	return NM_NDISC_CONFIG_ADDRESSES;
 }
 
-#define CONFIG_MAP_MAX_STR 7
+#define CONFIG_MAP_MAX_STR 8
 
 static void
 config_map_to_string (NMNDiscConfigMap map, char *p)
@@ -842,6 +1235,8 @@ config_map_to_string (NMNDiscConfigMap map, char *p)
 		*p++ = 'S';
 	if (map & NM_NDISC_CONFIG_DNS_DOMAINS)
 		*p++ = 'D';
+	if (map & NM_NDISC_CONFIG_LIFETIMES)
+		*p++ = 'l';
 	*p = '\0';
 }
 
@@ -860,40 +1255,6 @@ dhcp_level_to_string (NMNDiscDHCPLevel dhcp_level)
 	}
 }
 
-static gint32
-get_expiry_time (guint32 timestamp, guint32 lifetime)
-{
-	gint64 t;
-
-	/* timestamp is supposed to come from nm_utils_get_monotonic_timestamp_s().
-	 * It is expected to be within a certain range. */
-	nm_assert (timestamp > 0);
-	nm_assert (timestamp <= G_MAXINT32);
-
-	if (lifetime == NM_NDISC_INFINITY)
-		return G_MAXINT32;
-
-	t = (gint64) timestamp + (gint64) lifetime;
-	return CLAMP (t, 0, G_MAXINT32 - 1);
-}
-
-#define get_expiry(item) \
-	({ \
-		typeof (item) _item = (item); \
-		nm_assert (_item); \
-		get_expiry_time ((_item->timestamp), (_item->lifetime)); \
-	})
-
-#define get_expiry_half(item) \
-	({ \
-		typeof (item) _item = (item); \
-		nm_assert (_item); \
-		get_expiry_time ((_item->timestamp),\
-		                 (_item->lifetime) == NM_NDISC_INFINITY \
-		                   ? NM_NDISC_INFINITY \
-		                   : (_item->lifetime) / 2); \
-	})
-
 static const char *
 _get_exp (char *buf, gsize buf_size, gint64 now_ns, gint32 expiry_time)
 {
@@ -973,169 +1334,44 @@ _config_changed_log (NMNDisc *ndisc, NMNDiscConfigMap changed)
 	}
 }
 
-static void
-clean_gateways (NMNDisc *ndisc, gint32 now, NMNDiscConfigMap *changed, gint32 *nextevent)
-{
-	NMNDiscDataInternal *rdata;
-	guint i;
-
-	rdata = &NM_NDISC_GET_PRIVATE (ndisc)->rdata;
-
-	for (i = 0; i < rdata->gateways->len; ) {
-		NMNDiscGateway *item = &g_array_index (rdata->gateways, NMNDiscGateway, i);
-
-		if (item->lifetime != NM_NDISC_INFINITY) {
-			gint32 expiry = get_expiry (item);
-
-			if (now >= expiry) {
-				g_array_remove_index (rdata->gateways, i);
-				*changed |= NM_NDISC_CONFIG_GATEWAYS;
-				continue;
-			}
-			if (*nextevent > expiry)
-				*nextevent = expiry;
-		}
-		i++;
-	}
-
-	_ASSERT_data_gateways (rdata);
-}
-
-static void
-clean_addresses (NMNDisc *ndisc, gint32 now, NMNDiscConfigMap *changed, gint32 *nextevent)
-{
-	NMNDiscDataInternal *rdata;
-	guint i;
-
-	rdata = &NM_NDISC_GET_PRIVATE (ndisc)->rdata;
-
-	for (i = 0; i < rdata->addresses->len; ) {
-		const NMNDiscAddress *item = &g_array_index (rdata->addresses, NMNDiscAddress, i);
-
-		if (item->lifetime != NM_NDISC_INFINITY) {
-			gint32 expiry = get_expiry (item);
-
-			if (now >= expiry) {
-				g_array_remove_index (rdata->addresses, i);
-				*changed |= NM_NDISC_CONFIG_ADDRESSES;
-				continue;
-			}
-			if (*nextevent > expiry)
-				*nextevent = expiry;
-		}
-		i++;
-	}
-}
-
-static void
-clean_routes (NMNDisc *ndisc, gint32 now, NMNDiscConfigMap *changed, gint32 *nextevent)
-{
-	NMNDiscDataInternal *rdata;
-	guint i;
-
-	rdata = &NM_NDISC_GET_PRIVATE (ndisc)->rdata;
-
-	for (i = 0; i < rdata->routes->len; ) {
-		NMNDiscRoute *item = &g_array_index (rdata->routes, NMNDiscRoute, i);
-
-		if (item->lifetime != NM_NDISC_INFINITY) {
-			gint32 expiry = get_expiry (item);
-
-			if (now >= expiry) {
-				g_array_remove_index (rdata->routes, i);
-				*changed |= NM_NDISC_CONFIG_ROUTES;
-				continue;
-			}
-			if (*nextevent > expiry)
-				*nextevent = expiry;
-		}
-		i++;
-	}
-}
+static gboolean timeout_cb (gpointer user_data);
 
 static void
-clean_dns_servers (NMNDisc *ndisc, gint32 now, NMNDiscConfigMap *changed, gint32 *nextevent)
+check_timestamps (NMNDisc *ndisc, gint32 now, NMNDiscConfigMap changed)
 {
-	NMNDiscDataInternal *rdata;
-	guint i;
-
-	rdata = &NM_NDISC_GET_PRIVATE (ndisc)->rdata;
+	NMNDiscPrivate *priv = NM_NDISC_GET_PRIVATE (ndisc);
+	GPtrArray *heap = priv->expiry_heap;
+	gint32 nextevent;
 
-	for (i = 0; i < rdata->dns_servers->len; ) {
-		NMNDiscDNSServer *item = &g_array_index (rdata->dns_servers, NMNDiscDNSServer, i);
+	nm_clear_g_source (&priv->timeout_id);
 
-		if (item->lifetime != NM_NDISC_INFINITY) {
-			gint32 expiry = get_expiry (item);
-			gint32 refresh;
+	/* only look at the items which are due. */
+	while (heap->len) {
+		NDiscItem *item = heap->pdata[0];
+		gint32 expiry;
 
-			if (now >= expiry) {
-				g_array_remove_index (rdata->dns_servers, i);
-				*changed |= NM_NDISC_CONFIG_DNS_SERVERS;
-				continue;
-			}
+		if (item->next_event > now)
+			break;
 
-			refresh = get_expiry_half (item);
-			if (now >= refresh)
-				solicit_routers (ndisc);
-			else if (*nextevent > refresh)
-				*nextevent = refresh;
+		expiry = _item_get_expiry (item);
+		if (now < expiry) {
+			/* half of the lifetime of DNS information passed. Solicit
+			 * a refresh and check again when it expires. */
+			nm_assert (NM_IN_SET (item->type, ITEM_TYPE_DNS_SERVER, ITEM_TYPE_DNS_DOMAIN));
+			solicit_routers (ndisc);
+			_heap_schedule (heap, item, expiry);
+			continue;
 		}
-		i++;
-	}
-}
-
-static void
-clean_dns_domains (NMNDisc *ndisc, gint32 now, NMNDiscConfigMap *changed, gint32 *nextevent)
-{
-	NMNDiscDataInternal *rdata;
-	guint i;
-
-	rdata = &NM_NDISC_GET_PRIVATE (ndisc)->rdata;
-
-	for (i = 0; i < rdata->dns_domains->len; ) {
-		NMNDiscDNSDomain *item = &g_array_index (rdata->dns_domains, NMNDiscDNSDomain, i);
-
-		if (item->lifetime != NM_NDISC_INFINITY) {
-			gint32 expiry = get_expiry (item);
-			gint32 refresh;
-
-			if (now >= expiry) {
-				g_array_remove_index (rdata->dns_domains, i);
-				*changed |= NM_NDISC_CONFIG_DNS_DOMAINS;
-				continue;
-			}
 
-			refresh = get_expiry_half (item);
-			if (now >= refresh)
-				solicit_routers (ndisc);
-			else if (*nextevent > refresh)
-				*nextevent = refresh;
-		}
-		i++;
+		changed |= item_types[item->type].config_map;
+		_item_remove (priv, item);
 	}
-}
-
-static gboolean timeout_cb (gpointer user_data);
-
-static void
-check_timestamps (NMNDisc *ndisc, gint32 now, NMNDiscConfigMap changed)
-{
-	NMNDiscPrivate *priv = NM_NDISC_GET_PRIVATE (ndisc);
-	/* Use a magic date in the distant future (~68 years) */
-	gint32 nextevent = G_MAXINT32;
-
-	nm_clear_g_source (&priv->timeout_id);
-
-	clean_gateways (ndisc, now, &changed, &nextevent);
-	clean_addresses (ndisc, now, &changed, &nextevent);
-	clean_routes (ndisc, now, &changed, &nextevent);
-	clean_dns_servers (ndisc, now, &changed, &nextevent);
-	clean_dns_domains (ndisc, now, &changed, &nextevent);
 
 	if (changed)
 		nm_ndisc_emit_config_change (ndisc, changed);
 
-	if (nextevent != G_MAXINT32) {
+	if (heap->len) {
+		nextevent = ((NDiscItem *) heap->pdata[0])->next_event;
 		if (nextevent <= now)
 			g_return_if_reached ();
 		_LOGD ("scheduling next now/lifetime check: %d seconds",
@@ -1176,12 +1412,6 @@ nm_ndisc_rs_received (NMNDisc *ndisc)
 
 /*****************************************************************************/
 
-static void
-dns_domain_free (gpointer data)
-{
-	g_free (((NMNDiscDNSDomain *)(data))->domain);
-}
-
 static void
 set_property (GObject *object, guint prop_id,
               const GValue *value, GParamSpec *pspec)
@@ -1254,6 +1484,7 @@ nm_ndisc_init (NMNDisc *ndisc)
 {
 	NMNDiscPrivate *priv;
 	NMNDiscDataInternal *rdata;
+	guint i;
 
 	priv = G_TYPE_INSTANCE_GET_PRIVATE (ndisc, NM_TYPE_NDISC, NMNDiscPrivate);
 	ndisc->_priv = priv;
@@ -1265,9 +1496,12 @@ nm_ndisc_init (NMNDisc *ndisc)
 	rdata->routes = g_array_new (FALSE, FALSE, sizeof (NMNDiscRoute));
 	rdata->dns_servers = g_array_new (FALSE, FALSE, sizeof (NMNDiscDNSServer));
 	rdata->dns_domains = g_array_new (FALSE, FALSE, sizeof (NMNDiscDNSDomain));
-	g_array_set_clear_func (rdata->dns_domains, dns_domain_free);
 	priv->rdata.public.hop_limit = 64;
 
+	for (i = 0; i < _ITEM_TYPE_NUM; i++)
+		priv->items[i] = g_hash_table_new_full (_item_hash, _item_equal, _item_free, NULL);
+	priv->expiry_heap = g_ptr_array_new ();
+
 	/* Start at very low number so that last_rs - router_solicitation_interval
 	 * is much lower than nm_utils_get_monotonic_timestamp_s() at startup.
 	 */
@@ -1296,10 +1530,17 @@ finalize (GObject *object)
 	NMNDisc *ndisc = NM_NDISC (object);
 	NMNDiscPrivate *priv = NM_NDISC_GET_PRIVATE (ndisc);
 	NMNDiscDataInternal *rdata = &priv->rdata;
+	guint i;
 
 	g_free (priv->ifname);
 	g_free (priv->network_id);
 
+	for (i = 0; i < _ITEM_TYPE_NUM; i++) {
+		_items_clear (priv, i);
+		g_hash_table_unref (priv->items[i]);
+	}
+	g_ptr_array_unref (priv->expiry_heap);
+
 	g_array_unref (rdata->gateways);
 	g_array_unref (rdata->addresses);
 	g_array_unref (rdata->routes);
@@ -109,6 +109,10 @@ typedef enum {
 	NM_NDISC_CONFIG_DNS_DOMAINS                         = 1 << 5,
 	NM_NDISC_CONFIG_HOP_LIMIT                           = 1 << 6,
 	NM_NDISC_CONFIG_MTU                                 = 1 << 7,
+
+	/* the router refreshed known addresses, DNS servers or domains and only
+	 * their lifetimes changed. The new lifetimes are in the data. */
+	NM_NDISC_CONFIG_LIFETIMES                           = 1 << 8,
 } NMNDiscConfigMap;
 
 typedef enum {
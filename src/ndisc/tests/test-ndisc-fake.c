@@ -377,7 +377,7 @@ test_preference_changed_cb (NMNDisc *ndisc, const NMNDiscData *rdata, guint chan
 		match_route (rdata, 1, "2001:db8:a:a::", 64, "fe80::1", data->timestamp1, 10, 5);
 	} else if (data->counter == 2) {
 		g_assert_cmpint (changed, ==, NM_NDISC_CONFIG_GATEWAYS |
-		                              NM_NDISC_CONFIG_ADDRESSES |
+		                              NM_NDISC_CONFIG_LIFETIMES |
 		                              NM_NDISC_CONFIG_ROUTES);
 
 		g_assert_cmpint (rdata->gateways_n, ==, 2);
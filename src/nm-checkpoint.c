@@ -35,6 +35,7 @@
 #include "settings/nm-settings-connection.h"
 #include "nm-simple-connection.h"
 #include "nm-utils.h"
+#include "nm-core-internal.h"
 
 /*****************************************************************************/
 
@@ -43,6 +44,8 @@ typedef struct {
 	NMDevice *device;
 	NMConnection *applied_connection;
 	NMConnection *settings_connection;
+	NMSettingsConnection *sett_conn;
+	guint64 sett_conn_version_id;
 	guint64 ac_version_id;
 	NMDeviceState state;
 	bool realized:1;
@@ -167,26 +170,38 @@ find_settings_connection (NMCheckpoint *self,
 	*need_update = FALSE;
 
 	uuid = nm_connection_get_uuid (dev_checkpoint->settings_connection);
-	sett_conn = nm_settings_get_connection_by_uuid (nm_settings_get (), uuid);
+	if (nm_settings_has_connection (nm_settings_get (), dev_checkpoint->sett_conn))
+		sett_conn = dev_checkpoint->sett_conn;
+	else
+		sett_conn = nm_settings_get_connection_by_uuid (nm_settings_get (), uuid);
 
 	if (!sett_conn)
 		return NULL;
 
-	/* Now check if the connection changed, ... */
-	if (!nm_connection_compare (dev_checkpoint->settings_connection,
-	                            nm_settings_connection_get_connection (sett_conn),
-	                            NM_SETTING_COMPARE_FLAG_EXACT)) {
+	/* Now check if the connection changed, ... The version id tells us
+	 * cheaply that the profile was not touched since the checkpoint. */
+	if (   (   sett_conn != dev_checkpoint->sett_conn
+	        || nm_settings_connection_get_version_id (sett_conn) != dev_checkpoint->sett_conn_version_id)
+	    && !nm_connection_compare (dev_checkpoint->settings_connection,
+	                               nm_settings_connection_get_connection (sett_conn),
+	                               NM_SETTING_COMPARE_FLAG_EXACT)) {
 		_LOGT ("rollback: settings connection %s changed", uuid);
 		*need_update = TRUE;
 		*need_activation = TRUE;
 	}
 
 	/* ... is active, ... */
-	nm_manager_for_each_active_connection (priv->manager, active, tmp_clist) {
-		ac_uuid = nm_settings_connection_get_uuid (nm_active_connection_get_settings_connection (active));
-		if (nm_streq (uuid, ac_uuid)) {
-			_LOGT ("rollback: connection %s is active", uuid);
-			break;
+	active = (NMActiveConnection *) nm_device_get_act_request (dev_checkpoint->device);
+	if (   active
+	    && nm_active_connection_get_settings_connection (active) == sett_conn)
+		_LOGT ("rollback: connection %s is active", uuid);
+	else {
+		nm_manager_for_each_active_connection (priv->manager, active, tmp_clist) {
+			ac_uuid = nm_settings_connection_get_uuid (nm_active_connection_get_settings_connection (active));
+			if (nm_streq (uuid, ac_uuid)) {
+				_LOGT ("rollback: connection %s is active", uuid);
+				break;
+			}
 		}
 	}
 
@@ -279,6 +294,8 @@ activate:
 
 		if (dev_checkpoint->applied_connection) {
 			gboolean need_update, need_activation;
+			gs_unref_object NMConnection *applied_clone = NULL;
+			gs_unref_object NMConnection *settings_clone = NULL;
 
 			/* The device had an active connection: check if the
 			 * connection still exists, is active and was changed */
@@ -287,8 +304,11 @@ activate:
 				if (need_update) {
 					_LOGD ("rollback: updating connection %s",
 					        nm_settings_connection_get_uuid (connection));
+					/* the checkpoint holds immutable snapshots. Hand out a copy
+					 * that can be normalized and modified. */
+					settings_clone = nm_simple_connection_new_clone (dev_checkpoint->settings_connection);
 					nm_settings_connection_update (connection,
-					                               dev_checkpoint->settings_connection,
+					                               settings_clone,
 					                               NM_SETTINGS_CONNECTION_PERSIST_MODE_DISK,
 					                               NM_SETTINGS_CONNECTION_COMMIT_REASON_NONE,
 					                               "checkpoint-rollback",
@@ -299,8 +319,9 @@ activate:
 				_LOGD ("rollback: adding connection %s again",
 				       nm_connection_get_uuid (dev_checkpoint->settings_connection));
 
+				settings_clone = nm_simple_connection_new_clone (dev_checkpoint->settings_connection);
 				connection = nm_settings_add_connection (nm_settings_get (),
-				                                         dev_checkpoint->settings_connection,
+				                                         settings_clone,
 				                                         TRUE,
 				                                         &local_error);
 				if (!connection) {
@@ -327,9 +348,10 @@ activate:
 					                         NM_DEVICE_STATE_REASON_NEW_ACTIVATION);
 				}
 
+				applied_clone = nm_simple_connection_new_clone (dev_checkpoint->applied_connection);
 				if (!nm_manager_activate_connection (priv->manager,
 				                                     connection,
-				                                     dev_checkpoint->applied_connection,
+				                                     applied_clone,
 				                                     NULL,
 				                                     device,
 				                                     subject,
@@ -435,8 +457,12 @@ device_checkpoint_create (NMDevice *device)
 		settings_connection = nm_act_request_get_settings_connection (act_request);
 		applied_connection = nm_act_request_get_applied_connection (act_request);
 
-		dev_checkpoint->applied_connection = nm_simple_connection_new_clone (applied_connection);
-		dev_checkpoint->settings_connection = nm_simple_connection_new_clone (nm_settings_connection_get_connection (settings_connection));
+		/* snapshots share the settings with previous snapshots of the same
+		 * connection, so that creating many checkpoints is cheap. */
+		dev_checkpoint->applied_connection = _nm_connection_get_snapshot (applied_connection);
+		dev_checkpoint->settings_connection = _nm_connection_get_snapshot (nm_settings_connection_get_connection (settings_connection));
+		dev_checkpoint->sett_conn = g_object_ref (settings_connection);
+		dev_checkpoint->sett_conn_version_id = nm_settings_connection_get_version_id (settings_connection);
 		dev_checkpoint->ac_version_id = nm_active_connection_version_id_get (NM_ACTIVE_CONNECTION (act_request));
 		dev_checkpoint->activation_reason = nm_active_connection_get_activation_reason (NM_ACTIVE_CONNECTION (act_request));
 	}
@@ -451,6 +477,7 @@ device_checkpoint_destroy (gpointer data)
 
 	g_clear_object (&dev_checkpoint->applied_connection);
 	g_clear_object (&dev_checkpoint->settings_connection);
+	g_clear_object (&dev_checkpoint->sett_conn);
 	g_clear_object (&dev_checkpoint->device);
 	g_free (dev_checkpoint->original_dev_path);
 
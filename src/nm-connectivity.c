@@ -36,6 +36,16 @@
 
 #define HEADER_STATUS_ONLINE "X-NetworkManager-Status: online\r\n"
 
+/* for how long a completed check answers further requests for the same
+ * interface. The age is counted from the start of the request, so that
+ * the device's periodic probing (with 1 second at the shortest) always
+ * causes a new request. */
+#define CONCHECK_RESULT_TTL_MSEC 800
+
+/* number of idle keep-alive connections that cURL may cache. Connections
+ * are only reused for requests on the same interface. */
+#define CONCHECK_MAX_CONNECTIONS 32
+
 /*****************************************************************************/
 
 NM_UTILS_LOOKUP_STR_DEFINE_STATIC (_state_to_string, int /*NMConnectivityState*/,
@@ -68,12 +78,24 @@ struct _NMConnectivityCheckHandle {
 
 #if WITH_CONCHECK
 	struct {
+		char *uri;
 		char *response;
 
 		CURL *curl_ehandle;
-		struct curl_slist *request_headers;
 
 		GString *recv_msg;
+
+		/* when the request was started, for the result cache. */
+		gint64 start_ms;
+
+		NMConnectivityState cached_state;
+
+		/* the handle doesn't do a request on its own, but waits for the
+		 * result of another request on the same interface. */
+		bool waiting:1;
+
+		/* the handle is completed with @cached_state. */
+		bool cached:1;
 	} concheck;
 #endif
 
@@ -99,6 +121,9 @@ typedef struct {
 	struct {
 		CURLM *curl_mhandle;
 		guint curl_timer;
+
+		/* maps ifspec to ConCheckResult, the last result of a check on the interface. */
+		GHashTable *results;
 	} concheck;
 #endif
 } NMConnectivityPrivate;
@@ -141,6 +166,108 @@ NM_DEFINE_SINGLETON_GETTER (NMConnectivity, nm_connectivity_get, NM_TYPE_CONNECT
 
 /*****************************************************************************/
 
+#if WITH_CONCHECK
+typedef struct {
+	NMConnectivityState state;
+	gint64 start_ms;
+} ConCheckResult;
+
+static gboolean
+_result_cache_lookup (NMConnectivity *self,
+                      const char *ifspec,
+                      NMConnectivityState *out_state)
+{
+	NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE (self);
+	const ConCheckResult *result;
+
+	result = g_hash_table_lookup (priv->concheck.results, ifspec);
+	if (   !result
+	    || nm_utils_get_monotonic_timestamp_ms () - result->start_ms >= CONCHECK_RESULT_TTL_MSEC)
+		return FALSE;
+
+	*out_state = result->state;
+	return TRUE;
+}
+
+static void
+_result_cache_add (NMConnectivity *self,
+                   const char *ifspec,
+                   NMConnectivityState state,
+                   gint64 start_ms)
+{
+	NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE (self);
+	ConCheckResult *result;
+
+	result = g_hash_table_lookup (priv->concheck.results, ifspec);
+	if (!result) {
+		result = g_slice_new (ConCheckResult);
+		g_hash_table_insert (priv->concheck.results, g_strdup (ifspec), result);
+	} else if (result->start_ms > start_ms)
+		return;
+
+	result->state = state;
+	result->start_ms = start_ms;
+}
+
+static void
+_result_free (gpointer data)
+{
+	g_slice_free (ConCheckResult, data);
+}
+
+/* Finds a handle for @ifspec that either waits for a result or runs the
+ * transfer. Transfers and waiting requests are only paired if they check
+ * the same @uri for the same @response, so that a request made after the
+ * configuration changed doesn't get the result for the previous one. */
+static NMConnectivityCheckHandle *
+_check_handle_find (NMConnectivity *self,
+                    const char *ifspec,
+                    const char *uri,
+                    const char *response,
+                    gboolean waiting)
+{
+	NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE (self);
+	NMConnectivityCheckHandle *cb_data;
+
+	c_list_for_each_entry (cb_data, &priv->handles_lst_head, handles_lst) {
+		if (!cb_data->callback)
+			continue;
+		if (!nm_streq0 (cb_data->ifspec, ifspec))
+			continue;
+		if (   !nm_streq0 (cb_data->concheck.uri, uri)
+		    || !nm_streq0 (cb_data->concheck.response, response))
+			continue;
+		if (waiting) {
+			if (cb_data->concheck.waiting)
+				return cb_data;
+		} else {
+			if (cb_data->concheck.curl_ehandle)
+				return cb_data;
+		}
+	}
+	return NULL;
+}
+
+static void cb_data_free (NMConnectivityCheckHandle *cb_data,
+                          NMConnectivityState state,
+                          GError *error,
+                          const char *log_message);
+
+static void
+_check_handle_complete_waiting (NMConnectivityCheckHandle *transfer,
+                                NMConnectivityState state)
+{
+	NMConnectivityCheckHandle *cb_data;
+
+	while ((cb_data = _check_handle_find (transfer->self,
+	                                      transfer->ifspec,
+	                                      transfer->concheck.uri,
+	                                      transfer->concheck.response,
+	                                      TRUE)))
+		cb_data_free (cb_data, state, NULL, "result of pending request");
+}
+#endif
+
 static void
 cb_data_invoke_callback (NMConnectivityCheckHandle *cb_data,
                          NMConnectivityState state,
@@ -169,6 +296,25 @@ cb_data_invoke_callback (NMConnectivityCheckHandle *cb_data,
 	          state,
 	          error,
 	          cb_data->user_data);
+
+#if WITH_CONCHECK
+	if (   cb_data->ifspec
+	    && !cb_data->concheck.waiting
+	    && !cb_data->concheck.cached
+	    && !error
+	    && NM_IN_SET (state, NM_CONNECTIVITY_NONE,
+	                         NM_CONNECTIVITY_LIMITED,
+	                         NM_CONNECTIVITY_PORTAL,
+	                         NM_CONNECTIVITY_FULL)) {
+		NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE (cb_data->self);
+
+		/* the configuration might have changed since the request started. */
+		if (   nm_streq0 (cb_data->concheck.uri, priv->uri)
+		    && nm_streq0 (cb_data->concheck.response, priv->response))
+			_result_cache_add (cb_data->self, cb_data->ifspec, state, cb_data->concheck.start_ms);
+		_check_handle_complete_waiting (cb_data, state);
+	}
+#endif
 }
 
 static void
@@ -188,6 +334,33 @@ cb_data_free (NMConnectivityCheckHandle *cb_data,
 	c_list_unlink (&cb_data->handles_lst);
 
 #if WITH_CONCHECK
+	if (   cb_data->concheck.curl_ehandle
+	    && cb_data->callback
+	    && error) {
+		NMConnectivityCheckHandle *waiting;
+
+		/* the request is cancelled, but other requests for the same interface wait
+		 * for its result. Hand the running transfer over to the first of them. */
+		waiting = _check_handle_find (self,
+		                              cb_data->ifspec,
+		                              cb_data->concheck.uri,
+		                              cb_data->concheck.response,
+		                              TRUE);
+		if (waiting) {
+			waiting->concheck.waiting = FALSE;
+			waiting->concheck.start_ms = cb_data->concheck.start_ms;
+			waiting->concheck.curl_ehandle = g_steal_pointer (&cb_data->concheck.curl_ehandle);
+			waiting->concheck.recv_msg = g_steal_pointer (&cb_data->concheck.recv_msg);
+			g_free (waiting->concheck.uri);
+			waiting->concheck.uri = g_steal_pointer (&cb_data->concheck.uri);
+			g_free (waiting->concheck.response);
+			waiting->concheck.response = g_steal_pointer (&cb_data->concheck.response);
+			curl_easy_setopt (waiting->concheck.curl_ehandle, CURLOPT_WRITEDATA, waiting);
+			curl_easy_setopt (waiting->concheck.curl_ehandle, CURLOPT_HEADERDATA, waiting);
+			curl_easy_setopt (waiting->concheck.curl_ehandle, CURLOPT_PRIVATE, waiting);
+		}
+	}
+
 	if (cb_data->concheck.curl_ehandle) {
 		NMConnectivityPrivate *priv;
 
@@ -201,14 +374,11 @@ cb_data_free (NMConnectivityCheckHandle *cb_data,
 		curl_easy_setopt (cb_data->concheck.curl_ehandle, CURLOPT_HEADERFUNCTION, NULL);
 		curl_easy_setopt (cb_data->concheck.curl_ehandle, CURLOPT_HEADERDATA, NULL);
 		curl_easy_setopt (cb_data->concheck.curl_ehandle, CURLOPT_PRIVATE, NULL);
-		curl_easy_setopt (cb_data->concheck.curl_ehandle, CURLOPT_HTTPHEADER, NULL);
 
 		priv = NM_CONNECTIVITY_GET_PRIVATE (self);
 
 		curl_multi_remove_handle (priv->concheck.curl_mhandle, cb_data->concheck.curl_ehandle);
 		curl_easy_cleanup (cb_data->concheck.curl_ehandle);
-
-		curl_slist_free_all (cb_data->concheck.request_headers);
 	}
 #endif
 
@@ -217,6 +387,7 @@ cb_data_free (NMConnectivityCheckHandle *cb_data,
 	cb_data_invoke_callback (cb_data, state, error, log_message);
 
 #if WITH_CONCHECK
+	g_free (cb_data->concheck.uri);
 	g_free (cb_data->concheck.response);
 	if (cb_data->concheck.recv_msg)
 		g_string_free (cb_data->concheck.recv_msg, TRUE);
@@ -419,11 +590,16 @@ easy_header_cb (char *buffer, size_t size, size_t nitems, void *userdata)
 	NMConnectivityCheckHandle *cb_data = userdata;
 	size_t len = size * nitems;
 
+	if (!cb_data->callback)
+		return len;
+
 	if (   len >= sizeof (HEADER_STATUS_ONLINE) - 1
 	    && !g_ascii_strncasecmp (buffer, HEADER_STATUS_ONLINE, sizeof (HEADER_STATUS_ONLINE) - 1)) {
+		/* keep receiving the rest of the response, so that the connection
+		 * can be kept alive for the next check. */
 		cb_data_invoke_callback (cb_data, NM_CONNECTIVITY_FULL,
 		                         NULL, "status header found");
-		return 0;
+		return len;
 	}
 
 	return len;
@@ -434,7 +610,13 @@ easy_write_cb (void *buffer, size_t size, size_t nmemb, void *userdata)
 {
 	NMConnectivityCheckHandle *cb_data = userdata;
 	size_t len = size * nmemb;
-	const char *response = _check_handle_get_response (cb_data);;
+	const char *response = _check_handle_get_response (cb_data);
+
+	if (!cb_data->callback) {
+		/* the result is already known. Drain the response, so that the
+		 * connection can be kept alive. */
+		return len;
+	}
 
 	if (!cb_data->concheck.recv_msg)
 		cb_data->concheck.recv_msg = g_string_sized_new (len + 10);
@@ -447,11 +629,13 @@ easy_write_cb (void *buffer, size_t size, size_t nmemb, void *userdata)
 		if (g_str_has_prefix (cb_data->concheck.recv_msg->str, response)) {
 			cb_data_invoke_callback (cb_data, NM_CONNECTIVITY_FULL, NULL,
 			                         "expected response");
-		} else {
-			cb_data_invoke_callback (cb_data, NM_CONNECTIVITY_PORTAL, NULL,
-			                         "unexpected response");
+			return len;
 		}
 
+		/* don't bother reading the portal's page. The connection is not
+		 * reused in this case. */
+		cb_data_invoke_callback (cb_data, NM_CONNECTIVITY_PORTAL, NULL,
+		                         "unexpected response");
 		return 0;
 	}
 
@@ -473,6 +657,19 @@ _timeout_cb (gpointer user_data)
 	cb_data_free (cb_data, NM_CONNECTIVITY_LIMITED, NULL, "timeout");
 	return G_SOURCE_REMOVE;
 }
+
+static gboolean
+_cached_idle_cb (gpointer user_data)
+{
+	NMConnectivityCheckHandle *cb_data = user_data;
+
+	nm_assert (NM_IS_CONNECTIVITY (cb_data->self));
+	nm_assert (c_list_contains (&NM_CONNECTIVITY_GET_PRIVATE (cb_data->self)->handles_lst_head, &cb_data->handles_lst));
+
+	cb_data->timeout_id = 0;
+	cb_data_free (cb_data, cb_data->concheck.cached_state, NULL, "cached result");
+	return G_SOURCE_REMOVE;
+}
 #endif
 
 static gboolean
@@ -521,22 +718,40 @@ nm_connectivity_check_start (NMConnectivity *self,
 		cb_data->ifspec = g_strdup_printf ("if!%s", iface);
 
 #if WITH_CONCHECK
-	if (iface) {
+	if (   iface
+	    && priv->enabled) {
 		CURL *ehandle;
 
-		if (   priv->enabled
-		    && (ehandle = curl_easy_init ())) {
+		if (_result_cache_lookup (self, cb_data->ifspec, &cb_data->concheck.cached_state)) {
+			cb_data->concheck.cached = TRUE;
+			cb_data->timeout_id = g_idle_add (_cached_idle_cb, cb_data);
+			_LOG2D ("use cached result %s", nm_connectivity_state_to_string (cb_data->concheck.cached_state));
+			return cb_data;
+		}
 
+		if (_check_handle_find (self, cb_data->ifspec, priv->uri, priv->response, FALSE)) {
+			/* there is already a request pending for the interface. Wait for its result
+			 * instead of starting another one. */
+			cb_data->concheck.waiting = TRUE;
+			cb_data->concheck.uri = g_strdup (priv->uri);
+			cb_data->concheck.response = g_strdup (priv->response);
+			cb_data->timeout_id = g_timeout_add_seconds (20, _timeout_cb, cb_data);
+			_LOG2D ("wait for pending request to '%s'", priv->uri);
+			return cb_data;
+		}
+
+		if ((ehandle = curl_easy_init ())) {
+
+			cb_data->concheck.uri = g_strdup (priv->uri);
 			cb_data->concheck.response = g_strdup (priv->response);
 			cb_data->concheck.curl_ehandle = ehandle;
-			cb_data->concheck.request_headers = curl_slist_append (NULL, "Connection: close");
+			cb_data->concheck.start_ms = nm_utils_get_monotonic_timestamp_ms ();
 			curl_easy_setopt (ehandle, CURLOPT_URL, priv->uri);
 			curl_easy_setopt (ehandle, CURLOPT_WRITEFUNCTION, easy_write_cb);
 			curl_easy_setopt (ehandle, CURLOPT_WRITEDATA, cb_data);
 			curl_easy_setopt (ehandle, CURLOPT_HEADERFUNCTION, easy_header_cb);
 			curl_easy_setopt (ehandle, CURLOPT_HEADERDATA, cb_data);
 			curl_easy_setopt (ehandle, CURLOPT_PRIVATE, cb_data);
-			curl_easy_setopt (ehandle, CURLOPT_HTTPHEADER, cb_data->concheck.request_headers);
 			curl_easy_setopt (ehandle, CURLOPT_INTERFACE, cb_data->ifspec);
 			curl_multi_add_handle (priv->concheck.curl_mhandle, ehandle);
 
@@ -662,8 +877,13 @@ update_config (NMConnectivity *self, NMConfigData *config_data)
 		changed = TRUE;
 	}
 
-	if (changed)
+	if (changed) {
+#if WITH_CONCHECK
+		if (priv->concheck.results)
+			g_hash_table_remove_all (priv->concheck.results);
+#endif
 		g_signal_emit (self, signals[CONFIG_CHANGED], 0);
+	}
 }
 
 static void
@@ -692,6 +912,8 @@ nm_connectivity_init (NMConnectivity *self)
 	                  self);
 
 #if WITH_CONCHECK
+	priv->concheck.results = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, _result_free);
+
 	if (curl_global_init (CURL_GLOBAL_ALL) == CURLE_OK)
 		priv->concheck.curl_mhandle = curl_multi_init ();
 
@@ -702,6 +924,7 @@ nm_connectivity_init (NMConnectivity *self)
 		curl_multi_setopt (priv->concheck.curl_mhandle, CURLMOPT_SOCKETDATA, self);
 		curl_multi_setopt (priv->concheck.curl_mhandle, CURLMOPT_TIMERFUNCTION, multi_timer_cb);
 		curl_multi_setopt (priv->concheck.curl_mhandle, CURLMOPT_TIMERDATA, self);
+		curl_multi_setopt (priv->concheck.curl_mhandle, CURLMOPT_MAXCONNECTS, (long) CONCHECK_MAX_CONNECTIONS);
 		curl_multi_setopt (priv->concheck.curl_mhandle, CURLOPT_VERBOSE, 1);
 	}
 #endif
@@ -734,6 +957,7 @@ again:
 
 	curl_multi_cleanup (priv->concheck.curl_mhandle);
 	curl_global_cleanup ();
+	g_clear_pointer (&priv->concheck.results, g_hash_table_unref);
 #endif
 
 	if (priv->config) {
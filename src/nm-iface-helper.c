@@ -179,7 +179,8 @@ ndisc_config_changed (NMNDisc *ndisc, const NMNDiscData *rdata, guint changed_in
 		                                  gl.ifindex);
 	}
 
-	if (changed & NM_NDISC_CONFIG_ADDRESSES) {
+	if (NM_FLAGS_ANY (changed,  NM_NDISC_CONFIG_ADDRESSES
+	                          | NM_NDISC_CONFIG_LIFETIMES)) {
 		guint8 plen;
 		guint32 ifa_flags;
 
@@ -1586,6 +1586,79 @@ nm_ip6_config_reset_addresses_ndisc (NMIP6Config *self,
 		_notify_addresses (self);
 }
 
+/**
+ * nm_ip6_config_refresh_lifetimes_ndisc:
+ * @self: the #NMIP6Config
+ * @addresses: the autoconf addresses as announced by the router
+ * @addresses_n: the number of @addresses
+ * @out_refreshed: (allow-none) (out): on return, if not %NULL, an array
+ *   with the address objects of @self whose lifetimes were updated.
+ *
+ * Unlike nm_ip6_config_reset_addresses_ndisc(), this neither adds nor
+ * removes addresses. It only updates the lifetimes of those autoconf
+ * addresses that are already part of @self.
+ *
+ * Returns: %TRUE if any address was updated.
+ */
+gboolean
+nm_ip6_config_refresh_lifetimes_ndisc (NMIP6Config *self,
+                                       const NMNDiscAddress *addresses,
+                                       guint addresses_n,
+                                       GPtrArray **out_refreshed)
+{
+	NMIP6ConfigPrivate *priv;
+	guint i;
+	gboolean changed = FALSE;
+
+	g_return_val_if_fail (NM_IS_IP6_CONFIG (self), FALSE);
+	g_return_val_if_fail (!out_refreshed || !*out_refreshed, FALSE);
+
+	priv = NM_IP6_CONFIG_GET_PRIVATE (self);
+
+	for (i = 0; i < addresses_n; i++) {
+		const NMNDiscAddress *ndisc_addr = &addresses[i];
+		const NMPlatformIP6Address *a_old;
+		const NMPObject *obj_new;
+		NMPlatformIP6Address a;
+
+		a_old = nm_ip6_config_lookup_address (self, &ndisc_addr->address);
+		if (   !a_old
+		    || a_old->addr_source != NM_IP_CONFIG_SOURCE_NDISC)
+			continue;
+
+		a = *a_old;
+		a.timestamp = ndisc_addr->timestamp;
+		a.lifetime  = ndisc_addr->lifetime;
+		a.preferred = MIN (ndisc_addr->lifetime, ndisc_addr->preferred);
+		if (   a.timestamp == a_old->timestamp
+		    && a.lifetime  == a_old->lifetime
+		    && a.preferred == a_old->preferred)
+			continue;
+
+		if (!_nm_ip_config_add_obj (priv->multi_idx,
+		                            &priv->idx_ip6_addresses_,
+		                            priv->ifindex,
+		                            NULL,
+		                            (const NMPlatformObject *) &a,
+		                            FALSE,
+		                            FALSE,
+		                            NULL,
+		                            &obj_new))
+			continue;
+
+		changed = TRUE;
+		if (out_refreshed) {
+			if (!*out_refreshed)
+				*out_refreshed = g_ptr_array_new_with_free_func ((GDestroyNotify) nmp_object_unref);
+			g_ptr_array_add (*out_refreshed, (gpointer) nmp_object_ref (obj_new));
+		}
+	}
+
+	if (changed)
+		_notify_addresses (self);
+	return changed;
+}
+
 void
 nm_ip6_config_reset_addresses (NMIP6Config *self)
 {
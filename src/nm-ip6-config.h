@@ -213,6 +213,10 @@ void nm_ip6_config_reset_addresses_ndisc (NMIP6Config *self,
                                           guint addresses_n,
                                           guint8 plen,
                                           guint32 ifa_flags);
+gboolean nm_ip6_config_refresh_lifetimes_ndisc (NMIP6Config *self,
+                                                const struct _NMNDiscAddress *addresses,
+                                                guint addresses_n,
+                                                GPtrArray **out_refreshed);
 struct _NMNDiscRoute;
 struct _NMNDiscGateway;
 void nm_ip6_config_reset_routes_ndisc (NMIP6Config *self,
@@ -543,11 +543,181 @@ nm_logging_get_level (NMLogDomain domain)
 
 	G_STATIC_ASSERT (LOGL_TRACE == 0);
 	while (   sl > LOGL_TRACE
-	       && nm_logging_enabled (sl - 1, domain))
+	       && NM_FLAGS_ANY (_nm_logging_enabled_state[sl - 1], domain))
 		sl--;
 	return sl;
 }
 
+/*****************************************************************************/
+
+/* The trace ring is a fixed-size byte buffer. Each record consists of a
+ * TraceRingHeader followed by the (not NUL terminated) message. When the
+ * buffer is full, the oldest records get dropped. Records may wrap around
+ * the end of the buffer. */
+#define TRACE_RING_SIZE    (256u * 1024u)
+#define TRACE_RING_MSG_MAX 1024u
+
+typedef struct {
+	gint64 tv_sec;
+	NMLogDomain domain;
+	guint32 tv_usec;
+	guint16 msg_len;
+	guint8 level;
+} TraceRingHeader;
+
+static struct {
+	guint8 *buf;
+	gsize head;
+	gsize used;
+} trace_ring;
+
+/* the domains for which TRACE messages go to the ring. Zero (the default),
+ * unless the ring is enabled. */
+NMLogDomain _nm_logging_trace_ring_domains;
+
+/**
+ * nm_logging_trace_ring_set_enabled:
+ * @enabled: whether to record TRACE messages to the ring buffer
+ *
+ * Recording to the ring means formatting every TRACE message of
+ * %NM_LOGGING_TRACE_RING_DOMAINS, so it is disabled by default.
+ * Disabling it also releases the buffer.
+ */
+void
+nm_logging_trace_ring_set_enabled (gboolean enabled)
+{
+	_nm_logging_trace_ring_domains = enabled ? NM_LOGGING_TRACE_RING_DOMAINS : LOGD_NONE;
+	if (!enabled) {
+		g_clear_pointer (&trace_ring.buf, g_free);
+		trace_ring.head = 0;
+		trace_ring.used = 0;
+	}
+}
+
+static void
+_trace_ring_write (gsize offset, const void *data, gsize len)
+{
+	gsize n;
+
+	nm_assert (offset < TRACE_RING_SIZE);
+	nm_assert (len <= TRACE_RING_SIZE);
+
+	n = MIN (len, TRACE_RING_SIZE - offset);
+	memcpy (&trace_ring.buf[offset], data, n);
+	if (n < len)
+		memcpy (&trace_ring.buf[0], &((const guint8 *) data)[n], len - n);
+}
+
+static void
+_trace_ring_read (gsize offset, void *data, gsize len)
+{
+	gsize n;
+
+	nm_assert (offset < TRACE_RING_SIZE);
+	nm_assert (len <= TRACE_RING_SIZE);
+
+	n = MIN (len, TRACE_RING_SIZE - offset);
+	memcpy (data, &trace_ring.buf[offset], n);
+	if (n < len)
+		memcpy (&((guint8 *) data)[n], &trace_ring.buf[0], len - n);
+}
+
+static void
+_trace_ring_append (NMLogLevel level,
+                    NMLogDomain domain,
+                    const GTimeVal *tv,
+                    const char *msg)
+{
+	TraceRingHeader h;
+	gsize msg_len;
+	gsize rec_len;
+	gsize offset;
+
+	msg_len = strlen (msg);
+	if (msg_len > TRACE_RING_MSG_MAX)
+		msg_len = TRACE_RING_MSG_MAX;
+	rec_len = sizeof (h) + msg_len;
+
+	if (G_UNLIKELY (!trace_ring.buf))
+		trace_ring.buf = g_malloc (TRACE_RING_SIZE);
+
+	while (trace_ring.used + rec_len > TRACE_RING_SIZE) {
+		TraceRingHeader old;
+		gsize old_len;
+
+		_trace_ring_read (trace_ring.head, &old, sizeof (old));
+		old_len = sizeof (old) + old.msg_len;
+		nm_assert (old_len <= trace_ring.used);
+		trace_ring.head = (trace_ring.head + old_len) % TRACE_RING_SIZE;
+		trace_ring.used -= old_len;
+	}
+
+	h = (TraceRingHeader) {
+		.tv_sec  = tv->tv_sec,
+		.tv_usec = tv->tv_usec,
+		.domain  = domain,
+		.msg_len = msg_len,
+		.level   = level,
+	};
+
+	offset = (trace_ring.head + trace_ring.used) % TRACE_RING_SIZE;
+	_trace_ring_write (offset, &h, sizeof (h));
+	_trace_ring_write ((offset + sizeof (h)) % TRACE_RING_SIZE, msg, msg_len);
+	trace_ring.used += rec_len;
+}
+
+/**
+ * nm_logging_trace_ring_dump:
+ *
+ * Returns: (transfer full): a %NULL terminated list of all messages
+ *   that are currently in the trace ring buffer, oldest first. The
+ *   messages are formatted like in the log.
+ */
+char **
+nm_logging_trace_ring_dump (void)
+{
+	GPtrArray *lines;
+	gsize offset;
+	gsize remaining;
+	char msg[TRACE_RING_MSG_MAX + 1];
+
+	lines = g_ptr_array_new ();
+
+	offset = trace_ring.head;
+	remaining = trace_ring.used;
+	while (remaining > 0) {
+		const LogDesc *diter;
+		const char *domain_name = NULL;
+		TraceRingHeader h;
+
+		_trace_ring_read (offset, &h, sizeof (h));
+		_trace_ring_read ((offset + sizeof (h)) % TRACE_RING_SIZE, msg, h.msg_len);
+		msg[h.msg_len] = '\0';
+
+		for (diter = &global.domain_desc[0]; diter->name; diter++) {
+			if (NM_FLAGS_ANY (h.domain, diter->num)) {
+				domain_name = diter->name;
+				break;
+			}
+		}
+
+		g_ptr_array_add (lines,
+		                 g_strdup_printf ("%-7s [%lld.%04u] [%s] %s",
+		                                  global.level_desc[h.level].level_str,
+		                                  (long long) h.tv_sec,
+		                                  (guint) (h.tv_usec / 100),
+		                                  domain_name ?: "",
+		                                  msg));
+
+		nm_assert (sizeof (h) + h.msg_len <= remaining);
+		offset = (offset + sizeof (h) + h.msg_len) % TRACE_RING_SIZE;
+		remaining -= sizeof (h) + h.msg_len;
+	}
+
+	g_ptr_array_add (lines, NULL);
+	return (char **) g_ptr_array_free (lines, FALSE);
+}
+
 #if SYSTEMD_JOURNAL
 static void
 _iovec_set (struct iovec *iov, const void *str, gsize len)
@@ -609,11 +779,16 @@ _nm_log_impl (const char *file,
 	char *msg;
 	GTimeVal tv;
 	int errno_saved;
+	gboolean to_ring;
 
 	if ((guint) level >= G_N_ELEMENTS (_nm_logging_enabled_state))
 		g_return_if_reached ();
 
-	if (!(_nm_logging_enabled_state[level] & domain))
+	to_ring =    level == LOGL_TRACE
+	          && NM_FLAGS_ANY (domain, _nm_logging_trace_ring_domains);
+
+	if (   !(_nm_logging_enabled_state[level] & domain)
+	    && !to_ring)
 		return;
 
 	errno_saved = errno;
@@ -639,6 +814,12 @@ _nm_log_impl (const char *file,
 
 	g_get_current_time (&tv);
 
+	if (to_ring)
+		_trace_ring_append (level, domain, &tv, msg);
+
+	if (!(_nm_logging_enabled_state[level] & domain))
+		goto out;
+
 	if (global.debug_stderr)
 		g_printerr (MESSAGE_FMT"\n", MESSAGE_ARG (global, tv, msg));
 
@@ -737,6 +918,7 @@ _nm_log_impl (const char *file,
 		break;
 	}
 
+out:
 	g_free (msg);
 
 	errno = errno_saved;
@@ -220,13 +220,22 @@ void _nm_log_impl (const char *file,
 const char *nm_logging_level_to_string (void);
 const char *nm_logging_domains_to_string (void);
 
+/* When the trace ring is enabled with nm_logging_trace_ring_set_enabled(),
+ * TRACE messages for these domains are recorded to an in-memory ring buffer,
+ * regardless of the configured logging level. The buffer can be retrieved
+ * with nm_logging_trace_ring_dump(). */
+#define NM_LOGGING_TRACE_RING_DOMAINS (LOGD_PLATFORM | LOGD_DEVICE | LOGD_DHCP)
+
 extern NMLogDomain _nm_logging_enabled_state[_LOGL_N_REAL];
+extern NMLogDomain _nm_logging_trace_ring_domains;
 static inline gboolean
 nm_logging_enabled (NMLogLevel level, NMLogDomain domain)
 {
 	nm_assert (((guint) level) < G_N_ELEMENTS (_nm_logging_enabled_state));
 	return    (((guint) level) < G_N_ELEMENTS (_nm_logging_enabled_state))
-	       && !!(_nm_logging_enabled_state[level] & domain);
+	       && (   !!(_nm_logging_enabled_state[level] & domain)
+	           || (   level == LOGL_TRACE
+	               && !!(_nm_logging_trace_ring_domains & domain)));
 }
 
 NMLogLevel nm_logging_get_level (NMLogDomain domain);
@@ -245,6 +254,9 @@ void nm_logging_set_prefix (const char *format, ...) _nm_printf (1, 2);
 void     nm_logging_syslog_openlog (const char *logging_backend, gboolean debug);
 gboolean nm_logging_syslog_enabled (void);
 
+void nm_logging_trace_ring_set_enabled (gboolean enabled);
+char **nm_logging_trace_ring_dump (void);
+
 /*****************************************************************************/
 
 /* This is the default definition of _NMLOG_ENABLED(). Special implementations
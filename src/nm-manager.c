@@ -5944,6 +5944,32 @@ impl_manager_get_logging (NMDBusObject *obj,
 	                                                      nm_logging_domains_to_string ()));
 }
 
+static void
+impl_manager_dump_logging (NMDBusObject *obj,
+                           const NMDBusInterfaceInfoExtended *interface_info,
+                           const NMDBusMethodInfoExtended *method_info,
+                           GDBusConnection *connection,
+                           const char *sender,
+                           GDBusMethodInvocation *invocation,
+                           GVariant *parameters)
+{
+	NMManager *self = NM_MANAGER (obj);
+	gs_strfreev char **entries = NULL;
+
+	/* the trace messages may contain sensitive data. Only root
+	 * may read them. */
+	if (!nm_dbus_manager_ensure_uid (nm_dbus_object_get_manager (NM_DBUS_OBJECT (self)),
+	                                 invocation,
+	                                 0,
+	                                 NM_MANAGER_ERROR,
+	                                 NM_MANAGER_ERROR_PERMISSION_DENIED))
+		return;
+
+	entries = nm_logging_trace_ring_dump ();
+	g_dbus_method_invocation_return_value (invocation,
+	                                       g_variant_new ("(^as)", entries));
+}
+
 typedef struct {
 	NMManager *self;
 	GDBusMethodInvocation *context;
@@ -7555,6 +7581,15 @@ static const NMDBusInterfaceInfoExtended interface_info_manager = {
 				),
 				.handle = impl_manager_get_logging,
 			),
+			NM_DEFINE_DBUS_METHOD_INFO_EXTENDED (
+				NM_DEFINE_GDBUS_METHOD_INFO_INIT (
+					"DumpLogging",
+					.out_args = NM_DEFINE_GDBUS_ARG_INFOS (
+						NM_DEFINE_GDBUS_ARG_INFO ("entries", "as"),
+					),
+				),
+				.handle = impl_manager_dump_logging,
+			),
 			NM_DEFINE_DBUS_METHOD_INFO_EXTENDED (
 				NM_DEFINE_GDBUS_METHOD_INFO_INIT (
 					"CheckConnectivity",
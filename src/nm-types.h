@@ -196,6 +196,7 @@ typedef enum {
 
 	NMP_OBJECT_TYPE_TFILTER,
 
+	NMP_OBJECT_TYPE_LNK_BRIDGE,
 	NMP_OBJECT_TYPE_LNK_GRE,
 	NMP_OBJECT_TYPE_LNK_GRETAP,
 	NMP_OBJECT_TYPE_LNK_INFINIBAND,
@@ -27,6 +27,7 @@
 #include <unistd.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
+#include <sys/stat.h>
 #include <fcntl.h>
 #include <dlfcn.h>
 #include <arpa/inet.h>
@@ -140,6 +141,22 @@ enum {
 #define __IFLA_TUN_MAX                  10
 #define IFLA_TUN_MAX (__IFLA_TUN_MAX - 1)
 
+#define IFLA_INFO_SLAVE_KIND            4
+#define IFLA_INFO_SLAVE_DATA            5
+
+#define IFLA_BR_FORWARD_DELAY           1
+#define IFLA_BR_HELLO_TIME              2
+#define IFLA_BR_MAX_AGE                 3
+#define IFLA_BR_AGEING_TIME             4
+#define IFLA_BR_STP_STATE               5
+#define IFLA_BR_PRIORITY                6
+#define IFLA_BR_GROUP_FWD_MASK          9
+#define IFLA_BR_MCAST_SNOOPING          23
+
+#define IFLA_BRPORT_PRIORITY            2
+#define IFLA_BRPORT_COST                3
+#define IFLA_BRPORT_MODE                4
+
 static const gboolean RTA_PREF_SUPPORTED_AT_COMPILETIME = (RTA_MAX >= 20 /* RTA_PREF */);
 
 G_STATIC_ASSERT (RTA_MAX == (__RTA_MAX - 1));
@@ -372,6 +389,9 @@ typedef struct {
 	bool sysctl_get_warned;
 	GHashTable *sysctl_get_prev_values;
 
+	/* per-ifindex cache of open sysfs/sysctl directories, see SysctlIfaceData. */
+	GHashTable *sysctl_iface_cache;
+
 	NMUdevClient *udev_client;
 
 	struct {
@@ -1208,6 +1228,60 @@ _parse_af_inet6 (NMPlatform *platform,
 
 /*****************************************************************************/
 
+static NMPObject *
+_parse_lnk_bridge (const char *kind, struct nlattr *info_data)
+{
+	static const struct nla_policy policy[IFLA_BR_MCAST_SNOOPING + 1] = {
+		[IFLA_BR_FORWARD_DELAY]  = { .type = NLA_U32 },
+		[IFLA_BR_HELLO_TIME]     = { .type = NLA_U32 },
+		[IFLA_BR_MAX_AGE]        = { .type = NLA_U32 },
+		[IFLA_BR_AGEING_TIME]    = { .type = NLA_U32 },
+		[IFLA_BR_STP_STATE]      = { .type = NLA_U32 },
+		[IFLA_BR_PRIORITY]       = { .type = NLA_U16 },
+		[IFLA_BR_GROUP_FWD_MASK] = { .type = NLA_U16 },
+		[IFLA_BR_MCAST_SNOOPING] = { .type = NLA_U8 },
+	};
+	struct nlattr *tb[IFLA_BR_MCAST_SNOOPING + 1];
+	int err;
+	NMPObject *obj;
+	NMPlatformLnkBridge *props;
+
+	if (!info_data || !nm_streq0 (kind, "bridge"))
+		return NULL;
+
+	err = nla_parse_nested (tb, IFLA_BR_MCAST_SNOOPING, info_data, policy);
+	if (err < 0)
+		return NULL;
+
+	/* Older kernels only expose part of the options via netlink. In that case
+	 * we don't provide lnk data at all, so that users fall back to sysfs. */
+	if (   !tb[IFLA_BR_FORWARD_DELAY]
+	    || !tb[IFLA_BR_HELLO_TIME]
+	    || !tb[IFLA_BR_MAX_AGE]
+	    || !tb[IFLA_BR_AGEING_TIME]
+	    || !tb[IFLA_BR_STP_STATE]
+	    || !tb[IFLA_BR_PRIORITY]
+	    || !tb[IFLA_BR_GROUP_FWD_MASK]
+	    || !tb[IFLA_BR_MCAST_SNOOPING])
+		return NULL;
+
+	obj = nmp_object_new (NMP_OBJECT_TYPE_LNK_BRIDGE, NULL);
+	props = &obj->lnk_bridge;
+
+	props->forward_delay = nla_get_u32 (tb[IFLA_BR_FORWARD_DELAY]);
+	props->hello_time = nla_get_u32 (tb[IFLA_BR_HELLO_TIME]);
+	props->max_age = nla_get_u32 (tb[IFLA_BR_MAX_AGE]);
+	props->ageing_time = nla_get_u32 (tb[IFLA_BR_AGEING_TIME]);
+	props->stp_state = nla_get_u32 (tb[IFLA_BR_STP_STATE]);
+	props->priority = nla_get_u16 (tb[IFLA_BR_PRIORITY]);
+	props->group_fwd_mask = nla_get_u16 (tb[IFLA_BR_GROUP_FWD_MASK]);
+	props->mcast_snooping = !!nla_get_u8 (tb[IFLA_BR_MCAST_SNOOPING]);
+
+	return obj;
+}
+
+/*****************************************************************************/
+
 static NMPObject *
 _parse_lnk_gre (const char *kind, struct nlattr *info_data)
 {
@@ -2461,6 +2535,9 @@ _new_from_nl_link (NMPlatform *platform, const NMPCache *cache, struct nlmsghdr
 	}
 
 	switch (obj->link.type) {
+	case NM_LINK_TYPE_BRIDGE:
+		lnk_data = _parse_lnk_bridge (nl_info_kind, nl_info_data);
+		break;
 	case NM_LINK_TYPE_GRE:
 	case NM_LINK_TYPE_GRETAP:
 		lnk_data = _parse_lnk_gre (nl_info_kind, nl_info_data);
@@ -3918,6 +3995,278 @@ sysctl_get (NMPlatform *platform, const char *pathid, int dirfd, const char *pat
 
 /*****************************************************************************/
 
+/* For each interface we keep the directories /sys/class/net/$IFNAME and
+ * /proc/sys/net/ipv{4,6}/conf/$IFNAME open, so that repeated sysctl accesses
+ * don't have to resolve the path every time.
+ *
+ * Only the directories are cached, not the values: the sysctls can also be
+ * changed by kernel or by other tools behind our back.
+ *
+ * The entry is dropped when the link gets removed or renamed, see
+ * _sysctl_iface_cache_on_link_change(). */
+typedef struct {
+	int ifindex;
+	char ifname[IFNAMSIZ];
+	int dirfd_netdir;
+	int dirfd_ip_conf[2];
+} SysctlIfaceData;
+
+#define _IP_CONF_IDX(addr_family) ((addr_family) == AF_INET6 ? 1 : 0)
+
+static void
+_sysctl_iface_data_reset (SysctlIfaceData *data)
+{
+	guint i;
+
+	if (data->dirfd_netdir >= 0) {
+		nm_close (data->dirfd_netdir);
+		data->dirfd_netdir = -1;
+	}
+	for (i = 0; i < 2; i++) {
+		if (data->dirfd_ip_conf[i] >= 0) {
+			nm_close (data->dirfd_ip_conf[i]);
+			data->dirfd_ip_conf[i] = -1;
+		}
+	}
+}
+
+static void
+_sysctl_iface_data_free (gpointer user_data)
+{
+	SysctlIfaceData *data = user_data;
+
+	_sysctl_iface_data_reset (data);
+	g_slice_free (SysctlIfaceData, data);
+}
+
+static SysctlIfaceData *
+_sysctl_iface_cache_get (NMPlatform *platform, int ifindex, const char *ifname)
+{
+	NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE (platform);
+	SysctlIfaceData *data;
+
+	nm_assert (ifindex > 0);
+
+	if (   !ifname
+	    || strlen (ifname) >= IFNAMSIZ)
+		return NULL;
+
+	if (!priv->sysctl_iface_cache)
+		priv->sysctl_iface_cache = g_hash_table_new_full (g_int_hash, g_int_equal, NULL, _sysctl_iface_data_free);
+	else {
+		data = g_hash_table_lookup (priv->sysctl_iface_cache, &ifindex);
+		if (data) {
+			if (!nm_streq (data->ifname, ifname)) {
+				/* the caller knows a different name. Don't trust anything
+				 * we have cached so far. */
+				_sysctl_iface_data_reset (data);
+				strcpy (data->ifname, ifname);
+			}
+			return data;
+		}
+	}
+
+	data = g_slice_new (SysctlIfaceData);
+	*data = (SysctlIfaceData) {
+		.ifindex       = ifindex,
+		.dirfd_netdir  = -1,
+		.dirfd_ip_conf = { -1, -1 },
+	};
+	strcpy (data->ifname, ifname);
+	g_hash_table_insert (priv->sysctl_iface_cache, &data->ifindex, data);
+	return data;
+}
+
+static void
+_sysctl_iface_cache_on_link_change (NMPlatform *platform,
+                                    NMPCacheOpsType cache_op,
+                                    const NMPObject *obj_old,
+                                    const NMPObject *obj_new)
+{
+	NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE (platform);
+
+	if (   !priv->sysctl_iface_cache
+	    || !obj_old)
+		return;
+
+	if (   cache_op == NMP_CACHE_OPS_REMOVED
+	    || (   cache_op == NMP_CACHE_OPS_UPDATED
+	        && obj_new
+	        && (   !obj_new->_link.netlink.is_in_netlink
+	            || !nm_streq (obj_old->link.name, obj_new->link.name))))
+		g_hash_table_remove (priv->sysctl_iface_cache, &obj_old->link.ifindex);
+}
+
+static int
+_sysctl_ip_conf_dirfd (NMPlatform *platform, SysctlIfaceData *data, int addr_family)
+{
+	nm_auto_pop_netns NMPNetns *netns = NULL;
+	int *p_dirfd = &data->dirfd_ip_conf[_IP_CONF_IDX (addr_family)];
+	char path[NM_UTILS_SYSCTL_IP_CONF_PATH_BUFSIZE];
+
+	if (*p_dirfd >= 0)
+		return *p_dirfd;
+
+	if (!nm_platform_netns_push (platform, &netns))
+		return -1;
+
+	nm_sprintf_buf (path,
+	                "/proc/sys/net/%s/conf/%s",
+	                addr_family == AF_INET6 ? "ipv6" : "ipv4",
+	                data->ifname);
+	*p_dirfd = open (path, O_DIRECTORY | O_CLOEXEC);
+	return *p_dirfd;
+}
+
+/* Check whether the cached ip conf directory of the interface went away,
+ * for example because the link was removed or renamed and we didn't yet
+ * process the notification. Other failures, like a property that doesn't
+ * exist, don't invalidate the cached directory. */
+static gboolean
+_sysctl_ip_conf_dir_gone (NMPlatform *platform, SysctlIfaceData *data, int addr_family)
+{
+	nm_auto_pop_netns NMPNetns *netns = NULL;
+	int dirfd = data->dirfd_ip_conf[_IP_CONF_IDX (addr_family)];
+	char path[NM_UTILS_SYSCTL_IP_CONF_PATH_BUFSIZE];
+	struct stat st_path, st_fd;
+
+	if (dirfd < 0)
+		return FALSE;
+
+	if (!nm_platform_netns_push (platform, &netns))
+		return FALSE;
+
+	nm_sprintf_buf (path,
+	                "/proc/sys/net/%s/conf/%s",
+	                addr_family == AF_INET6 ? "ipv6" : "ipv4",
+	                data->ifname);
+	if (stat (path, &st_path) < 0)
+		return NM_IN_SET (errno, ENOENT, ENODEV);
+	if (fstat (dirfd, &st_fd) < 0)
+		return NM_IN_SET (errno, ENOENT, ENODEV);
+
+	/* the name might be taken by another interface meanwhile. */
+	return    st_path.st_dev != st_fd.st_dev
+	       || st_path.st_ino != st_fd.st_ino;
+}
+
+static gboolean
+sysctl_ip_conf_set (NMPlatform *platform,
+                    int addr_family,
+                    int ifindex,
+                    const char *ifname,
+                    const char *property,
+                    const char *value)
+{
+	char pathid[NM_UTILS_SYSCTL_IP_CONF_PATH_BUFSIZE];
+	SysctlIfaceData *data;
+	gs_free char *contents = NULL;
+	int dirfd;
+
+	nm_utils_sysctl_ip_conf_path (addr_family, pathid, ifname, property);
+
+	data = _sysctl_iface_cache_get (platform, ifindex, ifname);
+	if (!data)
+		return sysctl_set (platform, pathid, -1, pathid, value);
+
+	dirfd = _sysctl_ip_conf_dirfd (platform, data, addr_family);
+	if (dirfd < 0)
+		return sysctl_set (platform, pathid, -1, pathid, value);
+
+	/* Compare against what is currently set. Reading is cheap via the
+	 * open directory, while writing may trigger work in kernel. */
+	if (nm_utils_file_get_contents (dirfd, property, 1*1024*1024,
+	                                NM_UTILS_FILE_GET_CONTENTS_FLAG_NONE,
+	                                &contents, NULL, NULL) >= 0) {
+		g_strstrip (contents);
+		if (nm_streq (contents, value)) {
+			_LOGT ("sysctl: skip setting '%s' to '%s' (value unchanged)", pathid, value);
+			return TRUE;
+		}
+	}
+
+	if (!sysctl_set (platform, pathid, dirfd, property, value)) {
+		int errsv = errno;
+
+		if (   NM_IN_SET (errsv, ENOENT, ENODEV)
+		    && _sysctl_ip_conf_dir_gone (platform, data, addr_family)) {
+			/* Reopen the directory on next access. */
+			_sysctl_iface_data_reset (data);
+		}
+		errno = errsv;
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+static char *
+sysctl_ip_conf_get (NMPlatform *platform,
+                    int addr_family,
+                    int ifindex,
+                    const char *ifname,
+                    const char *property)
+{
+	char pathid[NM_UTILS_SYSCTL_IP_CONF_PATH_BUFSIZE];
+	SysctlIfaceData *data;
+	char *contents;
+	int dirfd;
+
+	nm_utils_sysctl_ip_conf_path (addr_family, pathid, ifname, property);
+
+	data = _sysctl_iface_cache_get (platform, ifindex, ifname);
+	if (!data)
+		return sysctl_get (platform, pathid, -1, pathid);
+
+	dirfd = _sysctl_ip_conf_dirfd (platform, data, addr_family);
+	if (dirfd < 0)
+		return sysctl_get (platform, pathid, -1, pathid);
+
+	contents = sysctl_get (platform, pathid, dirfd, property);
+	if (   !contents
+	    && _sysctl_ip_conf_dir_gone (platform, data, addr_family))
+		_sysctl_iface_data_reset (data);
+
+	return contents;
+}
+
+static int
+sysctl_open_netdir (NMPlatform *platform, int ifindex, const char *ifname_guess, char *out_ifname)
+{
+	SysctlIfaceData *data;
+	int fd;
+
+	data = _sysctl_iface_cache_get (platform, ifindex, ifname_guess);
+	if (!data)
+		return nmp_utils_sysctl_open_netdir (ifindex, ifname_guess, out_ifname);
+
+	if (data->dirfd_netdir < 0) {
+		char ifname_verified[IFNAMSIZ];
+
+		fd = nmp_utils_sysctl_open_netdir (ifindex, data->ifname, ifname_verified);
+		if (fd < 0)
+			return -1;
+		if (!nm_streq (ifname_verified, data->ifname)) {
+			/* our name is outdated. Don't cache it. */
+			if (out_ifname)
+				strcpy (out_ifname, ifname_verified);
+			return fd;
+		}
+		data->dirfd_netdir = fd;
+	}
+
+	/* the caller owns the returned file descriptor. */
+	fd = fcntl (data->dirfd_netdir, F_DUPFD_CLOEXEC, 0);
+	if (fd < 0)
+		return nmp_utils_sysctl_open_netdir (ifindex, ifname_guess, out_ifname);
+
+	if (out_ifname)
+		strcpy (out_ifname, data->ifname);
+	return fd;
+}
+
+/*****************************************************************************/
+
 static NMPlatformKernelSupportFlags
 check_kernel_support (NMPlatform *platform,
                       NMPlatformKernelSupportFlags request_flags)
@@ -4448,6 +4797,7 @@ cache_on_change (NMPlatform *platform,
 
 	switch (klass->obj_type) {
 	case NMP_OBJECT_TYPE_LINK:
+		_sysctl_iface_cache_on_link_change (platform, cache_op, obj_old, obj_new);
 		{
 			/* check whether changing a slave link can cause a master link (bridge or bond) to go up/down */
 			if (   obj_old
@@ -5918,6 +6268,83 @@ nla_put_failure:
 	g_return_val_if_reached (FALSE);
 }
 
+static gboolean
+link_bridge_change (NMPlatform *platform, int ifindex, const NMPlatformLnkBridge *props)
+{
+	nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+	struct nlattr *info;
+	struct nlattr *data;
+
+	nlmsg = _nl_msg_new_link (RTM_NEWLINK,
+	                          0,
+	                          ifindex,
+	                          NULL,
+	                          0,
+	                          0);
+	if (!nlmsg)
+		return FALSE;
+
+	if (!(info = nla_nest_start (nlmsg, IFLA_LINKINFO)))
+		goto nla_put_failure;
+
+	NLA_PUT_STRING (nlmsg, IFLA_INFO_KIND, "bridge");
+
+	if (!(data = nla_nest_start (nlmsg, IFLA_INFO_DATA)))
+		goto nla_put_failure;
+
+	NLA_PUT_U32 (nlmsg, IFLA_BR_FORWARD_DELAY, props->forward_delay);
+	NLA_PUT_U32 (nlmsg, IFLA_BR_HELLO_TIME, props->hello_time);
+	NLA_PUT_U32 (nlmsg, IFLA_BR_MAX_AGE, props->max_age);
+	NLA_PUT_U32 (nlmsg, IFLA_BR_AGEING_TIME, props->ageing_time);
+	NLA_PUT_U32 (nlmsg, IFLA_BR_STP_STATE, props->stp_state);
+	NLA_PUT_U16 (nlmsg, IFLA_BR_PRIORITY, props->priority);
+	NLA_PUT_U16 (nlmsg, IFLA_BR_GROUP_FWD_MASK, props->group_fwd_mask);
+	NLA_PUT_U8 (nlmsg, IFLA_BR_MCAST_SNOOPING, !!props->mcast_snooping);
+
+	nla_nest_end (nlmsg, data);
+	nla_nest_end (nlmsg, info);
+
+	return do_change_link (platform, CHANGE_LINK_TYPE_UNSPEC, ifindex, nlmsg, NULL) == NM_PLATFORM_ERROR_SUCCESS;
+nla_put_failure:
+	g_return_val_if_reached (FALSE);
+}
+
+static gboolean
+link_bridge_port_change (NMPlatform *platform, int ifindex, const NMPlatformBridgePort *props)
+{
+	nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+	struct nlattr *info;
+	struct nlattr *data;
+
+	nlmsg = _nl_msg_new_link (RTM_NEWLINK,
+	                          0,
+	                          ifindex,
+	                          NULL,
+	                          0,
+	                          0);
+	if (!nlmsg)
+		return FALSE;
+
+	if (!(info = nla_nest_start (nlmsg, IFLA_LINKINFO)))
+		goto nla_put_failure;
+
+	NLA_PUT_STRING (nlmsg, IFLA_INFO_SLAVE_KIND, "bridge");
+
+	if (!(data = nla_nest_start (nlmsg, IFLA_INFO_SLAVE_DATA)))
+		goto nla_put_failure;
+
+	NLA_PUT_U16 (nlmsg, IFLA_BRPORT_PRIORITY, props->priority);
+	NLA_PUT_U32 (nlmsg, IFLA_BRPORT_COST, props->path_cost);
+	NLA_PUT_U8 (nlmsg, IFLA_BRPORT_MODE, !!props->hairpin_mode);
+
+	nla_nest_end (nlmsg, data);
+	nla_nest_end (nlmsg, info);
+
+	return do_change_link (platform, CHANGE_LINK_TYPE_UNSPEC, ifindex, nlmsg, NULL) == NM_PLATFORM_ERROR_SUCCESS;
+nla_put_failure:
+	g_return_val_if_reached (FALSE);
+}
+
 static char *
 link_get_physical_port_id (NMPlatform *platform, int ifindex)
 {
@@ -7977,6 +8404,8 @@ finalize (GObject *object)
 	g_io_channel_unref (priv->event_channel);
 	nl_socket_free (priv->nlh);
 
+	nm_clear_pointer (&priv->sysctl_iface_cache, g_hash_table_destroy);
+
 	if (priv->sysctl_get_prev_values) {
 		sysctl_clear_cache_list = g_slist_remove (sysctl_clear_cache_list, object);
 		g_hash_table_destroy (priv->sysctl_get_prev_values);
@@ -7999,6 +8428,9 @@ nm_linux_platform_class_init (NMLinuxPlatformClass *klass)
 
 	platform_class->sysctl_set = sysctl_set;
 	platform_class->sysctl_get = sysctl_get;
+	platform_class->sysctl_open_netdir = sysctl_open_netdir;
+	platform_class->sysctl_ip_conf_set = sysctl_ip_conf_set;
+	platform_class->sysctl_ip_conf_get = sysctl_ip_conf_get;
 
 	platform_class->link_add = link_add;
 	platform_class->link_delete = link_delete;
@@ -8024,6 +8456,8 @@ nm_linux_platform_class_init (NMLinuxPlatformClass *klass)
 	platform_class->link_set_name = link_set_name;
 	platform_class->link_set_sriov_params = link_set_sriov_params;
 	platform_class->link_set_sriov_vfs = link_set_sriov_vfs;
+	platform_class->link_bridge_change = link_bridge_change;
+	platform_class->link_bridge_port_change = link_bridge_port_change;
 
 	platform_class->link_get_physical_port_id = link_get_physical_port_id;
 	platform_class->link_get_dev_id = link_get_dev_id;
@@ -34,6 +34,7 @@
 #include <linux/if_tun.h>
 #include <linux/if_tunnel.h>
 #include <linux/rtnetlink.h>
+#include <linux/pkt_sched.h>
 #include <libudev.h>
 
 #include "nm-utils.h"
@@ -419,6 +420,9 @@ nm_platform_sysctl_open_netdir (NMPlatform *self, int ifindex, char *out_ifname)
 	 * the right ifname cached and save if_indextoname() */
 	ifname_guess = nm_platform_link_get_name (self, ifindex);
 
+	if (klass->sysctl_open_netdir)
+		return klass->sysctl_open_netdir (self, ifindex, ifname_guess, out_ifname);
+
 	return nmp_utils_sysctl_open_netdir (ifindex, ifname_guess, out_ifname);
 }
 
@@ -448,6 +452,110 @@ nm_platform_sysctl_set (NMPlatform *self, const char *pathid, int dirfd, const c
 	return klass->sysctl_set (self, pathid, dirfd, path, value);
 }
 
+/**
+ * nm_platform_sysctl_ip_conf_set:
+ * @self: platform instance
+ * @addr_family: either AF_INET or AF_INET6
+ * @ifindex: the ifindex of @ifname
+ * @ifname: the name of the interface
+ * @property: the name of the property in /proc/sys/net/ipv{4,6}/conf/@ifname
+ * @value: the value to write
+ *
+ * Like nm_platform_sysctl_set() for the per-interface IP sysctls. The
+ * platform implementation may keep the directory of the interface open
+ * and skip writing a value that is currently set already.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean
+nm_platform_sysctl_ip_conf_set (NMPlatform *self,
+                                int addr_family,
+                                int ifindex,
+                                const char *ifname,
+                                const char *property,
+                                const char *value)
+{
+	char buf[NM_UTILS_SYSCTL_IP_CONF_PATH_BUFSIZE];
+
+	_CHECK_SELF (self, klass, FALSE);
+
+	g_return_val_if_fail (ifname, FALSE);
+	g_return_val_if_fail (property, FALSE);
+	g_return_val_if_fail (value, FALSE);
+
+	if (   ifindex > 0
+	    && klass->sysctl_ip_conf_set)
+		return klass->sysctl_ip_conf_set (self, addr_family, ifindex, ifname, property, value);
+
+	return nm_platform_sysctl_set (self,
+	                               NMP_SYSCTL_PATHID_ABSOLUTE (nm_utils_sysctl_ip_conf_path (addr_family, buf, ifname, property)),
+	                               value);
+}
+
+/**
+ * nm_platform_sysctl_ip_conf_get:
+ * @self: platform instance
+ * @addr_family: either AF_INET or AF_INET6
+ * @ifindex: the ifindex of @ifname
+ * @ifname: the name of the interface
+ * @property: the name of the property in /proc/sys/net/ipv{4,6}/conf/@ifname
+ *
+ * The counterpart of nm_platform_sysctl_ip_conf_set().
+ *
+ * Returns: (transfer full): the content of the sysctl.
+ */
+char *
+nm_platform_sysctl_ip_conf_get (NMPlatform *self,
+                                int addr_family,
+                                int ifindex,
+                                const char *ifname,
+                                const char *property)
+{
+	char buf[NM_UTILS_SYSCTL_IP_CONF_PATH_BUFSIZE];
+
+	_CHECK_SELF (self, klass, NULL);
+
+	g_return_val_if_fail (ifname, NULL);
+	g_return_val_if_fail (property, NULL);
+
+	if (   ifindex > 0
+	    && klass->sysctl_ip_conf_get)
+		return klass->sysctl_ip_conf_get (self, addr_family, ifindex, ifname, property);
+
+	return nm_platform_sysctl_get (self,
+	                               NMP_SYSCTL_PATHID_ABSOLUTE (nm_utils_sysctl_ip_conf_path (addr_family, buf, ifname, property)));
+}
+
+gint64
+nm_platform_sysctl_ip_conf_get_int_checked (NMPlatform *self,
+                                            int addr_family,
+                                            int ifindex,
+                                            const char *ifname,
+                                            const char *property,
+                                            guint base,
+                                            gint64 min,
+                                            gint64 max,
+                                            gint64 fallback)
+{
+	gs_free char *value = NULL;
+	gint64 ret;
+	int errsv;
+
+	_CHECK_SELF (self, klass, fallback);
+
+	value = nm_platform_sysctl_ip_conf_get (self, addr_family, ifindex, ifname, property);
+	if (!value) {
+		errno = EINVAL;
+		return fallback;
+	}
+
+	ret = _nm_utils_ascii_str_to_int64 (value, base, min, max, fallback);
+	errsv = errno;
+	nm_clear_g_free (&value);
+	errno = errsv;
+	return ret;
+}
+
 gboolean
 nm_platform_sysctl_set_ip6_hop_limit_safe (NMPlatform *self, const char *iface, int value)
 {
@@ -1511,6 +1619,67 @@ nm_platform_link_set_sriov_vfs (NMPlatform *self, int ifindex, const NMPlatformV
 	return klass->link_set_sriov_vfs (self, ifindex, vfs);
 }
 
+/**
+ * nm_platform_link_bridge_change:
+ * @self: platform instance
+ * @ifindex: Interface index of the bridge
+ * @props: the bridge options to set
+ *
+ * Sets all options of a bridge in one request, instead of writing them
+ * to sysfs one by one.
+ *
+ * Returns: %FALSE if the options couldn't be set, for example because
+ *   the kernel doesn't support changing them via netlink.
+ */
+gboolean
+nm_platform_link_bridge_change (NMPlatform *self, int ifindex, const NMPlatformLnkBridge *props)
+{
+	_CHECK_SELF (self, klass, FALSE);
+
+	g_return_val_if_fail (ifindex > 0, FALSE);
+	g_return_val_if_fail (props, FALSE);
+
+	if (!klass->link_bridge_change)
+		return FALSE;
+
+	_LOGD ("link: setting bridge options for \"%s\" (%d): %s",
+	       nm_platform_link_get_name (self, ifindex),
+	       ifindex,
+	       nm_platform_lnk_bridge_to_string (props, NULL, 0));
+	return klass->link_bridge_change (self, ifindex, props);
+}
+
+/**
+ * nm_platform_link_bridge_port_change:
+ * @self: platform instance
+ * @ifindex: Interface index of the bridge port
+ * @props: the bridge port options to set
+ *
+ * Like nm_platform_link_bridge_change(), but for the options a bridge
+ * has for one of its ports.
+ *
+ * Returns: %FALSE if the options couldn't be set.
+ */
+gboolean
+nm_platform_link_bridge_port_change (NMPlatform *self, int ifindex, const NMPlatformBridgePort *props)
+{
+	_CHECK_SELF (self, klass, FALSE);
+
+	g_return_val_if_fail (ifindex > 0, FALSE);
+	g_return_val_if_fail (props, FALSE);
+
+	if (!klass->link_bridge_port_change)
+		return FALSE;
+
+	_LOGD ("link: setting bridge port options for \"%s\" (%d): priority %u path_cost %u hairpin_mode %d",
+	       nm_platform_link_get_name (self, ifindex),
+	       ifindex,
+	       (guint) props->priority,
+	       (guint) props->path_cost,
+	       (int) props->hairpin_mode);
+	return klass->link_bridge_port_change (self, ifindex, props);
+}
+
 /**
  * nm_platform_link_set_up:
  * @self: platform instance
@@ -1884,6 +2053,12 @@ _link_get_lnk (NMPlatform *self, int ifindex, NMLinkType link_type, const NMPlat
 	return lnk ? &lnk->object : NULL;
 }
 
+const NMPlatformLnkBridge *
+nm_platform_link_get_lnk_bridge (NMPlatform *self, int ifindex, const NMPlatformLink **out_link)
+{
+	return _link_get_lnk (self, ifindex, NM_LINK_TYPE_BRIDGE, out_link);
+}
+
 const NMPlatformLnkGre *
 nm_platform_link_get_lnk_gre (NMPlatform *self, int ifindex, const NMPlatformLink **out_link)
 {
@@ -4889,22 +5064,63 @@ nm_platform_qdisc_add (NMPlatform *self,
 	return klass->qdisc_add (self, flags, qdisc);
 }
 
+static gboolean
+_qdisc_equal_for_sync (const NMPlatformQdisc *known, const NMPlatformQdisc *plat)
+{
+	NMPlatformQdisc q = *known;
+
+	/* tcm_info is filled in by the kernel, we never set it. */
+	q.info = plat->info;
+	/* Without a requested handle, the kernel picks one. */
+	if (!q.handle)
+		q.handle = plat->handle;
+	return nm_platform_qdisc_cmp (&q, plat) == 0;
+}
+
+/* @parent must carry the handle the qdisc actually has in the kernel,
+ * that is, the platform object if the configured one has no handle. */
+static gboolean
+_qdisc_is_below (const NMPlatformQdisc *qdisc, const NMPlatformQdisc *parent)
+{
+	return    parent->handle
+	       && !NM_IN_SET (qdisc->parent, TC_H_ROOT, TC_H_INGRESS)
+	       && TC_H_MAJ (qdisc->parent) == TC_H_MAJ (parent->handle);
+}
+
+/**
+ * nm_platform_qdisc_sync:
+ * @self: the #NMPlatform instance
+ * @ifindex: the ifindex of the link
+ * @known_qdiscs: (allow-none): the qdiscs that should be configured
+ *
+ * Brings the qdiscs of the link in line with @known_qdiscs, which must list
+ * parents before their children. Only the necessary changes are made: qdiscs
+ * already configured identically are left alone, so that reapplying a
+ * profile doesn't interrupt traffic shaping. A qdisc that gets (re)created
+ * takes its children with it, so those are re-added too.
+ *
+ * Returns: %TRUE on success.
+ */
 gboolean
 nm_platform_qdisc_sync (NMPlatform *self,
                         int ifindex,
                         GPtrArray *known_qdiscs)
 {
 	gs_unref_ptrarray GPtrArray *plat_qdiscs = NULL;
+	gs_unref_ptrarray GPtrArray *changed = NULL;
 	NMPLookup lookup;
-	guint i;
+	guint i, j;
 	gboolean success = TRUE;
 	gs_unref_hashtable GHashTable *known_qdiscs_idx = NULL;
+	gs_unref_hashtable GHashTable *plat_qdiscs_idx = NULL;
 
 	nm_assert (NM_IS_PLATFORM (self));
 	nm_assert (ifindex > 0);
 
 	known_qdiscs_idx = g_hash_table_new ((GHashFunc) nmp_object_id_hash,
 	                                     (GEqualFunc) nmp_object_id_equal);
+	plat_qdiscs_idx = g_hash_table_new ((GHashFunc) nmp_object_id_hash,
+	                                    (GEqualFunc) nmp_object_id_equal);
 
 	if (known_qdiscs) {
 		for (i = 0; i < known_qdiscs->len; i++) {
@@ -4920,11 +5136,32 @@ nm_platform_qdisc_sync (NMPlatform *self,
 	                                                                ifindex),
 	                                        NULL, NULL);
 
+	changed = g_ptr_array_new ();
+
 	if (plat_qdiscs) {
 		for (i = 0; i < plat_qdiscs->len; i++) {
 			const NMPObject *q = g_ptr_array_index (plat_qdiscs, i);
 
-			if (!g_hash_table_lookup (known_qdiscs_idx, q))
+			if (g_hash_table_lookup (known_qdiscs_idx, q)) {
+				g_hash_table_insert (plat_qdiscs_idx, (gpointer) q, (gpointer) q);
+				continue;
+			}
+
+			g_ptr_array_add (changed, (gpointer) q);
+		}
+
+		/* Delete the qdiscs we don't know about, except those that go away
+		 * together with a parent that gets deleted. */
+		for (i = 0; i < changed->len; i++) {
+			const NMPObject *q = changed->pdata[i];
+
+			for (j = 0; j < changed->len; j++) {
+				if (   j != i
+				    && _qdisc_is_below (NMP_OBJECT_CAST_QDISC (q),
+				                        NMP_OBJECT_CAST_QDISC (changed->pdata[j])))
+					break;
+			}
+			if (j == changed->len)
 				success &= nm_platform_object_delete (self, q);
 		}
 	}
@@ -4932,12 +5169,39 @@ nm_platform_qdisc_sync (NMPlatform *self,
 	if (known_qdiscs) {
 		for (i = 0; i < known_qdiscs->len; i++) {
 			const NMPObject *q = g_ptr_array_index (known_qdiscs, i);
+			const NMPObject *plat_q;
+			gboolean parent_changed = FALSE;
+
+			for (j = 0; j < changed->len; j++) {
+				if (_qdisc_is_below (NMP_OBJECT_CAST_QDISC (q),
+				                     NMP_OBJECT_CAST_QDISC (changed->pdata[j]))) {
+					parent_changed = TRUE;
+					break;
+				}
+			}
+
+			plat_q = g_hash_table_lookup (plat_qdiscs_idx, q);
+			if (   plat_q
+			    && !parent_changed
+			    && _qdisc_equal_for_sync (NMP_OBJECT_CAST_QDISC (q), NMP_OBJECT_CAST_QDISC (plat_q)))
+				continue;
 
-			success &= (nm_platform_qdisc_add (self, NMP_NLM_FLAG_ADD,
+			success &= (nm_platform_qdisc_add (self,
+			                                   plat_q ? NMP_NLM_FLAG_REPLACE : NMP_NLM_FLAG_ADD,
 			                                   NMP_OBJECT_CAST_QDISC (q)) == NM_PLATFORM_ERROR_SUCCESS);
+			g_ptr_array_add (changed, (gpointer) q);
+			if (   plat_q
+			    && NMP_OBJECT_CAST_QDISC (plat_q)->handle != NMP_OBJECT_CAST_QDISC (q)->handle)
+				g_ptr_array_add (changed, (gpointer) plat_q);
 		}
 	}
 
+	/* The kernel doesn't notify about filters that vanished together with
+	 * their qdisc. Make sure a following nm_platform_tfilter_sync() doesn't
+	 * work on stale data. */
+	if (changed->len)
+		nm_platform_refresh_all (self, NMP_OBJECT_TYPE_TFILTER);
+
 	return success;
 }
 
@@ -4954,6 +5218,35 @@ nm_platform_tfilter_add (NMPlatform *self,
 	return klass->tfilter_add (self, flags, tfilter);
 }
 
+static gboolean
+_tfilter_equal_for_sync (const NMPlatformTfilter *known, const NMPlatformTfilter *plat)
+{
+	NMPlatformTfilter f;
+
+	/* The actions of a filter are not read back from the kernel, so we can't
+	 * tell whether they match. Always re-add such filters. */
+	if (known->action.kind)
+		return FALSE;
+
+	f = *known;
+	/* Unless we request a priority, the kernel picks one. */
+	if (!TC_H_MAJ (f.info))
+		f.info = TC_H_MAKE (TC_H_MAJ (plat->info), TC_H_MIN (f.info));
+	return nm_platform_tfilter_cmp (&f, plat) == 0;
+}
+
+/**
+ * nm_platform_tfilter_sync:
+ * @self: the #NMPlatform instance
+ * @ifindex: the ifindex of the link
+ * @known_tfilters: (allow-none): the filters that should be configured
+ *
+ * Brings the filters of the link in line with @known_tfilters, leaving
+ * alone the ones already configured identically. Call it after
+ * nm_platform_qdisc_sync(), as the filters are attached to qdiscs.
+ *
+ * Returns: %TRUE on success.
+ */
 gboolean
 nm_platform_tfilter_sync (NMPlatform *self,
                           int ifindex,
@@ -4964,12 +5257,15 @@ nm_platform_tfilter_sync (NMPlatform *self,
 	guint i;
 	gboolean success = TRUE;
 	gs_unref_hashtable GHashTable *known_tfilters_idx = NULL;
+	gs_unref_hashtable GHashTable *plat_tfilters_idx = NULL;
 
 	nm_assert (NM_IS_PLATFORM (self));
 	nm_assert (ifindex > 0);
 
 	known_tfilters_idx = g_hash_table_new ((GHashFunc) nmp_object_id_hash,
 	                                       (GEqualFunc) nmp_object_id_equal);
+	plat_tfilters_idx = g_hash_table_new ((GHashFunc) nmp_object_id_hash,
+	                                      (GEqualFunc) nmp_object_id_equal);
 
 	if (known_tfilters) {
 		for (i = 0; i < known_tfilters->len; i++) {
@@ -4991,14 +5287,23 @@ nm_platform_tfilter_sync (NMPlatform *self,
 
 			if (!g_hash_table_lookup (known_tfilters_idx, q))
 				success &= nm_platform_object_delete (self, q);
+			else
+				g_hash_table_insert (plat_tfilters_idx, (gpointer) q, (gpointer) q);
 		}
 	}
 
 	if (known_tfilters) {
 		for (i = 0; i < known_tfilters->len; i++) {
 			const NMPObject *q = g_ptr_array_index (known_tfilters, i);
+			const NMPObject *plat_q;
 
-			success &= (nm_platform_tfilter_add (self, NMP_NLM_FLAG_ADD,
+			plat_q = g_hash_table_lookup (plat_tfilters_idx, q);
+			if (   plat_q
+			    && _tfilter_equal_for_sync (NMP_OBJECT_CAST_TFILTER (q), NMP_OBJECT_CAST_TFILTER (plat_q)))
+				continue;
+
+			success &= (nm_platform_tfilter_add (self,
+			                                     plat_q ? NMP_NLM_FLAG_REPLACE : NMP_NLM_FLAG_ADD,
 			                                     NMP_OBJECT_CAST_TFILTER (q)) == NM_PLATFORM_ERROR_SUCCESS);
 		}
 	}
@@ -5161,6 +5466,32 @@ nm_platform_link_to_string (const NMPlatformLink *link, char *buf, gsize len)
 	return buf;
 }
 
+const char *
+nm_platform_lnk_bridge_to_string (const NMPlatformLnkBridge *lnk, char *buf, gsize len)
+{
+	if (!nm_utils_to_string_buffer_init_null (lnk, &buf, &len))
+		return buf;
+
+	g_snprintf (buf, len,
+	            "forward_delay %u"
+	            " hello_time %u"
+	            " max_age %u"
+	            " ageing_time %u"
+	            " stp_state %u"
+	            " priority %u"
+	            " group_fwd_mask %#x"
+	            " mcast_snooping %d",
+	            lnk->forward_delay,
+	            lnk->hello_time,
+	            lnk->max_age,
+	            lnk->ageing_time,
+	            lnk->stp_state,
+	            (guint) lnk->priority,
+	            (guint) lnk->group_fwd_mask,
+	            (int) lnk->mcast_snooping);
+	return buf;
+}
+
 const char *
 nm_platform_lnk_gre_to_string (const NMPlatformLnkGre *lnk, char *buf, gsize len)
 {
@@ -6198,6 +6529,36 @@ nm_platform_link_cmp (const NMPlatformLink *a, const NMPlatformLink *b)
 	return 0;
 }
 
+void
+nm_platform_lnk_bridge_hash_update (const NMPlatformLnkBridge *obj, NMHashState *h)
+{
+	nm_hash_update_vals (h,
+	                     obj->forward_delay,
+	                     obj->hello_time,
+	                     obj->max_age,
+	                     obj->ageing_time,
+	                     obj->stp_state,
+	                     obj->priority,
+	                     obj->group_fwd_mask,
+	                     NM_HASH_COMBINE_BOOLS (guint8,
+	                                            obj->mcast_snooping));
+}
+
+int
+nm_platform_lnk_bridge_cmp (const NMPlatformLnkBridge *a, const NMPlatformLnkBridge *b)
+{
+	NM_CMP_SELF (a, b);
+	NM_CMP_FIELD (a, b, forward_delay);
+	NM_CMP_FIELD (a, b, hello_time);
+	NM_CMP_FIELD (a, b, max_age);
+	NM_CMP_FIELD (a, b, ageing_time);
+	NM_CMP_FIELD (a, b, stp_state);
+	NM_CMP_FIELD (a, b, priority);
+	NM_CMP_FIELD (a, b, group_fwd_mask);
+	NM_CMP_FIELD_BOOL (a, b, mcast_snooping);
+	return 0;
+}
+
 void
 nm_platform_lnk_gre_hash_update (const NMPlatformLnkGre *obj, NMHashState *h)
 {
@@ -627,6 +627,24 @@ typedef struct {
 	gint8 trust;
 } NMPlatformVF;
 
+typedef struct {
+	/* time values are in USER_HZ, like in sysfs. */
+	guint32 forward_delay;
+	guint32 hello_time;
+	guint32 max_age;
+	guint32 ageing_time;
+	guint32 stp_state;
+	guint16 priority;
+	guint16 group_fwd_mask;
+	bool mcast_snooping:1;
+} NMPlatformLnkBridge;
+
+typedef struct {
+	guint32 path_cost;
+	guint16 priority;
+	bool hairpin_mode:1;
+} NMPlatformBridgePort;
+
 typedef struct {
 	in_addr_t local;
 	in_addr_t remote;
@@ -789,6 +807,9 @@ typedef struct {
 
 	gboolean (*sysctl_set) (NMPlatform *, const char *pathid, int dirfd, const char *path, const char *value);
 	char * (*sysctl_get) (NMPlatform *, const char *pathid, int dirfd, const char *path);
+	int (*sysctl_open_netdir) (NMPlatform *, int ifindex, const char *ifname_guess, char *out_ifname);
+	gboolean (*sysctl_ip_conf_set) (NMPlatform *, int addr_family, int ifindex, const char *ifname, const char *property, const char *value);
+	char * (*sysctl_ip_conf_get) (NMPlatform *, int addr_family, int ifindex, const char *ifname, const char *property);
 
 	void (*refresh_all) (NMPlatform *self, NMPObjectType obj_type);
 
@@ -827,6 +848,8 @@ typedef struct {
 	gboolean (*link_set_name) (NMPlatform *, int ifindex, const char *name);
 	gboolean (*link_set_sriov_params) (NMPlatform *, int ifindex, guint num_vfs, int autoprobe);
 	gboolean (*link_set_sriov_vfs) (NMPlatform *self, int ifindex, const NMPlatformVF *const *vfs);
+	gboolean (*link_bridge_change) (NMPlatform *self, int ifindex, const NMPlatformLnkBridge *props);
+	gboolean (*link_bridge_port_change) (NMPlatform *self, int ifindex, const NMPlatformBridgePort *props);
 
 	char *   (*link_get_physical_port_id) (NMPlatform *, int ifindex);
 	guint    (*link_get_dev_id) (NMPlatform *, int ifindex);
@@ -1120,6 +1143,10 @@ char *nm_platform_sysctl_get (NMPlatform *self, const char *pathid, int dirfd, c
 gint32 nm_platform_sysctl_get_int32 (NMPlatform *self, const char *pathid, int dirfd, const char *path, gint32 fallback);
 gint64 nm_platform_sysctl_get_int_checked (NMPlatform *self, const char *pathid, int dirfd, const char *path, guint base, gint64 min, gint64 max, gint64 fallback);
 
+gboolean nm_platform_sysctl_ip_conf_set (NMPlatform *self, int addr_family, int ifindex, const char *ifname, const char *property, const char *value);
+char *nm_platform_sysctl_ip_conf_get (NMPlatform *self, int addr_family, int ifindex, const char *ifname, const char *property);
+gint64 nm_platform_sysctl_ip_conf_get_int_checked (NMPlatform *self, int addr_family, int ifindex, const char *ifname, const char *property, guint base, gint64 min, gint64 max, gint64 fallback);
+
 gboolean nm_platform_sysctl_set_ip6_hop_limit_safe (NMPlatform *self, const char *iface, int value);
 
 const char *nm_platform_if_indextoname (NMPlatform *self, int ifindex, char *out_ifname/* of size IFNAMSIZ */);
@@ -1218,6 +1245,8 @@ NMPlatformError nm_platform_link_set_mtu (NMPlatform *self, int ifindex, guint32
 gboolean nm_platform_link_set_name (NMPlatform *self, int ifindex, const char *name);
 gboolean nm_platform_link_set_sriov_params (NMPlatform *self, int ifindex, guint num_vfs, int autoprobe);
 gboolean nm_platform_link_set_sriov_vfs (NMPlatform *self, int ifindex, const NMPlatformVF *const *vfs);
+gboolean nm_platform_link_bridge_change (NMPlatform *self, int ifindex, const NMPlatformLnkBridge *props);
+gboolean nm_platform_link_bridge_port_change (NMPlatform *self, int ifindex, const NMPlatformBridgePort *props);
 
 char    *nm_platform_link_get_physical_port_id (NMPlatform *self, int ifindex);
 guint    nm_platform_link_get_dev_id (NMPlatform *self, int ifindex);
@@ -1241,6 +1270,7 @@ gboolean nm_platform_sysctl_slave_set_option (NMPlatform *self, int ifindex, con
 char *nm_platform_sysctl_slave_get_option (NMPlatform *self, int ifindex, const char *option);
 
 const NMPObject *nm_platform_link_get_lnk (NMPlatform *self, int ifindex, NMLinkType link_type, const NMPlatformLink **out_link);
+const NMPlatformLnkBridge *nm_platform_link_get_lnk_bridge (NMPlatform *self, int ifindex, const NMPlatformLink **out_link);
 const NMPlatformLnkGre *nm_platform_link_get_lnk_gre (NMPlatform *self, int ifindex, const NMPlatformLink **out_link);
 const NMPlatformLnkGre *nm_platform_link_get_lnk_gretap (NMPlatform *self, int ifindex, const NMPlatformLink **out_link);
 const NMPlatformLnkIp6Tnl *nm_platform_link_get_lnk_ip6tnl (NMPlatform *self, int ifindex, const NMPlatformLink **out_link);
@@ -1441,6 +1471,7 @@ gboolean nm_platform_tfilter_sync         (NMPlatform *self,
                                            GPtrArray *known_tfilters);
 
 const char *nm_platform_link_to_string (const NMPlatformLink *link, char *buf, gsize len);
+const char *nm_platform_lnk_bridge_to_string (const NMPlatformLnkBridge *lnk, char *buf, gsize len);
 const char *nm_platform_lnk_gre_to_string (const NMPlatformLnkGre *lnk, char *buf, gsize len);
 const char *nm_platform_lnk_infiniband_to_string (const NMPlatformLnkInfiniband *lnk, char *buf, gsize len);
 const char *nm_platform_lnk_ip6tnl_to_string (const NMPlatformLnkIp6Tnl *lnk, char *buf, gsize len);
@@ -1472,6 +1503,7 @@ const char *nm_platform_wireguard_peer_to_string (const struct _NMPWireGuardPeer
                                                   gsize len);
 
 int nm_platform_link_cmp (const NMPlatformLink *a, const NMPlatformLink *b);
+int nm_platform_lnk_bridge_cmp (const NMPlatformLnkBridge *a, const NMPlatformLnkBridge *b);
 int nm_platform_lnk_gre_cmp (const NMPlatformLnkGre *a, const NMPlatformLnkGre *b);
 int nm_platform_lnk_infiniband_cmp (const NMPlatformLnkInfiniband *a, const NMPlatformLnkInfiniband *b);
 int nm_platform_lnk_ip6tnl_cmp (const NMPlatformLnkIp6Tnl *a, const NMPlatformLnkIp6Tnl *b);
@@ -1509,6 +1541,7 @@ void nm_platform_ip4_address_hash_update (const NMPlatformIP4Address *obj, NMHas
 void nm_platform_ip6_address_hash_update (const NMPlatformIP6Address *obj, NMHashState *h);
 void nm_platform_ip4_route_hash_update (const NMPlatformIP4Route *obj, NMPlatformIPRouteCmpType cmp_type, NMHashState *h);
 void nm_platform_ip6_route_hash_update (const NMPlatformIP6Route *obj, NMPlatformIPRouteCmpType cmp_type, NMHashState *h);
+void nm_platform_lnk_bridge_hash_update (const NMPlatformLnkBridge *obj, NMHashState *h);
 void nm_platform_lnk_gre_hash_update (const NMPlatformLnkGre *obj, NMHashState *h);
 void nm_platform_lnk_infiniband_hash_update (const NMPlatformLnkInfiniband *obj, NMHashState *h);
 void nm_platform_lnk_ip6tnl_hash_update (const NMPlatformLnkIp6Tnl *obj, NMHashState *h);
@@ -204,6 +204,10 @@ typedef struct {
 	int wireguard_family_id;
 } NMPObjectLink;
 
+typedef struct {
+	NMPlatformLnkBridge _public;
+} NMPObjectLnkBridge;
+
 typedef struct {
 	NMPlatformLnkGre _public;
 } NMPObjectLnkGre;
@@ -294,6 +298,9 @@ struct _NMPObject {
 		NMPlatformLink          link;
 		NMPObjectLink           _link;
 
+		NMPlatformLnkBridge     lnk_bridge;
+		NMPObjectLnkBridge      _lnk_bridge;
+
 		NMPlatformLnkGre        lnk_gre;
 		NMPObjectLnkGre         _lnk_gre;
 
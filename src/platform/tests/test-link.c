@@ -539,6 +539,61 @@ test_bridge_addr (void)
 
 /*****************************************************************************/
 
+static void
+test_bridge_change (void)
+{
+	const NMPlatformLink *plink = NULL;
+	const NMPlatformLnkBridge *plnk;
+	const NMPObject *lnk;
+	const NMPlatformLnkBridge props = {
+		.forward_delay  = 1200,
+		.hello_time     = 300,
+		.max_age        = 2500,
+		.ageing_time    = 15000,
+		.stp_state      = 0,
+		.priority       = 0x1000,
+		.group_fwd_mask = 0x8,
+		.mcast_snooping = FALSE,
+	};
+	int ifindex;
+
+	g_assert_cmpint (nm_platform_link_bridge_add (NM_PLATFORM_GET, DEVICE_NAME, NULL, 0, &plink), ==, NM_PLATFORM_ERROR_SUCCESS);
+	g_assert (plink);
+	ifindex = plink->ifindex;
+
+	if (!nm_platform_link_get_lnk_bridge (NM_PLATFORM_GET, ifindex, NULL)) {
+		g_test_skip ("Skipping test for bridge options: not exposed via netlink by the kernel");
+		goto out;
+	}
+
+	g_assert (nm_platform_link_bridge_change (NM_PLATFORM_GET, ifindex, &props));
+
+	lnk = nm_platform_link_get_lnk (NM_PLATFORM_GET, ifindex, NM_LINK_TYPE_BRIDGE, &plink);
+	g_assert (plink);
+	g_assert (lnk);
+	g_assert_cmpint (NMP_OBJECT_GET_TYPE (lnk), ==, NMP_OBJECT_TYPE_LNK_BRIDGE);
+	plnk = &lnk->lnk_bridge;
+	g_assert (plnk == nm_platform_link_get_lnk_bridge (NM_PLATFORM_GET, ifindex, NULL));
+
+	if (nmtst_is_debug ())
+		nmtstp_run_command_check ("ip -d link show %s", plink->name);
+
+	g_assert_cmpint (plnk->forward_delay, ==, props.forward_delay);
+	g_assert_cmpint (plnk->hello_time, ==, props.hello_time);
+	g_assert_cmpint (plnk->max_age, ==, props.max_age);
+	g_assert_cmpint (plnk->ageing_time, ==, props.ageing_time);
+	g_assert_cmpint (plnk->stp_state, ==, props.stp_state);
+	g_assert_cmpint (plnk->priority, ==, props.priority);
+	g_assert_cmpint (plnk->group_fwd_mask, ==, props.group_fwd_mask);
+	g_assert (!plnk->mcast_snooping);
+	g_assert_cmpint (nm_platform_lnk_bridge_cmp (plnk, &props), ==, 0);
+
+out:
+	nmtstp_link_del (NULL, -1, ifindex, DEVICE_NAME);
+}
+
+/*****************************************************************************/
+
 static void
 test_internal (void)
 {
@@ -2643,6 +2698,58 @@ test_sysctl_rename (void)
 
 /*****************************************************************************/
 
+static void
+test_sysctl_ip_conf_external (void)
+{
+	NMPlatform *const PL = NM_PLATFORM_GET;
+	const char *const IFNAME = "nm-dummy-0";
+	gs_free char *path = NULL;
+	int ifindex;
+	int i;
+
+	if (_check_sysctl_skip ())
+		return;
+
+	ifindex = nmtstp_link_dummy_add (PL, -1, IFNAME)->ifindex;
+	path = g_strdup_printf ("/proc/sys/net/ipv4/conf/%s/arp_ignore", IFNAME);
+
+	for (i = 0; i < 3; i++) {
+		gs_free char *v = NULL;
+
+		g_assert (nm_platform_sysctl_ip_conf_set (PL, AF_INET, ifindex, IFNAME, "arp_ignore", "1"));
+		v = _get_sysctl_value (path);
+		g_assert_cmpstr (v, ==, "1");
+		nm_clear_g_free (&v);
+
+		/* somebody else changes the value behind our back... */
+		nmtstp_run_command_check ("echo 2 > %s", path);
+		v = nm_platform_sysctl_ip_conf_get (PL, AF_INET, ifindex, IFNAME, "arp_ignore");
+		g_assert_cmpstr (v, ==, "2");
+		nm_clear_g_free (&v);
+
+		/* ... and setting it again must not be skipped. */
+		g_assert (nm_platform_sysctl_ip_conf_set (PL, AF_INET, ifindex, IFNAME, "arp_ignore", "1"));
+		v = _get_sysctl_value (path);
+		g_assert_cmpstr (v, ==, "1");
+		nm_clear_g_free (&v);
+
+		nmtstp_run_command_check ("echo 0 > %s", path);
+	}
+
+	/* a property that doesn't exist fails, but keeps the directory usable. */
+	g_assert (!nm_platform_sysctl_ip_conf_get (PL, AF_INET, ifindex, IFNAME, "does-not-exist"));
+	g_assert (nm_platform_sysctl_ip_conf_set (PL, AF_INET, ifindex, IFNAME, "arp_ignore", "1"));
+	{
+		gs_free char *v = _get_sysctl_value (path);
+
+		g_assert_cmpstr (v, ==, "1");
+	}
+
+	nmtstp_link_del (PL, -1, ifindex, IFNAME);
+}
+
+/*****************************************************************************/
+
 static void
 test_sysctl_netns_switch (void)
 {
@@ -2844,6 +2951,7 @@ _nmtstp_setup_tests (void)
 	g_test_add_func ("/link/software/team", test_team);
 	g_test_add_func ("/link/software/vlan", test_vlan);
 	g_test_add_func ("/link/software/bridge/addr", test_bridge_addr);
+	g_test_add_func ("/link/software/bridge/change", test_bridge_change);
 
 	if (nmtstp_is_root_test ()) {
 		g_test_add_func ("/link/external", test_external);
@@ -2878,6 +2986,7 @@ _nmtstp_setup_tests (void)
 		g_test_add_vtable ("/general/netns/bind-to-path", 0, NULL, _test_netns_setup, test_netns_bind_to_path, _test_netns_teardown);
 
 		g_test_add_func ("/general/sysctl/rename", test_sysctl_rename);
+		g_test_add_func ("/general/sysctl/ip-conf-external", test_sysctl_ip_conf_external);
 		g_test_add_func ("/general/sysctl/netns-switch", test_sysctl_netns_switch);
 
 		g_test_add_func ("/link/ethtool/features/get", test_ethtool_features_get);
@@ -129,8 +129,15 @@ typedef struct _NMSettingsConnectionPrivate {
 
 	guint64 timestamp;   /* Up-to-date timestamp of connection use */
 
+	/* The reply for GetSettings(), without secrets. It is shared by all
+	 * callers until the connection, its timestamp or seen-bssids change. */
+	GVariant *getsettings_cached;
+
 	guint64 last_secret_agent_version_id;
 
+	/* bumped whenever the content of the connection changes. */
+	guint64 version_id;
+
 	int autoconnect_retries;
 	gint32 autoconnect_retries_blocked_until;
 
@@ -206,6 +213,22 @@ nm_settings_connection_get_last_secret_agent_version_id (NMSettingsConnection *s
 	return NM_SETTINGS_CONNECTION_GET_PRIVATE (self)->last_secret_agent_version_id;
 }
 
+/**
+ * nm_settings_connection_get_version_id:
+ * @self: the #NMSettingsConnection
+ *
+ * Returns: an id that changes every time the content of the connection
+ *   changes. The ids are unique across all connections, so that a profile
+ *   that was deleted and added again with the same UUID has a different one.
+ */
+guint64
+nm_settings_connection_get_version_id (NMSettingsConnection *self)
+{
+	g_return_val_if_fail (NM_IS_SETTINGS_CONNECTION (self), 0);
+
+	return NM_SETTINGS_CONNECTION_GET_PRIVATE (self)->version_id;
+}
+
 /*****************************************************************************/
 
 /* Return TRUE to keep, FALSE to drop */
@@ -551,9 +574,27 @@ set_persist_mode (NMSettingsConnection *self, NMSettingsConnectionPersistMode pe
 	nm_settings_connection_set_flags_full (self, ALL, flags);
 }
 
+static void
+_getsettings_cached_clear (NMSettingsConnection *self)
+{
+	NMSettingsConnectionPrivate *priv = NM_SETTINGS_CONNECTION_GET_PRIVATE (self);
+
+	g_clear_pointer (&priv->getsettings_cached, g_variant_unref);
+}
+
+static guint64
+_version_id_next (void)
+{
+	static guint64 id = 0;
+
+	return ++id;
+}
+
 static void
 _emit_updated (NMSettingsConnection *self, gboolean by_user)
 {
+	NM_SETTINGS_CONNECTION_GET_PRIVATE (self)->version_id = _version_id_next ();
+	_getsettings_cached_clear (self);
 	nm_dbus_object_emit_signal (NM_DBUS_OBJECT (self),
 	                            &interface_info_settings_connection,
 	                            &signal_info_updated,
@@ -818,6 +859,7 @@ nm_settings_connection_delete (NMSettingsConnection *self,
 	gs_unref_object NMSettingsConnection *self_keep_alive = NULL;
 	NMSettingsConnectionPrivate *priv = NM_SETTINGS_CONNECTION_GET_PRIVATE (self);
 	NMConnection *for_agents;
+	const char *path;
 
 	g_return_val_if_fail (NM_IS_SETTINGS_CONNECTION (self), FALSE);
 
@@ -828,13 +870,15 @@ nm_settings_connection_delete (NMSettingsConnection *self,
 
 	set_visible (self, FALSE);
 
-	/* Tell agents to remove secrets for this connection */
-	for_agents = nm_simple_connection_new_clone (nm_settings_connection_get_connection (self));
-	nm_connection_clear_secrets (for_agents);
-	nm_agent_manager_delete_secrets (priv->agent_mgr,
-	                                 nm_dbus_object_get_path (NM_DBUS_OBJECT (self)),
-	                                 for_agents);
-	g_object_unref (for_agents);
+	/* Tell agents to remove secrets for this connection. A connection
+	 * that was never exported has no secrets stored by agents. */
+	path = nm_dbus_object_get_path (NM_DBUS_OBJECT (self));
+	if (path) {
+		for_agents = nm_simple_connection_new_clone (nm_settings_connection_get_connection (self));
+		nm_connection_clear_secrets (for_agents);
+		nm_agent_manager_delete_secrets (priv->agent_mgr, path, for_agents);
+		g_object_unref (for_agents);
+	}
 
 	/* Remove timestamp from timestamps database file */
 	remove_entry_from_db (self, "timestamps");
@@ -1558,18 +1602,13 @@ check_writable (NMConnection *self, GError **error)
 	return TRUE;
 }
 
-static void
-get_settings_auth_cb (NMSettingsConnection *self,
-                      GDBusMethodInvocation *context,
-                      NMAuthSubject *subject,
-                      GError *error,
-                      gpointer data)
+static GVariant *
+_getsettings_cached_get (NMSettingsConnection *self)
 {
-	if (error)
-		g_dbus_method_invocation_return_gerror (context, error);
-	else {
+	NMSettingsConnectionPrivate *priv = NM_SETTINGS_CONNECTION_GET_PRIVATE (self);
+
+	if (!priv->getsettings_cached) {
 		gs_unref_object NMConnection *dupl_con = NULL;
-		GVariant *settings;
 		NMSettingConnection *s_con;
 		NMSettingWireless *s_wifi;
 		guint64 timestamp = 0;
@@ -1600,10 +1639,28 @@ get_settings_auth_cb (NMSettingsConnection *self,
 		/* Secrets should *never* be returned by the GetSettings method, they
 		 * get returned by the GetSecrets method which can be better
 		 * protected against leakage of secrets to unprivileged callers.
+		 * That also makes the result the same for all callers, so it can
+		 * be cached.
 		 */
-		settings = nm_connection_to_dbus (dupl_con, NM_CONNECTION_SERIALIZE_NO_SECRETS);
+		priv->getsettings_cached = g_variant_ref_sink (nm_connection_to_dbus (dupl_con, NM_CONNECTION_SERIALIZE_NO_SECRETS));
+	}
+
+	return priv->getsettings_cached;
+}
+
+static void
+get_settings_auth_cb (NMSettingsConnection *self,
+                      GDBusMethodInvocation *context,
+                      NMAuthSubject *subject,
+                      GError *error,
+                      gpointer data)
+{
+	if (error)
+		g_dbus_method_invocation_return_gerror (context, error);
+	else {
 		g_dbus_method_invocation_return_value (context,
-		                                       g_variant_new ("(@a{sa{sv}})", settings));
+		                                       g_variant_new ("(@a{sa{sv}})",
+		                                                      _getsettings_cached_get (self)));
 	}
 }
 
@@ -2505,6 +2562,8 @@ nm_settings_connection_update_timestamp (NMSettingsConnection *self,
 	g_return_if_fail (NM_IS_SETTINGS_CONNECTION (self));
 
 	/* Update timestamp in private storage */
+	if (priv->timestamp != timestamp)
+		_getsettings_cached_clear (self);
 	priv->timestamp = timestamp;
 	priv->timestamp_set = TRUE;
 
@@ -2574,6 +2633,7 @@ nm_settings_connection_read_and_fill_timestamp (NMSettingsConnection *self)
 		return;
 	}
 
+	_getsettings_cached_clear (self);
 	priv->timestamp = timestamp;
 	priv->timestamp_set = TRUE;
 }
@@ -2655,6 +2715,7 @@ nm_settings_connection_add_seen_bssid (NMSettingsConnection *self,
 	/* Add the new BSSID; let the hash take ownership of the allocated BSSID string */
 	bssid_str = g_strdup (seen_bssid);
 	g_hash_table_insert (priv->seen_bssids, bssid_str, bssid_str);
+	_getsettings_cached_clear (self);
 
 	/* Build up a list of all the BSSIDs in string form */
 	n = 0;
@@ -2718,6 +2779,8 @@ nm_settings_connection_read_and_fill_seen_bssids (NMSettingsConnection *self)
 	}
 	g_key_file_free (seen_bssids_file);
 
+	_getsettings_cached_clear (self);
+
 	/* Update connection's seen-bssids */
 	if (tmp_strv) {
 		g_hash_table_remove_all (priv->seen_bssids);
@@ -2990,6 +3053,7 @@ nm_settings_connection_init (NMSettingsConnection *self)
 	c_list_init (&self->_connections_lst);
 
 	priv->ready = TRUE;
+	priv->version_id = _version_id_next ();
 	c_list_init (&priv->call_ids_lst_head);
 	c_list_init (&priv->auth_lst_head);
 
@@ -3056,6 +3120,7 @@ dispose (GObject *object)
 	g_clear_object (&priv->agent_secrets);
 
 	g_clear_pointer (&priv->seen_bssids, g_hash_table_destroy);
+	g_clear_pointer (&priv->getsettings_cached, g_variant_unref);
 
 	nm_clear_g_signal_handler (priv->session_monitor, &priv->session_changed_id);
 	g_clear_object (&priv->session_monitor);
@@ -143,6 +143,8 @@ NMConnection *nm_settings_connection_get_connection (NMSettingsConnection *self)
 
 guint64 nm_settings_connection_get_last_secret_agent_version_id (NMSettingsConnection *self);
 
+guint64 nm_settings_connection_get_version_id (NMSettingsConnection *self);
+
 gboolean nm_settings_connection_has_unmodified_applied_connection (NMSettingsConnection *self,
                                                                    NMConnection *applied_connection,
                                                                    NMSettingCompareFlags compare_flage);
@@ -1015,25 +1015,13 @@ secrets_filter_cb (NMSetting *setting,
 	return (flags & filter_flags) ? FALSE : TRUE;
 }
 
-/**
- * nm_settings_add_connection:
- * @self: the #NMSettings object
- * @connection: the source connection to create a new #NMSettingsConnection from
- * @save_to_disk: %TRUE to save the connection to disk immediately, %FALSE to
- * not save to disk
- * @error: on return, a location to store any errors that may occur
- *
- * Creates a new #NMSettingsConnection for the given source @connection.
- * The returned object is owned by @self and the caller must reference
- * the object to continue using it.
- *
- * Returns: the new #NMSettingsConnection or %NULL
- */
-NMSettingsConnection *
-nm_settings_add_connection (NMSettings *self,
-                            NMConnection *connection,
-                            gboolean save_to_disk,
-                            GError **error)
+/* Let the first plugin that supports it write @connection. The returned
+ * connection is owned by the plugin and not yet claimed (exported) by @self. */
+static NMSettingsConnection *
+add_connection_to_plugin (NMSettings *self,
+                          NMConnection *connection,
+                          gboolean save_to_disk,
+                          GError **error)
 {
 	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
 	GSList *iter;
@@ -1086,7 +1074,6 @@ nm_settings_add_connection (NMSettings *self,
 				                              secrets,
 				                              NULL);
 			}
-			claim_connection (self, added);
 			return added;
 		}
 		_LOGD ("Failed to add %s/'%s': %s",
@@ -1101,6 +1088,34 @@ nm_settings_add_connection (NMSettings *self,
 	return NULL;
 }
 
+/**
+ * nm_settings_add_connection:
+ * @self: the #NMSettings object
+ * @connection: the source connection to create a new #NMSettingsConnection from
+ * @save_to_disk: %TRUE to save the connection to disk immediately, %FALSE to
+ * not save to disk
+ * @error: on return, a location to store any errors that may occur
+ *
+ * Creates a new #NMSettingsConnection for the given source @connection.
+ * The returned object is owned by @self and the caller must reference
+ * the object to continue using it.
+ *
+ * Returns: the new #NMSettingsConnection or %NULL
+ */
+NMSettingsConnection *
+nm_settings_add_connection (NMSettings *self,
+                            NMConnection *connection,
+                            gboolean save_to_disk,
+                            GError **error)
+{
+	NMSettingsConnection *added;
+
+	added = add_connection_to_plugin (self, connection, save_to_disk, error);
+	if (added)
+		claim_connection (self, added);
+	return added;
+}
+
 static void
 send_agent_owned_secrets (NMSettings *self,
                           NMSettingsConnection *sett_conn,
@@ -1387,6 +1402,198 @@ impl_settings_add_connection_unsaved (NMDBusObject *obj,
 	settings_add_connection_helper (self, invocation, settings, FALSE);
 }
 
+static void
+pk_add_connections_cb (NMAuthChain *chain,
+                       GError *chain_error,
+                       GDBusMethodInvocation *context,
+                       gpointer user_data)
+{
+	NMSettings *self = NM_SETTINGS (user_data);
+	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
+	gs_unref_ptrarray GPtrArray *added = NULL;
+	GPtrArray *connections;
+	NMAuthCallResult result;
+	NMAuthSubject *subject;
+	GVariantBuilder builder;
+	GError *error = NULL;
+	const char *perm;
+	guint i;
+
+	priv->auths = g_slist_remove (priv->auths, chain);
+
+	perm = nm_auth_chain_get_data (chain, "perm");
+	nm_assert (perm);
+	result = nm_auth_chain_get_result (chain, perm);
+	subject = nm_auth_chain_get_data (chain, "subject");
+	connections = nm_auth_chain_get_data (chain, "connections");
+
+	if (chain_error) {
+		error = g_error_new (NM_SETTINGS_ERROR,
+		                     NM_SETTINGS_ERROR_FAILED,
+		                     "Error checking authorization: %s",
+		                     chain_error->message);
+		goto out;
+	}
+	if (result != NM_AUTH_CALL_RESULT_YES) {
+		error = g_error_new_literal (NM_SETTINGS_ERROR,
+		                             NM_SETTINGS_ERROR_PERMISSION_DENIED,
+		                             "Insufficient privileges.");
+		goto out;
+	}
+
+	/* Write all profiles first, without exporting them. Only when every
+	 * plugin write succeeded, the connections are claimed, so that no
+	 * NewConnection signal is emitted for a request that fails. */
+	added = g_ptr_array_new_full (connections->len, g_object_unref);
+	for (i = 0; i < connections->len; i++) {
+		NMSettingsConnection *sett_conn;
+
+		sett_conn = add_connection_to_plugin (self, connections->pdata[i], TRUE, &error);
+		if (!sett_conn) {
+			g_prefix_error (&error, "connection #%u: ", i);
+			break;
+		}
+		g_ptr_array_add (added, g_object_ref (sett_conn));
+	}
+
+	if (error) {
+		/* all or nothing. Drop the profiles that were already written. */
+		for (i = 0; i < added->len; i++)
+			nm_settings_connection_delete (added->pdata[i], NULL);
+		goto out;
+	}
+
+	for (i = 0; i < added->len; i++)
+		claim_connection (self, added->pdata[i]);
+
+	g_variant_builder_init (&builder, G_VARIANT_TYPE ("ao"));
+	for (i = 0; i < added->len; i++) {
+		NMSettingsConnection *sett_conn = added->pdata[i];
+
+		g_variant_builder_add (&builder, "o", nm_dbus_object_get_path (NM_DBUS_OBJECT (sett_conn)));
+		nm_audit_log_connection_op (NM_AUDIT_OP_CONN_ADD, sett_conn, TRUE, NULL, subject, NULL);
+		if (nm_settings_has_connection (self, sett_conn))
+			send_agent_owned_secrets (self, sett_conn, subject);
+	}
+	g_dbus_method_invocation_return_value (context,
+	                                       g_variant_new ("(ao)", &builder));
+
+out:
+	if (error) {
+		nm_audit_log_connection_op (NM_AUDIT_OP_CONN_ADD, NULL, FALSE, NULL, subject, error->message);
+		g_dbus_method_invocation_take_error (context, error);
+	}
+	nm_auth_chain_destroy (chain);
+}
+
+static void
+impl_settings_add_connections (NMDBusObject *obj,
+                               const NMDBusInterfaceInfoExtended *interface_info,
+                               const NMDBusMethodInfoExtended *method_info,
+                               GDBusConnection *dbus_connection,
+                               const char *sender,
+                               GDBusMethodInvocation *invocation,
+                               GVariant *parameters)
+{
+	NMSettings *self = NM_SETTINGS (obj);
+	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
+	gs_unref_object NMAuthSubject *subject = NULL;
+	gs_unref_ptrarray GPtrArray *connections = NULL;
+	gs_unref_hashtable GHashTable *uuids = NULL;
+	gs_unref_variant GVariant *settings_array = NULL;
+	const char *perm = NM_AUTH_PERMISSION_SETTINGS_MODIFY_OWN;
+	GVariantIter iter;
+	GVariant *settings;
+	NMAuthChain *chain;
+	GError *error = NULL;
+
+	subject = nm_auth_subject_new_unix_process_from_context (invocation);
+	if (!subject) {
+		g_dbus_method_invocation_return_error_literal (invocation,
+		                                               NM_SETTINGS_ERROR,
+		                                               NM_SETTINGS_ERROR_PERMISSION_DENIED,
+		                                               "Unable to determine UID of request.");
+		return;
+	}
+
+	g_variant_get (parameters, "(@aa{sa{sv}})", &settings_array);
+
+	connections = g_ptr_array_new_with_free_func (g_object_unref);
+	uuids = g_hash_table_new (nm_str_hash, g_str_equal);
+
+	/* Validate all profiles upfront, so that the request either
+	 * fails as a whole or is authorized once for all of them. */
+	g_variant_iter_init (&iter, settings_array);
+	while ((settings = g_variant_iter_next_value (&iter))) {
+		gs_unref_variant GVariant *settings_free = settings;
+		gs_unref_object NMConnection *connection = NULL;
+		NMSettingConnection *s_con;
+
+		connection = _nm_simple_connection_new_from_dbus (settings,
+		                                                    NM_SETTING_PARSE_FLAGS_STRICT
+		                                                  | NM_SETTING_PARSE_FLAGS_NORMALIZE,
+		                                                  &error);
+		if (   !connection
+		    || !nm_connection_verify_secrets (connection, &error))
+			goto fail;
+
+		if (is_adhoc_wpa (connection)) {
+			error = g_error_new_literal (NM_SETTINGS_ERROR,
+			                             NM_SETTINGS_ERROR_INVALID_CONNECTION,
+			                             "WPA Ad-Hoc disabled due to kernel bugs");
+			goto fail;
+		}
+
+		if (!nm_auth_is_subject_in_acl_set_error (connection,
+		                                          subject,
+		                                          NM_SETTINGS_ERROR,
+		                                          NM_SETTINGS_ERROR_PERMISSION_DENIED,
+		                                          &error))
+			goto fail;
+
+		if (!nm_g_hash_table_add (uuids, (gpointer) nm_connection_get_uuid (connection))) {
+			error = g_error_new_literal (NM_SETTINGS_ERROR,
+			                             NM_SETTINGS_ERROR_UUID_EXISTS,
+			                             "A connection with this UUID is given more than once.");
+			goto fail;
+		}
+
+		if (nm_settings_get_connection_by_uuid (self, nm_connection_get_uuid (connection))) {
+			error = g_error_new_literal (NM_SETTINGS_ERROR,
+			                             NM_SETTINGS_ERROR_UUID_EXISTS,
+			                             "A connection with this UUID already exists.");
+			goto fail;
+		}
+
+		/* 'modify.own' only suffices if every profile is restricted to the caller. */
+		s_con = nm_connection_get_setting_connection (connection);
+		if (nm_setting_connection_get_num_permissions (s_con) != 1)
+			perm = NM_AUTH_PERMISSION_SETTINGS_MODIFY_SYSTEM;
+
+		g_ptr_array_add (connections, g_steal_pointer (&connection));
+		continue;
+fail:
+		g_prefix_error (&error, "connection #%u: ", connections->len);
+		g_dbus_method_invocation_take_error (invocation, error);
+		return;
+	}
+
+	chain = nm_auth_chain_new_subject (subject, invocation, pk_add_connections_cb, self);
+	if (!chain) {
+		g_dbus_method_invocation_return_error_literal (invocation,
+		                                               NM_SETTINGS_ERROR,
+		                                               NM_SETTINGS_ERROR_PERMISSION_DENIED,
+		                                               "Unable to authenticate the request.");
+		return;
+	}
+
+	priv->auths = g_slist_append (priv->auths, chain);
+	nm_auth_chain_set_data (chain, "perm", (gpointer) perm, NULL);
+	nm_auth_chain_set_data (chain, "connections", g_steal_pointer (&connections), (GDestroyNotify) g_ptr_array_unref);
+	nm_auth_chain_set_data (chain, "subject", g_object_ref (subject), g_object_unref);
+	nm_auth_chain_add_call (chain, perm, TRUE);
+}
+
 static void
 impl_settings_load_connections (NMDBusObject *obj,
                                 const NMDBusInterfaceInfoExtended *interface_info,
@@ -1982,6 +2189,18 @@ static const NMDBusInterfaceInfoExtended interface_info_settings = {
 				),
 				.handle = impl_settings_add_connection_unsaved,
 			),
+			NM_DEFINE_DBUS_METHOD_INFO_EXTENDED (
+				NM_DEFINE_GDBUS_METHOD_INFO_INIT (
+					"AddConnections",
+					.in_args = NM_DEFINE_GDBUS_ARG_INFOS (
+						NM_DEFINE_GDBUS_ARG_INFO ("connections", "aa{sa{sv}}"),
+					),
+					.out_args = NM_DEFINE_GDBUS_ARG_INFOS (
+						NM_DEFINE_GDBUS_ARG_INFO ("paths", "ao"),
+					),
+				),
+				.handle = impl_settings_add_connections,
+			),
 			NM_DEFINE_DBUS_METHOD_INFO_EXTENDED (
 				NM_DEFINE_GDBUS_METHOD_INFO_INIT (
 					"LoadConnections",
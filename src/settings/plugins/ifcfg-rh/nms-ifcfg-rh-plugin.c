@@ -67,6 +67,11 @@ typedef struct {
 
 	GFileMonitor *ifcfg_monitor;
 	gulong ifcfg_monitor_id;
+
+	/* file events that are not yet processed. Maps the ifcfg path to
+	 * the last GFileMonitorEvent for it. */
+	GHashTable *ifcfg_changed_events;
+	guint ifcfg_changed_id;
 } SettingsPluginIfcfgPrivate;
 
 struct _SettingsPluginIfcfg {
@@ -408,6 +413,63 @@ update_connection (SettingsPluginIfcfg *self,
 	}
 }
 
+/* Changes to the directory are collected for a short while, so that
+ * a burst of events (e.g. a tool writing many profiles at once, or the ifcfg,
+ * route and keys files of one profile) is processed together. Each profile
+ * is then read only once and the settings get all the updates in one main
+ * loop iteration. */
+#define IFCFG_CHANGED_DELAY_MSEC 200
+
+static void
+ifcfg_changed_process (SettingsPluginIfcfg *plugin,
+                       const char *ifcfg_path,
+                       GFileMonitorEvent event_type)
+{
+	NMIfcfgConnection *connection;
+
+	connection = find_by_path (plugin, ifcfg_path);
+	switch (event_type) {
+	case G_FILE_MONITOR_EVENT_DELETED:
+		if (connection)
+			remove_connection (plugin, connection);
+		break;
+	case G_FILE_MONITOR_EVENT_CREATED:
+	case G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT:
+		/* Update or new */
+		update_connection (plugin, NULL, ifcfg_path, connection, TRUE, NULL, NULL);
+		break;
+	default:
+		break;
+	}
+}
+
+static gboolean
+ifcfg_changed_timeout_cb (gpointer user_data)
+{
+	SettingsPluginIfcfg *plugin = user_data;
+	SettingsPluginIfcfgPrivate *priv = SETTINGS_PLUGIN_IFCFG_GET_PRIVATE (plugin);
+	gs_unref_hashtable GHashTable *events = NULL;
+	gs_free const char **paths = NULL;
+	guint i, len;
+
+	priv->ifcfg_changed_id = 0;
+	events = g_steal_pointer (&priv->ifcfg_changed_events);
+	if (!events)
+		return G_SOURCE_REMOVE;
+
+	paths = nm_utils_strdict_get_keys (events, TRUE, &len);
+
+	_LOGD ("ifcfg_dir_changed: process %u changed profiles", len);
+
+	for (i = 0; i < len; i++) {
+		ifcfg_changed_process (plugin,
+		                       paths[i],
+		                       GPOINTER_TO_INT (g_hash_table_lookup (events, paths[i])));
+	}
+
+	return G_SOURCE_REMOVE;
+}
+
 static void
 ifcfg_dir_changed (GFileMonitor *monitor,
                    GFile *file,
@@ -416,31 +478,30 @@ ifcfg_dir_changed (GFileMonitor *monitor,
                    gpointer user_data)
 {
 	SettingsPluginIfcfg *plugin = SETTINGS_PLUGIN_IFCFG (user_data);
-	char *path, *ifcfg_path;
-	NMIfcfgConnection *connection;
+	SettingsPluginIfcfgPrivate *priv = SETTINGS_PLUGIN_IFCFG_GET_PRIVATE (plugin);
+	gs_free char *path = NULL;
+	char *ifcfg_path;
+
+	if (!NM_IN_SET (event_type, G_FILE_MONITOR_EVENT_DELETED,
+	                            G_FILE_MONITOR_EVENT_CREATED,
+	                            G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT))
+		return;
 
 	path = g_file_get_path (file);
 
 	ifcfg_path = utils_detect_ifcfg_path (path, FALSE);
 	_LOGD ("ifcfg_dir_changed(%s) = %d // %s", path, event_type, ifcfg_path ?: "(none)");
-	if (ifcfg_path) {
-		connection = find_by_path (plugin, ifcfg_path);
-		switch (event_type) {
-		case G_FILE_MONITOR_EVENT_DELETED:
-			if (connection)
-				remove_connection (plugin, connection);
-			break;
-		case G_FILE_MONITOR_EVENT_CREATED:
-		case G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT:
-			/* Update or new */
-			update_connection (plugin, NULL, ifcfg_path, connection, TRUE, NULL, NULL);
-			break;
-		default:
-			break;
-		}
-		g_free (ifcfg_path);
-	}
-	g_free (path);
+	if (!ifcfg_path)
+		return;
+
+	if (!priv->ifcfg_changed_events)
+		priv->ifcfg_changed_events = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, NULL);
+
+	/* only the last event for a profile matters. */
+	g_hash_table_insert (priv->ifcfg_changed_events, ifcfg_path, GINT_TO_POINTER (event_type));
+
+	if (!priv->ifcfg_changed_id)
+		priv->ifcfg_changed_id = g_timeout_add (IFCFG_CHANGED_DELAY_MSEC, ifcfg_changed_timeout_cb, plugin);
 }
 
 static void
@@ -1054,6 +1115,9 @@ dispose (GObject *object)
 		g_object_unref (priv->ifcfg_monitor);
 	}
 
+	nm_clear_g_source (&priv->ifcfg_changed_id);
+	g_clear_pointer (&priv->ifcfg_changed_events, g_hash_table_destroy);
+
 	G_OBJECT_CLASS (settings_plugin_ifcfg_parent_class)->dispose (object);
 }
 
@@ -67,6 +67,10 @@ struct _shvarLine {
 	char *line;
 	const char *key;
 	char *key_with_prefix;
+
+	/* set if an earlier line in the file has the same @key. Only the
+	 * last line for a key is indexed, see shvarFile.lst_idx. */
+	bool shadows_key:1;
 };
 
 typedef struct _shvarLine shvarLine;
@@ -75,6 +79,11 @@ struct _shvarFile {
 	char      *fileName;
 	int        fd;
 	CList      lst_head;
+
+	/* index of the lines with a key. For each key, it contains the
+	 * last line in @lst_head, which is the one that counts. */
+	GHashTable *lst_idx;
+
 	gboolean   modified;
 };
 
@@ -625,6 +634,29 @@ out_error:
 
 /*****************************************************************************/
 
+static guint
+_line_idx_hash (gconstpointer ptr)
+{
+	return nm_str_hash (((const shvarLine *) ptr)->key);
+}
+
+static gboolean
+_line_idx_equal (gconstpointer a, gconstpointer b)
+{
+	return nm_streq (((const shvarLine *) a)->key,
+	                 ((const shvarLine *) b)->key);
+}
+
+static shvarLine *
+_line_idx_lookup (const shvarFile *s, const char *key)
+{
+	shvarLine needle = { .key = key };
+
+	return g_hash_table_lookup (s->lst_idx, &needle);
+}
+
+/*****************************************************************************/
+
 static shvarFile *
 svFile_new (const char *name)
 {
@@ -634,6 +666,7 @@ svFile_new (const char *name)
 	s->fd = -1;
 	s->fileName = g_strdup (name);
 	c_list_init (&s->lst_head);
+	s->lst_idx = g_hash_table_new (_line_idx_hash, _line_idx_equal);
 	return s;
 }
 
@@ -736,6 +769,7 @@ line_new_build (const char *key, const char *value)
 	line->line = value_escaped ?: g_strdup (value);
 	line->key_with_prefix = g_strdup (key);
 	line->key = line->key_with_prefix;
+	line->shadows_key = FALSE;
 	ASSERT_shvarLine (line);
 	return line;
 }
@@ -781,6 +815,18 @@ line_free (shvarLine *line)
 	g_slice_free (shvarLine, line);
 }
 
+static void
+_line_link_tail (shvarFile *s, shvarLine *line)
+{
+	c_list_link_tail (&s->lst_head, &line->lst);
+	if (line->key) {
+		if (g_hash_table_contains (s->lst_idx, line))
+			line->shadows_key = TRUE;
+		/* replaces the key too, so that the index points to the new line. */
+		g_hash_table_add (s->lst_idx, line);
+	}
+}
+
 /*****************************************************************************/
 
 /* Open the file <name>, returning a shvarFile on success and NULL on failure.
@@ -839,9 +885,9 @@ svOpenFileInternal (const char *name, gboolean create, GError **error)
 	s = svFile_new (name);
 
 	for (p = arena; (q = strchr (p, '\n')) != NULL; p = q + 1)
-		c_list_link_tail (&s->lst_head, &line_new_parse (p, q - p)->lst);
+		_line_link_tail (s, line_new_parse (p, q - p));
 	if (p[0])
-		c_list_link_tail (&s->lst_head, &line_new_parse (p, strlen (p))->lst);
+		_line_link_tail (s, line_new_parse (p, strlen (p)));
 	g_free (arena);
 
 	/* closefd is set if we opened the file read-only, so go ahead and
@@ -929,15 +975,15 @@ GHashTable *
 svGetKeys (shvarFile *s, SvKeyType match_key_type)
 {
 	GHashTable *keys = NULL;
-	CList *current;
+	GHashTableIter iter;
 	const shvarLine *line;
 
 	nm_assert (s);
 
-	c_list_for_each (current, &s->lst_head) {
-		line = c_list_entry (current, shvarLine, lst);
-		if (   line->key
-		    && line->line
+	g_hash_table_iter_init (&iter, s->lst_idx);
+	while (g_hash_table_iter_next (&iter, (gpointer *) &line, NULL)) {
+		nm_assert (line->key);
+		if (   line->line
 		    && _svKeyMatchesType (line->key, match_key_type)) {
 			/* we don't clone the keys. The keys are only valid
 			 * until @s gets modified. */
@@ -976,20 +1022,14 @@ svFindFirstKeyWithPrefix (shvarFile *s, const char *key_prefix)
 static const char *
 _svGetValue (shvarFile *s, const char *key, char **to_free)
 {
-	CList *current;
-	const shvarLine *line, *l;
+	const shvarLine *line;
 	const char *v;
 
 	nm_assert (s);
 	nm_assert (_shell_is_name (key, -1));
 	nm_assert (to_free);
 
-	line = NULL;
-	c_list_for_each (current, &s->lst_head) {
-		l = c_list_entry (current, shvarLine, lst);
-		if (l->key && nm_streq (l->key, key))
-			line = l;
-	}
+	line = _line_idx_lookup (s, key);
 
 	if (line && line->line) {
 		v = svUnescape (line->line, to_free);
@@ -1210,7 +1250,7 @@ svUnsetAll (shvarFile *s, SvKeyType match_key_type)
 gboolean
 svSetValue (shvarFile *s, const char *key, const char *value)
 {
-	CList *current;
+	CList *current, *safe;
 	shvarLine *line, *l;
 	gboolean changed = FALSE;
 
@@ -1219,18 +1259,20 @@ svSetValue (shvarFile *s, const char *key, const char *value)
 
 	nm_assert (_shell_is_name (key, -1));
 
-	line = NULL;
-	c_list_for_each (current, &s->lst_head) {
-		l = c_list_entry (current, shvarLine, lst);
-		if (l->key && nm_streq (l->key, key)) {
-			if (line) {
-				/* if we find multiple entries for the same key, we can
-				 * delete all but the last. */
-				line_free (line);
-				changed = TRUE;
-			}
-			line = l;
+	line = _line_idx_lookup (s, key);
+
+	if (line && line->shadows_key) {
+		/* if we find multiple entries for the same key, we can
+		 * delete all but the last. */
+		c_list_for_each_safe (current, safe, &s->lst_head) {
+			l = c_list_entry (current, shvarLine, lst);
+			if (l == line)
+				break;
+			if (l->key && nm_streq (l->key, key))
+				line_free (l);
 		}
+		line->shadows_key = FALSE;
+		changed = TRUE;
 	}
 
 	if (!value) {
@@ -1241,7 +1283,7 @@ svSetValue (shvarFile *s, const char *key, const char *value)
 		}
 	} else {
 		if (!line) {
-			c_list_link_tail (&s->lst_head, &line_new_build (key, value)->lst);
+			_line_link_tail (s, line_new_build (key, value));
 			changed = TRUE;
 		} else {
 			if (line_set (line, value))
@@ -1396,6 +1438,7 @@ svCloseFile (shvarFile *s)
 	if (s->fd >= 0)
 		nm_close (s->fd);
 	g_free (s->fileName);
+	g_hash_table_destroy (s->lst_idx);
 	c_list_for_each_safe (current, safe, &s->lst_head)
 		line_free (c_list_entry (current, shvarLine, lst));
 	g_slice_free (shvarFile, s);
@@ -52,6 +52,11 @@ typedef struct {
 	GFileMonitor *monitor;
 	gulong monitor_id;
 
+	/* file events that are not yet processed. Maps the full path to
+	 * the last GFileMonitorEvent for it. */
+	GHashTable *dir_changed_events;
+	guint dir_changed_id;
+
 	NMConfig *config;
 } NMSKeyfilePluginPrivate;
 
@@ -291,24 +296,20 @@ update_connection (NMSKeyfilePlugin *self,
 	}
 }
 
+/* Changes to the directory are collected for a short while, so that
+ * a burst of events (e.g. a tool writing many profiles at once) is processed
+ * together. Then each file is only read once and the settings get all the
+ * updates in one main loop iteration. */
+#define DIR_CHANGED_DELAY_MSEC 200
+
 static void
-dir_changed (GFileMonitor *monitor,
-             GFile *file,
-             GFile *other_file,
-             GFileMonitorEvent event_type,
-             gpointer user_data)
+dir_changed_process (NMSKeyfilePlugin *self,
+                     const char *full_path,
+                     GFileMonitorEvent event_type)
 {
-	NMSettingsPlugin *config = NM_SETTINGS_PLUGIN (user_data);
-	NMSKeyfilePlugin *self = NMS_KEYFILE_PLUGIN (config);
 	NMSKeyfileConnection *connection;
-	char *full_path;
 	gboolean exists;
 
-	full_path = g_file_get_path (file);
-	if (nms_keyfile_utils_should_ignore_file (full_path)) {
-		g_free (full_path);
-		return;
-	}
 	exists = g_file_test (full_path, G_FILE_TEST_EXISTS);
 
 	_LOGD ("dir_changed(%s) = %d; file %s", full_path, event_type, exists ? "exists" : "does not exist");
@@ -318,18 +319,75 @@ dir_changed (GFileMonitor *monitor,
 	switch (event_type) {
 	case G_FILE_MONITOR_EVENT_DELETED:
 		if (!exists && connection)
-			remove_connection (NMS_KEYFILE_PLUGIN (config), connection);
+			remove_connection (self, connection);
 		break;
 	case G_FILE_MONITOR_EVENT_CREATED:
 	case G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT:
 		if (exists)
-			update_connection (NMS_KEYFILE_PLUGIN (config), NULL, full_path, connection, TRUE, NULL, NULL);
+			update_connection (self, NULL, full_path, connection, TRUE, NULL, NULL);
 		break;
 	default:
 		break;
 	}
+}
+
+static gboolean
+dir_changed_timeout_cb (gpointer user_data)
+{
+	NMSKeyfilePlugin *self = user_data;
+	NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE (self);
+	gs_unref_hashtable GHashTable *events = NULL;
+	gs_free const char **paths = NULL;
+	guint i, len;
+
+	priv->dir_changed_id = 0;
+	events = g_steal_pointer (&priv->dir_changed_events);
+	if (!events)
+		return G_SOURCE_REMOVE;
+
+	paths = nm_utils_strdict_get_keys (events, TRUE, &len);
+
+	_LOGD ("dir_changed: process %u changed files", len);
+
+	for (i = 0; i < len; i++) {
+		dir_changed_process (self,
+		                     paths[i],
+		                     GPOINTER_TO_INT (g_hash_table_lookup (events, paths[i])));
+	}
+
+	return G_SOURCE_REMOVE;
+}
+
+static void
+dir_changed (GFileMonitor *monitor,
+             GFile *file,
+             GFile *other_file,
+             GFileMonitorEvent event_type,
+             gpointer user_data)
+{
+	NMSKeyfilePlugin *self = NMS_KEYFILE_PLUGIN (user_data);
+	NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE (self);
+	char *full_path;
+
+	if (!NM_IN_SET (event_type, G_FILE_MONITOR_EVENT_DELETED,
+	                            G_FILE_MONITOR_EVENT_CREATED,
+	                            G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT))
+		return;
+
+	full_path = g_file_get_path (file);
+	if (nms_keyfile_utils_should_ignore_file (full_path)) {
+		g_free (full_path);
+		return;
+	}
 
-	g_free (full_path);
+	if (!priv->dir_changed_events)
+		priv->dir_changed_events = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, NULL);
+
+	/* only the last event for a file matters. */
+	g_hash_table_insert (priv->dir_changed_events, full_path, GINT_TO_POINTER (event_type));
+
+	if (!priv->dir_changed_id)
+		priv->dir_changed_id = g_timeout_add (DIR_CHANGED_DELAY_MSEC, dir_changed_timeout_cb, self);
 }
 
 static void
@@ -601,6 +659,9 @@ dispose (GObject *object)
 		g_clear_object (&priv->monitor);
 	}
 
+	nm_clear_g_source (&priv->dir_changed_id);
+	g_clear_pointer (&priv->dir_changed_events, g_hash_table_destroy);
+
 	if (priv->connections) {
 		g_hash_table_destroy (priv->connections);
 		priv->connections = NULL;
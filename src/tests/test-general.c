@@ -1845,6 +1845,41 @@ test_nm_utils_exp10 (void)
 
 /*****************************************************************************/
 
+static void
+test_logging_trace_ring (void)
+{
+	gs_strfreev char **entries = NULL;
+	guint i, n;
+
+	/* the ring is disabled by default. */
+	nm_log_trace (LOGD_PLATFORM, "trace-ring-test disabled");
+	entries = nm_logging_trace_ring_dump ();
+	g_assert_cmpint (NM_PTRARRAY_LEN (entries), ==, 0);
+	nm_clear_pointer (&entries, g_strfreev);
+
+	nm_logging_trace_ring_set_enabled (TRUE);
+
+	/* log enough messages so that the ring wraps around. */
+	for (i = 0; i < 20000; i++)
+		nm_log_trace (LOGD_PLATFORM, "trace-ring-test %u", i);
+	nm_log_trace (LOGD_DHCP4, "trace-ring-test last");
+	nm_log_trace (LOGD_CORE, "trace-ring-test not-recorded");
+	nm_log_dbg (LOGD_PLATFORM, "trace-ring-test not-recorded");
+
+	entries = nm_logging_trace_ring_dump ();
+	nm_logging_trace_ring_set_enabled (FALSE);
+	n = NM_PTRARRAY_LEN (entries);
+	g_assert_cmpint (n, >, 2);
+	g_assert_cmpint (n, <, 20000);
+
+	g_assert (g_str_has_suffix (entries[n - 1], "[DHCP4] trace-ring-test last"));
+	g_assert (g_str_has_suffix (entries[n - 2], "[PLATFORM] trace-ring-test 19999"));
+	g_assert (strstr (entries[0], "[PLATFORM] trace-ring-test "));
+	g_assert (!g_str_has_suffix (entries[0], "trace-ring-test 0"));
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE ();
 
 int
@@ -1862,6 +1897,8 @@ main (int argc, char **argv)
 
 	g_test_add_func ("/general/exp10", test_nm_utils_exp10);
 
+	g_test_add_func ("/general/logging/trace-ring", test_logging_trace_ring);
+
 	g_test_add_func ("/general/connection-match/basic", test_connection_match_basic);
 	g_test_add_func ("/general/connection-match/ip6-method", test_connection_match_ip6_method);
 	g_test_add_func ("/general/connection-match/ip6-method-ignore", test_connection_match_ip6_method_ignore);
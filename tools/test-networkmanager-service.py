@@ -1715,6 +1715,21 @@ class Settings(ExportedObj):
     def AddConnection(self, con_hash):
         return self.add_connection(con_hash)
 
+    @dbus.service.method(dbus_interface=IFACE_SETTINGS, in_signature='aa{sa{sv}}', out_signature='ao')
+    def AddConnections(self, con_hashes):
+        # all or nothing: create and check every connection before exporting any.
+        uuids = set([c.get_uuid() for c in self.get_connections(stable_order = False)])
+        con_insts = []
+        for con_hash in con_hashes:
+            self.c_counter += 1
+            con_inst = Connection(self.c_counter, con_hash, True)
+            uuid = con_inst.get_uuid()
+            if uuid in uuids:
+                raise BusErr.InvalidSettingException('cannot add duplicate connection with uuid %s' % (uuid))
+            uuids.add(uuid)
+            con_insts.append(con_inst)
+        return dbus.Array([self._add_connection_inst(con_inst) for con_inst in con_insts], 'o')
+
     def add_connection(self, con_hash, do_verify_strict=True):
         self.c_counter += 1
         con_inst = Connection(self.c_counter, con_hash, do_verify_strict)
@@ -1723,6 +1738,9 @@ class Settings(ExportedObj):
         if uuid in [c.get_uuid() for c in self.get_connections(stable_order = False)]:
             raise BusErr.InvalidSettingException('cannot add duplicate connection with uuid %s' % (uuid))
 
+        return self._add_connection_inst(con_inst)
+
+    def _add_connection_inst(self, con_inst):
         con_inst.export()
         self.connections[con_inst.path] = con_inst
         self.NewConnection(con_inst.path)